@@ -208,7 +208,8 @@ AC_DEFUN([QL_CHECK_BOOST_TEST_THREAD_SIGNALS2_SYSTEM],
      AC_MSG_RESULT([no])
      AC_SUBST([BOOST_THREAD_LIB],[""])
      AC_MSG_ERROR([Boost thread, signals2 and system libraries not found. 
-         These libraries are required by the thread-safe observer pattern.])
+         These libraries are required by the thread-safe observer pattern
+         and by sessions.])
  else
      AC_MSG_RESULT([yes])
      AC_SUBST([BOOST_THREAD_LIB],[$boost_thread_lib])
@@ -579,42 +579,89 @@ namespace QuantLib {
                 return -1;
         }
 
-        Real simpleDuration(const Leg& leg,
-                            const InterestRate& y,
-                            bool includeSettlementDateFlows,
-                            Date settlementDate,
-                            Date npvDate) {
-            if (leg.empty())
-                return 0.0;
+        struct YieldSums {
+            // NPV discounting period by period
+            Real npv;
+            // NPV discounting at the accumulated times, and its
+            // derivatives with respect to the yield
+            Real P, tPB, dPdy, d2Pdy2;
+            Real bps;
+        };
 
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
+        /* The cash flows still to be paid, stored once in contiguous
+           arrays together with the year fractions they are discounted
+           upon, so that the yield functions and the IRR solver don't
+           need to walk the leg (and to call the day counter and the
+           virtual inspectors) at each evaluation.
+        */
+        class FlatLeg {
+          public:
+            FlatLeg(const Leg& leg,
+                    const DayCounter& dayCounter,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate,
+                    Date npvDate);
+            Size size() const { return amounts_.size(); }
+            const std::vector<Real>& amounts() const { return amounts_; }
+            /* single pass over the flows; sensitivities and bps are
+               calculated on request */
+            void calculate(const InterestRate& y,
+                           bool sensitivities,
+                           bool bps,
+                           YieldSums& sums) const;
+          private:
+            DayCounter dayCounter_;
+            Date settlementDate_, npvDate_;
+            std::vector<Date> dates_;
+            // amounts are null for flows trading ex-coupon
+            std::vector<Real> amounts_;
+            // year fractions between consecutive flows and their sums
+            std::vector<Time> periods_, times_;
+            // nominal times accrual period for coupons not trading
+            // ex-coupon, null otherwise
+            std::vector<Real> bpsWeights_;
+        };
 
-            if (npvDate == Date())
-                npvDate = settlementDate;
+        FlatLeg::FlatLeg(const Leg& leg,
+                         const DayCounter& dc,
+                         bool includeSettlementDateFlows,
+                         Date settlementDate,
+                         Date npvDate)
+        : dayCounter_(dc), settlementDate_(settlementDate),
+          npvDate_(npvDate) {
+            dates_.reserve(leg.size());
+            amounts_.reserve(leg.size());
+            periods_.reserve(leg.size());
+            times_.reserve(leg.size());
+            bpsWeights_.reserve(leg.size());
 
-            Real P = 0.0;
-            Real dPdy = 0.0;
             Time t = 0.0;
             Date lastDate = npvDate;
             Date refStartDate, refEndDate;
-            const DayCounter& dc = y.dayCounter();
             for (Size i=0; i<leg.size(); ++i) {
                 if (leg[i]->hasOccurred(settlementDate,
                                         includeSettlementDateFlows))
                     continue;
 
                 Real c = leg[i]->amount();
-                if (leg[i]->tradingExCoupon(settlementDate)) {
+                bool exCoupon = leg[i]->tradingExCoupon(settlementDate);
+                if (exCoupon) {
                     c = 0.0;
                 }
 
                 Date couponDate = leg[i]->date();
+                QL_REQUIRE(couponDate >= lastDate,
+                           "d1 (" << lastDate << ") "
+                           "later than d2 (" << couponDate << ")");
+                Real bpsWeight = 0.0;
                 shared_ptr<Coupon> coupon =
                     boost::dynamic_pointer_cast<Coupon>(leg[i]);
                 if (coupon) {
                     refStartDate = coupon->referencePeriodStart();
                     refEndDate = coupon->referencePeriodEnd();
+                    if (!exCoupon)
+                        bpsWeight = coupon->nominal() *
+                                    coupon->accrualPeriod();
                 } else {
                     if (lastDate == npvDate) {
                         // we don't have a previous coupon date,
@@ -626,156 +673,143 @@ namespace QuantLib {
                     refEndDate = couponDate;
                 }
 
-                t += dc.yearFraction(lastDate, couponDate,
-                                     refStartDate, refEndDate);
+                Time dt = dc.yearFraction(lastDate, couponDate,
+                                          refStartDate, refEndDate);
+                t += dt;
+
+                dates_.push_back(couponDate);
+                amounts_.push_back(c);
+                periods_.push_back(dt);
+                times_.push_back(t);
+                bpsWeights_.push_back(bpsWeight);
 
-                DiscountFactor B = y.discountFactor(t);
-                P += c * B;
-                dPdy += t * c * B;
-                
                 lastDate = couponDate;
             }
-            if (P == 0.0) // no cashflows
-                return 0.0;
-            return dPdy/P;
         }
 
-        Real modifiedDuration(const Leg& leg,
-                              const InterestRate& y,
-                              bool includeSettlementDateFlows,
-                              Date settlementDate,
-                              Date npvDate) {
-            if (leg.empty())
-                return 0.0;
-
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
+        void FlatLeg::calculate(const InterestRate& y,
+                                bool sensitivities,
+                                bool bps,
+                                YieldSums& s) const {
+            s.npv = s.P = s.tPB = s.dPdy = s.d2Pdy2 = s.bps = 0.0;
 
-            if (npvDate == Date())
-                npvDate = settlementDate;
-
-            Real P = 0.0;
-            Time t = 0.0;
-            Real dPdy = 0.0;
             Rate r = y.rate();
             Natural N = y.frequency();
-            Date lastDate = npvDate;
-            Date refStartDate, refEndDate;
-            const DayCounter& dc = y.dayCounter();
-            for (Size i=0; i<leg.size(); ++i) {
-                if (leg[i]->hasOccurred(settlementDate,
-                                        includeSettlementDateFlows))
+            Compounding compounding = y.compounding();
+            DiscountFactor discount = 1.0;
+            for (Size i=0; i<amounts_.size(); ++i) {
+                Real c = amounts_[i];
+                discount *= y.discountFactor(periods_[i]);
+                s.npv += c * discount;
+
+                // as if discounting on a flat curve at the given
+                // yield with the settlement date as reference
+                if (bps && bpsWeights_[i] != 0.0)
+                    s.bps += bpsWeights_[i] * y.discountFactor(
+                        dayCounter_.yearFraction(settlementDate_, dates_[i]));
+
+                if (!sensitivities)
                     continue;
 
-                Real c = leg[i]->amount();
-                if (leg[i]->tradingExCoupon(settlementDate)) {
-                    c = 0.0;
-                }
-
-                Date couponDate = leg[i]->date();
-                shared_ptr<Coupon> coupon =
-                    boost::dynamic_pointer_cast<Coupon>(leg[i]);
-                if (coupon) {
-                    refStartDate = coupon->referencePeriodStart();
-                    refEndDate = coupon->referencePeriodEnd();
-                } else {
-                    if (lastDate == npvDate) {
-                        // we don't have a previous coupon date,
-                        // so we fake it
-                        refStartDate = couponDate - 1*Years;
-                    } else  {
-                        refStartDate = lastDate;
-                    }
-                    refEndDate = couponDate;
-                }
-                
-                t += dc.yearFraction(lastDate, couponDate,
-                                     refStartDate, refEndDate);
-                
+                Time t = times_[i];
                 DiscountFactor B = y.discountFactor(t);
-                P += c * B;
-                switch (y.compounding()) {
+                s.P += c * B;
+                s.tPB += t * c * B;
+                switch (compounding) {
                   case Simple:
-                    dPdy -= c * B*B * t;
+                    s.dPdy -= c * B*B * t;
+                    s.d2Pdy2 += c * 2.0*B*B*B*t*t;
                     break;
                   case Compounded:
-                    dPdy -= c * t * B/(1+r/N);
+                    s.dPdy -= c * t * B/(1+r/N);
+                    s.d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
                     break;
                   case Continuous:
-                    dPdy -= c * B * t;
+                    s.dPdy -= c * B * t;
+                    s.d2Pdy2 += c * B*t*t;
                     break;
                   case SimpleThenCompounded:
-                    if (t<=1.0/N)
-                        dPdy -= c * B*B * t;
-                    else
-                        dPdy -= c * t * B/(1+r/N);
+                    if (t<=1.0/N) {
+                        s.dPdy -= c * B*B * t;
+                        s.d2Pdy2 += c * 2.0*B*B*B*t*t;
+                    } else {
+                        s.dPdy -= c * t * B/(1+r/N);
+                        s.d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                    }
                     break;
                   default:
                     QL_FAIL("unknown compounding convention (" <<
-                            Integer(y.compounding()) << ")");
+                            Integer(compounding) << ")");
                 }
-                lastDate = couponDate;
             }
 
-            if (P == 0.0) // no cashflows
-                return 0.0;
-            return -dPdy/P; // reverse derivative sign
+            if (bps)
+                s.bps = basisPoint_ * s.bps / y.discountFactor(
+                            dayCounter_.yearFraction(settlementDate_, npvDate_));
         }
 
-        Real macaulayDuration(const Leg& leg,
-                              const InterestRate& y,
-                              bool includeSettlementDateFlows,
-                              Date settlementDate,
-                              Date npvDate) {
-
-            QL_REQUIRE(y.compounding() == Compounded,
-                       "compounded rate required");
+        Time yieldDuration(const YieldSums& s,
+                           const InterestRate& y,
+                           Duration::Type type) {
+            switch (type) {
+              case Duration::Simple:
+                if (s.P == 0.0) // no cashflows
+                    return 0.0;
+                return s.tPB/s.P;
+              case Duration::Modified:
+                if (s.P == 0.0) // no cashflows
+                    return 0.0;
+                return -s.dPdy/s.P; // reverse derivative sign
+              case Duration::Macaulay:
+                QL_REQUIRE(y.compounding() == Compounded,
+                           "compounded rate required");
+                if (s.P == 0.0) // no cashflows
+                    return 0.0;
+                return (1.0+y.rate()/y.frequency()) * (-s.dPdy/s.P);
+              default:
+                QL_FAIL("unknown duration type");
+            }
+        }
 
-            return (1.0+y.rate()/y.frequency()) *
-                modifiedDuration(leg, y,
-                                 includeSettlementDateFlows,
-                                 settlementDate, npvDate);
+        Real yieldConvexity(const YieldSums& s) {
+            if (s.P == 0.0) // no cashflows
+                return 0.0;
+            return s.d2Pdy2/s.P;
         }
 
         class IrrFinder : public std::unary_function<Rate, Real> {
           public:
-            IrrFinder(const Leg& leg,
+            IrrFinder(const FlatLeg& leg,
                       Real npv,
                       const DayCounter& dayCounter,
                       Compounding comp,
-                      Frequency freq,
-                      bool includeSettlementDateFlows,
-                      Date settlementDate,
-                      Date npvDate)
+                      Frequency freq)
             : leg_(leg), npv_(npv),
               dayCounter_(dayCounter), compounding_(comp), frequency_(freq),
-              includeSettlementDateFlows_(includeSettlementDateFlows),
-              settlementDate_(settlementDate),
-              npvDate_(npvDate) {
-
-
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
-
-                if (npvDate == Date())
-                    npvDate = settlementDate;
-
+              lastRate_(Null<Rate>()) {
                 checkSign();
             }
             Real operator()(Rate y) const {
-                InterestRate yield(y, dayCounter_, compounding_, frequency_);
-                Real NPV = CashFlows::npv(leg_, yield,
-                                          includeSettlementDateFlows_,
-                                          settlementDate_, npvDate_);
-                return npv_ - NPV;
+                return npv_ - sums(y).npv;
             }
             Real derivative(Rate y) const {
-                InterestRate yield(y, dayCounter_, compounding_, frequency_);
-                return modifiedDuration(leg_, yield,
-                                        includeSettlementDateFlows_,
-                                        settlementDate_, npvDate_);
+                const YieldSums& s = sums(y);
+                if (s.P == 0.0) // no cashflows
+                    return 0.0;
+                return -s.dPdy/s.P;
             }
           private:
+            // the solver asks for the value and the derivative at the
+            // same rate, so the last pass is reused
+            const YieldSums& sums(Rate y) const {
+                if (y != lastRate_) {
+                    InterestRate yield(y, dayCounter_,
+                                       compounding_, frequency_);
+                    leg_.calculate(yield, true, false, sums_);
+                    lastRate_ = y;
+                }
+                return sums_;
+            }
             void checkSign() const {
                 // depending on the sign of the market price, check that cash
                 // flows of the opposite sign have been specified (otherwise
@@ -783,17 +817,15 @@ namespace QuantLib {
 
                 Integer lastSign = sign(-npv_),
                         signChanges = 0;
-                for (Size i = 0; i < leg_.size(); ++i) {
-                    if (!leg_[i]->hasOccurred(settlementDate_,
-                                              includeSettlementDateFlows_) &&
-                        !leg_[i]->tradingExCoupon(settlementDate_)) {
-                        Integer thisSign = sign(leg_[i]->amount());
-                        if (lastSign * thisSign < 0) // sign change
-                            signChanges++;
-
-                        if (thisSign != 0)
-                            lastSign = thisSign;
-                    }
+                const std::vector<Real>& amounts = leg_.amounts();
+                for (Size i = 0; i < amounts.size(); ++i) {
+                    // flows trading ex-coupon have a null amount
+                    Integer thisSign = sign(amounts[i]);
+                    if (lastSign * thisSign < 0) // sign change
+                        signChanges++;
+
+                    if (thisSign != 0)
+                        lastSign = thisSign;
                 }
                 QL_REQUIRE(signChanges > 0,
                            "the given cash flows cannot result in the given market "
@@ -818,17 +850,15 @@ namespace QuantLib {
                 };
                 */
             }
-            const Leg& leg_;
+            const FlatLeg& leg_;
             Real npv_;
             DayCounter dayCounter_;
             Compounding compounding_;
             Frequency frequency_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
+            mutable Rate lastRate_;
+            mutable YieldSums sums_;
         };
 
-
-
     } // anonymous namespace ends here
 
     Real CashFlows::npv(const Leg& leg,
@@ -846,46 +876,11 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real npv = 0.0;
-        DiscountFactor discount = 1.0;
-        Date lastDate = npvDate;
-        Date refStartDate, refEndDate;
-
-        for (Size i=0; i<leg.size(); ++i) {
-            if (leg[i]->hasOccurred(settlementDate,
-                                    includeSettlementDateFlows))
-                continue;
-
-            Date couponDate = leg[i]->date();
-            Real amount = leg[i]->amount();
-            if (leg[i]->tradingExCoupon(settlementDate)) {
-                amount = 0.0;
-            }
-
-            shared_ptr<Coupon> coupon =
-                boost::dynamic_pointer_cast<Coupon>(leg[i]);
-            if (coupon) {
-                refStartDate = coupon->referencePeriodStart();
-                refEndDate = coupon->referencePeriodEnd();
-            } else {
-                if (lastDate == npvDate) {
-                    // we don't have a previous coupon date,
-                    // so we fake it
-                    refStartDate = couponDate - 1*Years;
-                } else  {
-                    refStartDate = lastDate;
-                }
-                refEndDate = couponDate;
-            }
-            DiscountFactor b = y.discountFactor(lastDate, couponDate,
-                                                refStartDate, refEndDate);
-            discount *= b;
-            lastDate = couponDate;
-
-            npv += amount * discount;
-        }
-
-        return npv;
+        FlatLeg flatLeg(leg, y.dayCounter(), includeSettlementDateFlows,
+                        settlementDate, npvDate);
+        YieldSums s;
+        flatLeg.calculate(y, false, false, s);
+        return s.npv;
     }
 
     Real CashFlows::npv(const Leg& leg,
@@ -916,11 +911,11 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        FlatForward flatRate(settlementDate, yield.rate(), yield.dayCounter(),
-                             yield.compounding(), yield.frequency());
-        return bps(leg, flatRate,
-                   includeSettlementDateFlows,
-                   settlementDate, npvDate);
+        FlatLeg flatLeg(leg, yield.dayCounter(), includeSettlementDateFlows,
+                        settlementDate, npvDate);
+        YieldSums s;
+        flatLeg.calculate(yield, false, true, s);
+        return s.bps;
     }
 
     Real CashFlows::bps(const Leg& leg,
@@ -947,13 +942,20 @@ namespace QuantLib {
                           Real accuracy,
                           Size maxIterations,
                           Rate guess) {
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
         //Brent solver;
         NewtonSafe solver;
         solver.setMaxEvaluations(maxIterations);
-        IrrFinder objFunction(leg, npv,
-                              dayCounter, compounding, frequency,
-                              includeSettlementDateFlows,
-                              settlementDate, npvDate);
+        FlatLeg flatLeg(leg, dayCounter, includeSettlementDateFlows,
+                        settlementDate, npvDate);
+        IrrFinder objFunction(flatLeg, npv,
+                              dayCounter, compounding, frequency);
         return solver.solve(objFunction, accuracy, guess, guess/10.0);
     }
 
@@ -974,22 +976,11 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        switch (type) {
-          case Duration::Simple:
-            return simpleDuration(leg, rate,
-                                  includeSettlementDateFlows,
-                                  settlementDate, npvDate);
-          case Duration::Modified:
-            return modifiedDuration(leg, rate,
-                                    includeSettlementDateFlows,
-                                    settlementDate, npvDate);
-          case Duration::Macaulay:
-            return macaulayDuration(leg, rate,
-                                    includeSettlementDateFlows,
-                                    settlementDate, npvDate);
-          default:
-            QL_FAIL("unknown duration type");
-        }
+        FlatLeg flatLeg(leg, rate.dayCounter(), includeSettlementDateFlows,
+                        settlementDate, npvDate);
+        YieldSums s;
+        flatLeg.calculate(rate, true, false, s);
+        return yieldDuration(s, rate, type);
     }
 
     Time CashFlows::duration(const Leg& leg,
@@ -1021,75 +1012,11 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        const DayCounter& dc = y.dayCounter();
-
-        Real P = 0.0;
-        Time t = 0.0;
-        Real d2Pdy2 = 0.0;
-        Rate r = y.rate();
-        Natural N = y.frequency();
-        Date lastDate = npvDate;
-        Date refStartDate, refEndDate;
-        for (Size i=0; i<leg.size(); ++i) {
-            if (leg[i]->hasOccurred(settlementDate,
-                                        includeSettlementDateFlows))
-                continue;
-            
-            Real c = leg[i]->amount();
-            if (leg[i]->tradingExCoupon(settlementDate)) {
-                c = 0.0;
-            }
-
-            Date couponDate = leg[i]->date();
-            shared_ptr<Coupon> coupon =
-                boost::dynamic_pointer_cast<Coupon>(leg[i]);
-            if (coupon) {
-                refStartDate = coupon->referencePeriodStart();
-                refEndDate = coupon->referencePeriodEnd();
-            } else {
-                if (lastDate == npvDate) {
-                    // we don't have a previous coupon date,
-                    // so we fake it
-                    refStartDate = couponDate - 1*Years;
-                } else  {
-                    refStartDate = lastDate;
-                }
-                refEndDate = couponDate;
-            }
-            
-            t += dc.yearFraction(lastDate, couponDate,
-                                 refStartDate, refEndDate);
-            
-            DiscountFactor B = y.discountFactor(t);
-            P += c * B;
-            switch (y.compounding()) {
-              case Simple:
-                d2Pdy2 += c * 2.0*B*B*B*t*t;
-                break;
-              case Compounded:
-                d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
-                break;
-              case Continuous:
-                d2Pdy2 += c * B*t*t;
-                break;
-              case SimpleThenCompounded:
-                if (t<=1.0/N)
-                    d2Pdy2 += c * 2.0*B*B*B*t*t;
-                else
-                    d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
-                break;
-              default:
-                QL_FAIL("unknown compounding convention (" <<
-                        Integer(y.compounding()) << ")");
-            }
-            lastDate = couponDate;
-        }
-
-        if (P == 0.0)
-            // no cashflows
-            return 0.0;
-
-        return d2Pdy2/P;
+        FlatLeg flatLeg(leg, y.dayCounter(), includeSettlementDateFlows,
+                        settlementDate, npvDate);
+        YieldSums s;
+        flatLeg.calculate(y, true, false, s);
+        return yieldConvexity(s);
     }
 
 
@@ -1106,6 +1033,55 @@ namespace QuantLib {
                          settlementDate, npvDate);
     }
 
+    void CashFlows::npvbpsDurationConvexity(const Leg& leg,
+                                            const InterestRate& y,
+                                            Duration::Type type,
+                                            bool includeSettlementDateFlows,
+                                            Date settlementDate,
+                                            Date npvDate,
+                                            Real& npv,
+                                            Real& bps,
+                                            Time& duration,
+                                            Real& convexity) {
+        npv = bps = duration = convexity = 0.0;
+        if (leg.empty())
+            return;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        FlatLeg flatLeg(leg, y.dayCounter(), includeSettlementDateFlows,
+                        settlementDate, npvDate);
+        YieldSums s;
+        flatLeg.calculate(y, true, true, s);
+        npv = s.npv;
+        bps = s.bps;
+        duration = yieldDuration(s, y, type);
+        convexity = yieldConvexity(s);
+    }
+
+    void CashFlows::npvbpsDurationConvexity(const Leg& leg,
+                                            Rate yield,
+                                            const DayCounter& dc,
+                                            Compounding comp,
+                                            Frequency freq,
+                                            Duration::Type type,
+                                            bool includeSettlementDateFlows,
+                                            Date settlementDate,
+                                            Date npvDate,
+                                            Real& npv,
+                                            Real& bps,
+                                            Time& duration,
+                                            Real& convexity) {
+        npvbpsDurationConvexity(leg, InterestRate(yield, dc, comp, freq),
+                                type, includeSettlementDateFlows,
+                                settlementDate, npvDate,
+                                npv, bps, duration, convexity);
+    }
+
     Real CashFlows::basisPointValue(const Leg& leg,
                                     const InterestRate& y,
                                     bool includeSettlementDateFlows,
@@ -1120,16 +1096,13 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real npv = CashFlows::npv(leg, y,
-                                  includeSettlementDateFlows,
-                                  settlementDate, npvDate);
-        Real modifiedDuration = CashFlows::duration(leg, y,
-                                                    Duration::Modified,
-                                                    includeSettlementDateFlows,
-                                                    settlementDate, npvDate);
-        Real convexity = CashFlows::convexity(leg, y,
-                                              includeSettlementDateFlows,
-                                              settlementDate, npvDate);
+        FlatLeg flatLeg(leg, y.dayCounter(), includeSettlementDateFlows,
+                        settlementDate, npvDate);
+        YieldSums s;
+        flatLeg.calculate(y, true, false, s);
+        Real npv = s.npv;
+        Real modifiedDuration = yieldDuration(s, y, Duration::Modified);
+        Real convexity = yieldConvexity(s);
         Real delta = -modifiedDuration*npv;
         Real gamma = (convexity/100.0)*npv;
 
@@ -1167,13 +1140,12 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real npv = CashFlows::npv(leg, y,
-                                  includeSettlementDateFlows,
-                                  settlementDate, npvDate);
-        Real modifiedDuration = CashFlows::duration(leg, y,
-                                                    Duration::Modified,
-                                                    includeSettlementDateFlows,
-                                                    settlementDate, npvDate);
+        FlatLeg flatLeg(leg, y.dayCounter(), includeSettlementDateFlows,
+                        settlementDate, npvDate);
+        YieldSums s;
+        flatLeg.calculate(y, true, false, s);
+        Real npv = s.npv;
+        Real modifiedDuration = yieldDuration(s, y, Duration::Modified);
 
         Real shift = 0.01;
         return (1.0/(-npv*modifiedDuration))*shift;
@@ -345,6 +345,36 @@ namespace QuantLib {
                                          bool includeSettlementDateFlows,
                                          Date settlementDate = Date(),
                                          Date npvDate = Date());
+
+        //! NPV, BPS, duration and convexity of the cash flows.
+        /*! The results are the same returned by the npv(), bps(),
+            duration() and convexity() functions above, but the cash
+            flows are inspected only once and the four figures are
+            calculated in a single pass.
+        */
+        static void npvbpsDurationConvexity(const Leg& leg,
+                                            const InterestRate& yield,
+                                            Duration::Type type,
+                                            bool includeSettlementDateFlows,
+                                            Date settlementDate,
+                                            Date npvDate,
+                                            Real& npv,
+                                            Real& bps,
+                                            Time& duration,
+                                            Real& convexity);
+        static void npvbpsDurationConvexity(const Leg& leg,
+                                            Rate yield,
+                                            const DayCounter& dayCounter,
+                                            Compounding compounding,
+                                            Frequency frequency,
+                                            Duration::Type type,
+                                            bool includeSettlementDateFlows,
+                                            Date settlementDate,
+                                            Date npvDate,
+                                            Real& npv,
+                                            Real& bps,
+                                            Time& duration,
+                                            Real& convexity);
         //@}
 
         //! \name Z-spread functions
@@ -320,6 +320,63 @@ namespace QuantLib {
             return result;
     }
 
+    bool NumericHaganPricer::CouponKey::operator==(
+                                                 const CouponKey& k) const {
+        return fixingDate == k.fixingDate && paymentDate == k.paymentDate &&
+               tenorUnits == k.tenorUnits && tenorLength == k.tenorLength &&
+               swapRate == k.swapRate && annuity == k.annuity;
+    }
+
+    bool NumericHaganPricer::IntegralKey::operator<(
+                                               const IntegralKey& k) const {
+        if (optionType != k.optionType)
+            return optionType < k.optionType;
+        if (strike != k.strike)
+            return strike < k.strike;
+        if (lower != k.lower)
+            return lower < k.lower;
+        return upper < k.upper;
+    }
+
+    Real NumericHaganPricer::cachedIntegral(
+                                Real a, Real b,
+                                const ConundrumIntegrand& integrand,
+                                Option::Type optionType,
+                                Rate strike) const {
+        // the forward and the annuity stand for the state of the
+        // curves; the volatility is accounted for by clearing the
+        // cache upon notification
+        CouponKey coupon = { fixingDate_, paymentDate_,
+                             swapTenor_.length(), swapTenor_.units(),
+                             swapRateValue_, annuity_ };
+        std::list<CouponIntegrals>::iterator c = integrals_.begin();
+        while (c != integrals_.end() && !(c->coupon == coupon))
+            ++c;
+        if (c == integrals_.end()) {
+            // coupons left behind by curve changes are eventually
+            // dropped as the least recently used
+            if (integrals_.size() >= maxCachedCoupons_)
+                integrals_.pop_back();
+            integrals_.push_front(CouponIntegrals());
+            integrals_.front().coupon = coupon;
+        } else if (c != integrals_.begin()) {
+            integrals_.splice(integrals_.begin(), integrals_, c);
+        }
+        std::map<IntegralKey, Real>& integrals = integrals_.front().integrals;
+        IntegralKey key = { optionType, strike, a, b };
+        std::map<IntegralKey, Real>::const_iterator i = integrals.find(key);
+        if (i != integrals.end())
+            return i->second;
+        Real result = integrate(a, b, integrand);
+        integrals[key] = result;
+        return result;
+    }
+
+    void NumericHaganPricer::update() {
+        integrals_.clear();
+        HaganPricer::update();
+    }
+
     Real NumericHaganPricer::optionletPrice(
                                 Option::Type optionType, Real strike) const {
 
@@ -335,12 +392,14 @@ namespace QuantLib {
         //        stdDeviationsForUpperLimit_ += 1.;
         //        upperLimit_ = resetUpperLimit(stdDeviationsForUpperLimit_);
         //    }
-            integralValue = integrate(strike, upperLimit_, *integrand);
+            integralValue = cachedIntegral(strike, upperLimit_, *integrand,
+                                           optionType, strike);
             //refineIntegration(integralValue, *integrand);
         } else {
             a = std::min(strike, lowerLimit_);
             b = strike;
-            integralValue = integrate(a, b, *integrand);
+            integralValue = cachedIntegral(a, b, *integrand,
+                                           optionType, strike);
         }
 
         Real dFdK = integrand->firstDerivativeOfF(strike);
@@ -25,6 +25,8 @@
 
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <list>
+#include <map>
 
 namespace QuantLib {
 
@@ -245,6 +247,17 @@ namespace QuantLib {
     /*! Prices a cms coupon via static replication as in Hagan's
         "Conundrums..." article via numerical integration based on
         prices of vanilla swaptions
+
+        The replication integrals are cached for each coupon, i.e.,
+        fixing and payment date, swap tenor, forward swap rate and
+        annuity, by strike, option type and bounds, so that repeated
+        pricings of its optionlets (e.g. the swaplet, caplet and
+        floorlet of a capped/floored coupon, or coupons of several
+        legs or instruments priced in turn) don't integrate again.
+        The integrals of the most recently used coupons are kept, so
+        that the cache doesn't grow with each coupon and curve change;
+        it is cleared when the pricer is notified of a change, e.g. in
+        the volatility or in the mean reversion.
     */
     class NumericHaganPricer : public HaganPricer {
       public:
@@ -260,6 +273,8 @@ namespace QuantLib {
        Real upperLimit() { return upperLimit_; }
        Real stdDeviations() { return stdDeviationsForUpperLimit_; }
 
+       void update();
+
       //private:
         class Function : public std::unary_function<Real, Real> {
           public:
@@ -302,6 +317,11 @@ namespace QuantLib {
         Real integrate(Real a,
                        Real b,
                        const ConundrumIntegrand& Integrand) const;
+        Real cachedIntegral(Real a,
+                            Real b,
+                            const ConundrumIntegrand& integrand,
+                            Option::Type optionType,
+                            Rate strike) const;
         virtual Real optionletPrice(Option::Type optionType,
                                     Rate strike) const;
         virtual Real swapletPrice() const;
@@ -311,6 +331,28 @@ namespace QuantLib {
         mutable Real upperLimit_, stdDeviationsForUpperLimit_;
         const Real lowerLimit_, requiredStdDeviations_, precision_, refiningIntegrationTolerance_;
         const Real hardUpperLimit_;
+
+        struct CouponKey {
+            Date fixingDate, paymentDate;
+            Integer tenorLength;
+            TimeUnit tenorUnits;
+            Rate swapRate;
+            Real annuity;
+            bool operator==(const CouponKey& k) const;
+        };
+        struct IntegralKey {
+            Option::Type optionType;
+            Rate strike;
+            Real lower, upper;
+            bool operator<(const IntegralKey& k) const;
+        };
+        struct CouponIntegrals {
+            CouponKey coupon;
+            std::map<IntegralKey, Real> integrals;
+        };
+        // most recently used first
+        mutable std::list<CouponIntegrals> integrals_;
+        static const Size maxCachedCoupons_ = 32;
     };
 
     //! CMS-coupon pricer
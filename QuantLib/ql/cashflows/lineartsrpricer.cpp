@@ -79,11 +79,54 @@ namespace QuantLib {
     }
 
     const Real LinearTsrPricer::integrand(const Real strike) const {
-        return 2.0 * a_ * smileSection_->optionPrice(
+        return smileSection_->optionPrice(
                               strike, strike < swapRateValue_ ? Option::Put
                                                               : Option::Call);
     }
 
+    bool LinearTsrPricer::SectionKey::operator==(const SectionKey &k) const {
+        return fixingDate == k.fixingDate && tenorUnits == k.tenorUnits &&
+               tenorLength == k.tenorLength && swapRate == k.swapRate;
+    }
+
+    Real LinearTsrPricer::smileIntegral(Real lower, Real upper) const {
+        // the integral depends on the coupon only through the smile
+        // section, which is determined by the fixing date and the swap
+        // tenor (and by the swap rate if an atm level is added)
+        SectionKey section = { fixingDate_, swapTenor_.length(),
+                               swapTenor_.units(), swapRateValue_ };
+        std::list<SectionIntegrals>::iterator s = integrals_.begin();
+        while (s != integrals_.end() && !(s->section == section))
+            ++s;
+        if (s == integrals_.end()) {
+            // sections left behind by curve changes are eventually
+            // dropped as the least recently used
+            if (integrals_.size() >= maxCachedSections_)
+                integrals_.pop_back();
+            integrals_.push_front(SectionIntegrals());
+            integrals_.front().section = section;
+        } else if (s != integrals_.begin()) {
+            integrals_.splice(integrals_.begin(), integrals_, s);
+        }
+        std::map<std::pair<Real, Real>, Real> &integrals =
+            integrals_.front().integrals;
+        std::pair<Real, Real> bounds(lower, upper);
+        std::map<std::pair<Real, Real>, Real>::const_iterator i =
+            integrals.find(bounds);
+        if (i != integrals.end())
+            return i->second;
+        Real result = integrator_->operator()(
+            std::bind1st(std::mem_fun(&LinearTsrPricer::integrand), this),
+            lower, upper);
+        integrals[bounds] = result;
+        return result;
+    }
+
+    void LinearTsrPricer::update() {
+        integrals_.clear();
+        CmsCouponPricer::update();
+    }
+
     void LinearTsrPricer::initialize(const FloatingRateCoupon &coupon) {
 
         coupon_ = dynamic_cast<const CmsCoupon *>(&coupon);
@@ -307,19 +350,13 @@ namespace QuantLib {
         if (upper > lower) {
             tmpBound = std::min(upper, swapRateValue_);
             if (tmpBound > lower) {
-                result += integrator_->operator()(
-                    std::bind1st(std::mem_fun(&LinearTsrPricer::integrand),
-                                 this),
-                    lower, tmpBound);
+                result += smileIntegral(lower, tmpBound);
             }
             tmpBound = std::max(lower, swapRateValue_);
             if (upper > tmpBound) {
-                result += integrator_->operator()(
-                    std::bind1st(std::mem_fun(&LinearTsrPricer::integrand),
-                                 this),
-                    tmpBound, upper);
+                result += smileIntegral(tmpBound, upper);
             }
-            result *= (optionType == Option::Call ? 1.0 : -1.0);
+            result *= 2.0 * a_ * (optionType == Option::Call ? 1.0 : -1.0);
         }
 
         result += singularTerms(optionType, strike);
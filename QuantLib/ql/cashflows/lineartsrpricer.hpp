@@ -28,6 +28,8 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/indexes/swapindex.hpp>
 #include <ql/math/integrals/integral.hpp>
+#include <list>
+#include <map>
 
 namespace QuantLib {
 
@@ -54,6 +56,16 @@ namespace QuantLib {
         lower and upper bound are applied to strike + shift so that
         e.g. a zero lower bound always refers to the lower bound of
         the rates in the shifted lognormal model.
+
+        The integrals of the smile over the replication strikes do not
+        depend on the coupon; they are cached by bounds for each smile
+        section, i.e., fixing date, swap tenor and swap rate, so that
+        the swaplet, caplet and floorlet of a coupon and the coupons
+        sharing the fixing date and the index (e.g. in several legs
+        priced in turn) reuse them.  The integrals of the most recently
+        used sections are kept, so that the cache doesn't grow each
+        time the curves move the swap rates; it is cleared when the
+        pricer is notified of a change, e.g. in the volatility.
     */
 
     class LinearTsrPricer : public CmsCouponPricer, public MeanRevertingPricer {
@@ -143,6 +155,8 @@ namespace QuantLib {
             registerWith(meanReversion_);
             update();
         }
+        /* */
+        void update();
 
 
       private:
@@ -150,8 +164,25 @@ namespace QuantLib {
         const Real GsrG(const Date &d) const;
         const Real singularTerms(const Option::Type type, const Real strike) const;
         const Real integrand(const Real strike) const;
+        Real smileIntegral(Real lower, Real upper) const;
         Real a_, b_;
 
+        struct SectionKey {
+            Date fixingDate;
+            Integer tenorLength;
+            TimeUnit tenorUnits;
+            Real swapRate;
+            bool operator==(const SectionKey &k) const;
+        };
+        struct SectionIntegrals {
+            SectionKey section;
+            // by lower and upper bound
+            std::map<std::pair<Real, Real>, Real> integrals;
+        };
+        // most recently used first
+        mutable std::list<SectionIntegrals> integrals_;
+        static const Size maxCachedSections_ = 32;
+
         class VegaRatioHelper {
           public:
             VegaRatioHelper(const SmileSection *section, const Real targetVega)
@@ -47,6 +47,10 @@ namespace QuantLib {
                        << integrationPoints << ")");
         integrator_ =
             boost::make_shared<GaussHermiteIntegration>(integrationPoints);
+        const Array &x = integrator_->x(), &w = integrator_->weights();
+        weights_ = Array(integrationPoints);
+        for (Size i = 0; i < integrationPoints; ++i)
+            weights_[i] = w[i] / M_SQRTPI * std::exp(-x[i] * x[i]);
 
         cnd_ = boost::make_shared<CumulativeNormalDistribution>(0.0, 1.0);
 
@@ -54,32 +58,66 @@ namespace QuantLib {
         privateObserver_->registerWith(cmsPricer_);
     }
 
-    const Real LognormalCmsSpreadPricer::integrand(const Real x) const {
-
-        // this is Brigo, 13.16.2 with x = v/sqrt(2)
-
-        Real v = M_SQRT2 * x;
-        Real h =
-            k_ - b_ * s2_ * std::exp((m2_ - 0.5 * v2_ * v2_) * fixingTime_ +
-                                     v2_ * sqrt(fixingTime_) * v);
-        Real phi1, phi2;
-        phi1 = cnd_->operator()(
-            phi_ * (std::log(a_ * s1_ / h) +
-                    (m1_ + (0.5 - rho_ * rho_) * v1_ * v1_) * fixingTime_ +
-                    rho_ * v1_ * std::sqrt(fixingTime_) * v) /
-            (v1_ * sqrt(fixingTime_ * (1.0 - rho_ * rho_))));
-        phi2 =
-            cnd_->operator()(phi_ * (std::log(a_ * s1_ / h) +
-                                     (m1_ - 0.5 * v1_ * v1_) * fixingTime_ +
-                                     rho_ * v1_ * std::sqrt(fixingTime_) * v) /
-                             (v1_ * sqrt(fixingTime_ * (1.0 - rho_ * rho_))));
-        Real f = a_ * phi_ * s1_ *
-                     std::exp(m1_ * fixingTime_ -
-                              0.5 * rho_ * rho_ * v1_ * v1_ * fixingTime_ +
-                              rho_ * v1_ * sqrt(fixingTime_) * v) *
-                     phi1 -
-                 phi_ * h * phi2;
-        return 1.0 / M_SQRTPI * std::exp(-x * x) * f;
+    void LognormalCmsSpreadPricer::calculateNodeTerms(
+                                                CacheEntry &entry) const {
+
+        // this is Brigo, 13.16.2 with x = v/sqrt(2); the terms which
+        // depend on v only are calculated here for each node
+
+        Real mu1 = 1.0 / fixingTime_ *
+                   std::log(entry.adjustedRate1 / entry.swapRate1);
+        Real mu2 = 1.0 / fixingTime_ *
+                   std::log(entry.adjustedRate2 / entry.swapRate2);
+        Real sqrtT = std::sqrt(fixingTime_);
+        const Array &x = integrator_->x();
+        Size n = x.size();
+
+        for (Size j = 0; j < 2; ++j) {
+            // j == 0 for positive strikes, j == 1 for negative ones
+            Real a = j == 0 ? entry.gearing1 : -entry.gearing2;
+            Real b = j == 0 ? entry.gearing2 : -entry.gearing1;
+            Real s1 = j == 0 ? entry.swapRate1 : entry.swapRate2;
+            Real s2 = j == 0 ? entry.swapRate2 : entry.swapRate1;
+            Real m1 = j == 0 ? mu1 : mu2;
+            Real m2 = j == 0 ? mu2 : mu1;
+            Real v1 = j == 0 ? entry.vol1 : entry.vol2;
+            Real v2 = j == 0 ? entry.vol2 : entry.vol1;
+            Real rho = entry.rho;
+
+            NodeTerms &t = entry.terms[j];
+            t.a = a;
+            t.s1 = s1;
+            t.c1 = (m1 + (0.5 - rho * rho) * v1 * v1) * fixingTime_;
+            t.c2 = (m1 - 0.5 * v1 * v1) * fixingTime_;
+            t.denominator = v1 * sqrt(fixingTime_ * (1.0 - rho * rho));
+            t.e2 = Array(n);
+            t.l = Array(n);
+            t.f = Array(n);
+            for (Size i = 0; i < n; ++i) {
+                Real v = M_SQRT2 * x[i];
+                t.e2[i] = b * s2 * std::exp((m2 - 0.5 * v2 * v2) * fixingTime_ +
+                                            v2 * sqrtT * v);
+                t.l[i] = rho * v1 * sqrtT * v;
+                t.f[i] = a * s1 * std::exp(m1 * fixingTime_ -
+                                           0.5 * rho * rho * v1 * v1 *
+                                               fixingTime_ +
+                                           t.l[i]);
+            }
+        }
+    }
+
+    Real LognormalCmsSpreadPricer::integral(const NodeTerms &t, Real phi,
+                                            Real strike) const {
+        const CumulativeNormalDistribution &cnd = *cnd_;
+        Real sum = 0.0;
+        for (Integer i = Integer(weights_.size()) - 1; i >= 0; --i) {
+            Real h = strike - t.e2[i];
+            Real logTerm = std::log(t.a * t.s1 / h) + t.l[i];
+            Real phi1 = cnd(phi * (logTerm + t.c1) / t.denominator);
+            Real phi2 = cnd(phi * (logTerm + t.c2) / t.denominator);
+            sum += weights_[i] * (phi * t.f[i] * phi1 - phi * h * phi2);
+        }
+        return sum;
     }
 
     void LognormalCmsSpreadPricer::flushCache() { cache_.clear(); }
@@ -149,80 +187,89 @@ namespace QuantLib {
             swapRate1_ = c1_->indexFixing();
             swapRate2_ = c2_->indexFixing();
 
-            // costly part, look up in cache first
+            rho_ = std::max(std::min(correlation()->value(), 0.9999),
+                            -0.9999); // avoid division by zero in integrand
+
+            // costly part, look up in cache first; the entry is
+            // shared by the coupons with the same index and fixing
+            // date, as long as the forward swap rates are the same
             std::pair<std::string, Date> key =
                 std::make_pair(index_->name(), fixingDate_);
-            CacheType::const_iterator k = cache_.find(key);
-            if (k != cache_.end()) {
-                adjustedRate1_ = k->second.first;
-                adjustedRate2_ = k->second.second;
-            } else {
-                adjustedRate1_ = c1_->adjustedFixing();
-                adjustedRate2_ = c2_->adjustedFixing();
-                cache_.insert(std::make_pair(
-                    key, std::make_pair(adjustedRate1_, adjustedRate2_)));
-            }
-
-            boost::shared_ptr<SwaptionVolatilityStructure> swvol =
-                *cmsPricer_->swaptionVolatility();
-            boost::shared_ptr<SwaptionVolatilityCube> swcub =
-                boost::dynamic_pointer_cast<SwaptionVolatilityCube>(swvol);
-
-            if (swcub == NULL) {
-                vol1_ = swvol->volatility(
-                    fixingDate_, index_->swapIndex1()->tenor(), swapRate1_);
-                vol2_ = swvol->volatility(
-                    fixingDate_, index_->swapIndex1()->tenor(), swapRate2_);
-            } else {
-                vol1_ = swcub->smileSection(fixingDate_,
-                                            index_->swapIndex1()->tenor())
-                            ->volatility(swapRate1_,
-                                         ShiftedLognormal, 0.0);
-                vol2_ = swcub->smileSection(fixingDate_,
-                                            index_->swapIndex2()->tenor())
-                            ->volatility(swapRate2_,
-                                         ShiftedLognormal, 0.0);
+            CacheType::iterator k = cache_.find(key);
+            if (k == cache_.end() || k->second.swapRate1 != swapRate1_ ||
+                k->second.swapRate2 != swapRate2_) {
+                CacheEntry entry;
+                entry.swapRate1 = swapRate1_;
+                entry.swapRate2 = swapRate2_;
+                entry.adjustedRate1 = c1_->adjustedFixing();
+                entry.adjustedRate2 = c2_->adjustedFixing();
+
+                boost::shared_ptr<SwaptionVolatilityStructure> swvol =
+                    *cmsPricer_->swaptionVolatility();
+                boost::shared_ptr<SwaptionVolatilityCube> swcub =
+                    boost::dynamic_pointer_cast<SwaptionVolatilityCube>(swvol);
+
+                if (swcub == NULL) {
+                    entry.vol1 = swvol->volatility(
+                        fixingDate_, index_->swapIndex1()->tenor(),
+                        swapRate1_);
+                    entry.vol2 = swvol->volatility(
+                        fixingDate_, index_->swapIndex1()->tenor(),
+                        swapRate2_);
+                } else {
+                    entry.vol1 = swcub->smileSection(
+                                     fixingDate_,
+                                     index_->swapIndex1()->tenor())
+                                     ->volatility(swapRate1_,
+                                                  ShiftedLognormal, 0.0);
+                    entry.vol2 = swcub->smileSection(
+                                     fixingDate_,
+                                     index_->swapIndex2()->tenor())
+                                     ->volatility(swapRate2_,
+                                                  ShiftedLognormal, 0.0);
+                }
+
+                entry.gearing1 = gearing1_;
+                entry.gearing2 = gearing2_;
+                entry.rho = rho_;
+                calculateNodeTerms(entry);
+                if (k == cache_.end())
+                    k = cache_.insert(std::make_pair(key, entry)).first;
+                else
+                    k->second = entry;
+            } else if (k->second.gearing1 != gearing1_ ||
+                       k->second.gearing2 != gearing2_ ||
+                       k->second.rho != rho_) {
+                k->second.gearing1 = gearing1_;
+                k->second.gearing2 = gearing2_;
+                k->second.rho = rho_;
+                calculateNodeTerms(k->second);
             }
 
+            adjustedRate1_ = k->second.adjustedRate1;
+            adjustedRate2_ = k->second.adjustedRate2;
+            vol1_ = k->second.vol1;
+            vol2_ = k->second.vol2;
             mu1_ = 1.0 / fixingTime_ * std::log(adjustedRate1_ / swapRate1_);
             mu2_ = 1.0 / fixingTime_ * std::log(adjustedRate2_ / swapRate2_);
-
-            rho_ = std::max(std::min(correlation()->value(), 0.9999),
-                            -0.9999); // avoid division by zero in integrand
+            terms_[0] = k->second.terms[0];
+            terms_[1] = k->second.terms[1];
         }
     }
 
     Real LognormalCmsSpreadPricer::optionletPrice(Option::Type optionType,
                                                   Real strike) const {
 
-        phi_ = optionType == Option::Call ? 1.0 : -1.0;
+        Real phi = optionType == Option::Call ? 1.0 : -1.0;
         Real res = 0.0;
         if (strike >= 0.0) {
-            a_ = gearing1_;
-            b_ = gearing2_;
-            s1_ = swapRate1_;
-            s2_ = swapRate2_;
-            m1_ = mu1_;
-            m2_ = mu2_;
-            v1_ = vol1_;
-            v2_ = vol2_;
-            k_ = strike;
+            res += integral(terms_[0], phi, strike);
         } else {
-            a_ = -gearing2_;
-            b_ = -gearing1_;
-            s1_ = swapRate2_;
-            s2_ = swapRate1_;
-            m1_ = mu2_;
-            m2_ = mu1_;
-            v1_ = vol2_;
-            v2_ = vol1_;
-            k_ = -strike;
-            res += phi_ * (gearing1_ * adjustedRate1_ +
-                           gearing2_ * adjustedRate2_ - strike);
+            res += phi * (gearing1_ * adjustedRate1_ +
+                          gearing2_ * adjustedRate2_ - strike);
+            res += integral(terms_[1], phi, -strike);
         }
 
-        res += integrator_->operator()(std::bind1st(
-            std::mem_fun(&LognormalCmsSpreadPricer::integrand), this));
         return res * couponDiscountCurve_->discount(paymentDate_) *
                coupon_->accrualPeriod();
     }
@@ -35,7 +35,18 @@ namespace QuantLib {
     class YieldTermStructure;
 
     //! CMS spread - coupon pricer
-    /*! blah blah...
+    /*! The marginal distributions of the two swap rates (forward,
+        adjusted rate and volatility) and the terms of the integrand
+        at the Gauss-Hermite nodes which don't depend on the strike
+        are calculated once for each index and fixing date and shared
+        by all the coupons priced by the same instance; for each strike,
+        the integral is then a single loop over the nodes.
+
+        \test
+        - caplet and floorlet rates are checked against a brute-force
+          integration over the bivariate distribution of the rates.
+        - the results are checked to follow changes in the curve, in
+          the correlation and in the volatility.
     */
 
     class LognormalCmsSpreadPricer : public CmsSpreadCouponPricer {
@@ -70,13 +81,30 @@ namespace QuantLib {
 
         boost::shared_ptr<PrivateObserver> privateObserver_;
 
-        typedef std::map<std::pair<std::string, Date>, std::pair<Real, Real> >
-        CacheType;
+        // terms of the integrand at the quadrature nodes; the roles
+        // of the two rates are swapped for negative strikes
+        struct NodeTerms {
+            Real a, s1, c1, c2, denominator;
+            Array e2, l, f;
+        };
+
+        struct CacheEntry {
+            Real swapRate1, swapRate2;
+            Real adjustedRate1, adjustedRate2;
+            Real vol1, vol2;
+            // gearings and correlation the node terms were
+            // calculated for
+            Real gearing1, gearing2, rho;
+            NodeTerms terms[2];
+        };
+
+        typedef std::map<std::pair<std::string, Date>, CacheEntry> CacheType;
 
         void initialize(const FloatingRateCoupon &coupon);
         Real optionletPrice(Option::Type optionType, Real strike) const;
 
-        const Real integrand(const Real) const;
+        void calculateNodeTerms(CacheEntry &entry) const;
+        Real integral(const NodeTerms &terms, Real phi, Real strike) const;
 
         boost::shared_ptr<CmsCouponPricer> cmsPricer_;
 
@@ -95,6 +123,8 @@ namespace QuantLib {
 
         boost::shared_ptr<CumulativeNormalDistribution> cnd_;
         boost::shared_ptr<GaussianQuadrature> integrator_;
+        // quadrature weights times the Gaussian kernel
+        Array weights_;
 
         Real swapRate1_, swapRate2_, gearing1_, gearing2_;
         Real adjustedRate1_, adjustedRate2_;
@@ -102,7 +132,7 @@ namespace QuantLib {
         Real mu1_, mu2_;
         Real rho_;
 
-        mutable Real phi_, a_, b_, s1_, s2_, m1_, m2_, v1_, v2_, k_;
+        NodeTerms terms_[2];
 
         boost::shared_ptr<CmsCoupon> c1_, c2_;
 
@@ -51,6 +51,7 @@ namespace QuantLib {
         using LatentModel<copulaPolicy>::inverseCumulativeY;
         using LatentModel<copulaPolicy>::cumulativeZ;
         using LatentModel<copulaPolicy>::integratedExpectedValue;// which one?
+        using LatentModel<copulaPolicy>::integratedExpectedValueBatch;
     protected:
         // not a handle, the model doesnt keep any cached magnitudes, no need 
         //  for notifications, still...
@@ -58,6 +59,9 @@ namespace QuantLib {
         boost::shared_ptr<LMIntegration> integration_;
     private:
         typedef typename copulaPolicy::initTraits initTraits;
+        // probability of n or more events out of independent ones
+        static Probability probOfNEventsOrMore(Size n,
+            const std::vector<Probability>& pDefCond);
     public:
         /*!
         @param factorWeights Latent model independent factors weights for each 
@@ -198,6 +202,14 @@ namespace QuantLib {
         // \todo: check the issuer has not defaulted.
         Real conditionalProbAtLeastNEvents(Size n, const Date& date,
             const std::vector<Real>& mktFactors) const;
+        /*! Conditional probabilities of n default events or more on a set of
+        realizations of the factors.
+        @param invCumYProbs Inverse cumulatives of the unconditional default
+          probabilities; Null<Real>() for a name which can not default.
+        */
+        Disposable<std::vector<Real> > conditionalProbsAtLeastNEvents(Size n,
+            const std::vector<Real>& invCumYProbs,
+            const std::vector<std::vector<Real> >& mktFactors) const;
         //! access to integration:
         const boost::shared_ptr<LMIntegration>& 
             integration() const { return integration_; }
@@ -237,13 +249,25 @@ namespace QuantLib {
         defaults in the basket portfolio at a given time.
         */
         Probability probAtLeastNEvents(Size n, const Date& date) const {
-            return integratedExpectedValue(
-             boost::function<Real (const std::vector<Real>& v1)>(
+            QL_REQUIRE(basket_, "No portfolio basket set.");
+            const boost::shared_ptr<Pool>& pool = basket_->pool();
+            // the probabilities are inverted once rather than at every node
+            std::vector<Real> invCumYProbs;
+            for(Size i=0; i<basket_->size(); i++) {
+                Probability p = pool->get(pool->names()[i]).
+                    defaultProbability(basket_->defaultKeys()[i])->
+                    defaultProbability(date);
+                invCumYProbs.push_back(p < 1.e-10 ? Null<Real>() :
+                    inverseCumulativeY(p, i));
+            }
+            return integratedExpectedValueBatch(
+             boost::function<Disposable<std::vector<Real> > (
+                 const std::vector<std::vector<Real> >& v1)>(
               boost::bind(
-              &DefaultLatentModel<copulaPolicy>::conditionalProbAtLeastNEvents,
+              &DefaultLatentModel<copulaPolicy>::conditionalProbsAtLeastNEvents,
               this,
               n,
-              boost::cref(date),
+              boost::cref(invCumYProbs),
               _1)
              ));
         }
@@ -301,9 +325,6 @@ namespace QuantLib {
             Size poolSize = basket_->size();//move to 'livesize'
             const boost::shared_ptr<Pool>& pool = basket_->pool();
 
-            BigNatural limit = 
-                static_cast<BigNatural>(std::pow(2., (int)(poolSize)));
-
             // Precalc conditional probabilities
             std::vector<Probability> pDefCond;
             for(Size i=0; i<poolSize; i++)
@@ -312,6 +333,35 @@ namespace QuantLib {
                     defaultProbability(basket_->defaultKeys()[i])->
                     defaultProbability(date), i, mktFactors));
 
+            return probOfNEventsOrMore(n, pDefCond);
+        }
+
+
+    template<class CP>
+    Disposable<std::vector<Real> >
+        DefaultLatentModel<CP>::conditionalProbsAtLeastNEvents(Size n,
+            const std::vector<Real>& invCumYProbs,
+            const std::vector<std::vector<Real> >& mktFactors) const {
+            std::vector<Real> result(mktFactors.size());
+            std::vector<Probability> pDefCond(invCumYProbs.size());
+            for(Size k=0; k<mktFactors.size(); k++) {
+                for(Size i=0; i<invCumYProbs.size(); i++)
+                    pDefCond[i] = invCumYProbs[i] == Null<Real>() ? 0. :
+                        conditionalDefaultProbabilityInvP(invCumYProbs[i], i,
+                            mktFactors[k]);
+                result[k] = probOfNEventsOrMore(n, pDefCond);
+            }
+            return result;
+        }
+
+
+    template<class CP>
+    Probability DefaultLatentModel<CP>::probOfNEventsOrMore(Size n,
+        const std::vector<Probability>& pDefCond) {
+            const Size poolSize = pDefCond.size();
+            BigNatural limit = 
+                static_cast<BigNatural>(std::pow(2., (int)(poolSize)));
+
             Probability probNEventsOrMore = 0.;
             for(BigNatural mask = 
                   static_cast<BigNatural>(std::pow(2., (int)(n))-1);
@@ -0,0 +1,377 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fftlossmodel.hpp
+    \brief FFT convolution default loss model for heterogeneous pools
+*/
+
+#ifndef quantlib_fft_loss_model_hpp
+#define quantlib_fft_loss_model_hpp
+
+#include <ql/experimental/credit/constantlosslatentmodel.hpp>
+#include <ql/experimental/credit/defaultlossmodel.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
+#endif
+#include <boost/bind.hpp>
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic pop
+#endif
+#include <complex>
+#include <map>
+#include <numeric>
+#include <algorithm>
+
+namespace QuantLib {
+
+    /*! Default loss model for a heterogeneous pool of names computing the
+    portfolio loss distribution by Fourier inversion of its characteristic
+    function on a discretised loss grid.
+
+    Losses are measured in integer multiples of a loss unit (the smallest
+    name LGD amount divided by the number of buckets requested, as in the
+    recursive model). Conditional on the latent factors the names default
+    independently, so the conditional characteristic function of the loss is
+    the product over names of \f$ 1-p_i(M)+p_i(M) e^{-2\pi i k w_i/N} \f$ on
+    the N grid frequencies. Since the integration over the factors is linear
+    it is carried out in the frequency domain and only one inverse transform
+    is performed per date. Names sharing loss weight, unconditional
+    probability and factor loadings are grouped and their contribution is
+    raised to the group multiplicity.
+
+    The unconditional loss distribution depends on the pool only and not on
+    the tranche limits; it is cached by date and reused by every basket
+    (tranche) on the same pool sharing this model instance. Entries are
+    discarded when the copula notifies or when the default probabilities or
+    loss weights of the live names change.
+
+    When built with OpenMP support the frequencies are evaluated in parallel
+    at each integration node.
+
+    \todo Make the loss unit depend on the greatest common divisor of the
+    LGD amounts.
+    */
+    template<class copulaPolicy>
+    class FFTLossModel : public DefaultLossModel, public virtual Observer {
+    public:
+        FFTLossModel(
+            const boost::shared_ptr<ConstantLossLatentmodel<copulaPolicy> >& m,
+            Size nBuckets = 1)
+        : copula_(m), nBuckets_(nBuckets), lossUnit_(0.) {
+            QL_REQUIRE(nBuckets_ > 0, "Zero buckets in loss unit.");
+            registerWith(copula_);
+        }
+        void update() {
+            distributions_.clear();
+            notifyObservers();
+        }
+    protected:
+        void resetModel();
+    public:
+        //! Expected tranche loss, summed over the cached loss grid.
+        Real expectedTrancheLoss(const Date& date) const;
+        /*! Probabilities of each of the attainable portfolio losses, the
+            i-th value being the probability of losing i loss units.
+        */
+        Disposable<std::vector<Real> > lossProbability(const Date& date) const;
+        //! Cumulative portfolio loss distribution.
+        Disposable<std::map<Real, Probability> > lossDistribution(
+            const Date& d) const;
+        Probability probOverLoss(const Date& d, Real lossFraction) const;
+        Real percentile(const Date& d, Real percentile) const;
+        Real expectedShortfall(const Date& d, Real perctl) const;
+        //! Size of the loss unit in basket notional amounts.
+        Real lossUnit() const { return lossUnit_; }
+    private:
+        /* Integrand; returns the conditional characteristic function on the
+        non-negative frequencies with real and imaginary parts interleaved.
+        */
+        Disposable<std::vector<Real> > conditionalCharacteristic(
+            const std::vector<Real>& invProbs,
+            const std::vector<Size>& leaders,
+            const std::vector<Size>& multiplicities,
+            const std::vector<Real>& mktFactor) const;
+        const std::vector<Real>& distribution(const Date& d) const;
+        Real trancheLoss(Real portfolioLoss) const {
+            return std::min(std::max(portfolioLoss - attachAmount_, 0.),
+                detachAmount_ - attachAmount_);
+        }
+
+        const boost::shared_ptr<ConstantLossLatentmodel<copulaPolicy> > copula_;
+        const Size nBuckets_;
+        // live basket magnitudes
+        mutable Real lossUnit_, attachAmount_, detachAmount_;
+        mutable std::vector<Size> wk_;
+        // grid and transform, N >= sum_k wk_ + 1 to avoid aliasing
+        mutable Size gridSize_;
+        mutable boost::shared_ptr<FastFourierTransform> fft_;
+        // N-th roots of unity, exp(-2 pi i m/N)
+        mutable std::vector<std::complex<Real> > roots_;
+        // cached unconditional loss probabilities per date with the
+        //   unconditional probabilities they were computed with
+        struct CachedDistribution {
+            std::vector<Probability> probabilities;
+            std::vector<Real> density;
+        };
+        mutable std::map<Date, CachedDistribution> distributions_;
+    };
+
+    typedef FFTLossModel<GaussianCopulaPolicy> FFTGaussLossModel;
+    typedef FFTLossModel<TCopulaPolicy> FFTStudentLossModel;
+
+    // -------------------------------------------------------------------
+
+    template<class CP>
+    void FFTLossModel<CP>::resetModel() {
+        attachAmount_ = basket_->remainingAttachmentAmount();
+        detachAmount_ = basket_->remainingDetachmentAmount();
+        copula_->resetBasket(basket_.currentLink());
+
+        const std::vector<Real>& notionals = basket_->remainingNotionals();
+        const std::vector<Real>& recoveries = copula_->recoveries();
+        std::vector<Real> lgds;
+        for(Size i=0; i<notionals.size(); i++)
+            lgds.push_back(notionals[i]*(1.-recoveries[i]));
+        Real minLgd = QL_MAX_REAL;
+        for(Size i=0; i<lgds.size(); i++)
+            if(lgds[i] > 0.) minLgd = std::min(minLgd, lgds[i]);
+        QL_REQUIRE(minLgd < QL_MAX_REAL, "Basket has no loss at default.");
+        Real lossUnit = minLgd / nBuckets_;
+
+        std::vector<Size> wk;
+        Size totalUnits = 0;
+        for(Size i=0; i<lgds.size(); i++) {
+            wk.push_back(static_cast<Size>(std::floor(lgds[i]/lossUnit + .5)));
+            totalUnits += wk.back();
+        }
+
+        // another tranche on the same pool keeps the cached distributions
+        if(wk == wk_ && lossUnit == lossUnit_) return;
+
+        wk_.swap(wk);
+        lossUnit_ = lossUnit;
+        distributions_.clear();
+
+        Size order = FastFourierTransform::min_order(totalUnits + 1);
+        fft_ = boost::shared_ptr<FastFourierTransform>(
+            new FastFourierTransform(std::max<Size>(order, 1)));
+        gridSize_ = fft_->output_size();
+        roots_.resize(gridSize_);
+        for(Size m=0; m<gridSize_; m++)
+            roots_[m] = std::polar(1., -2. * M_PI * m / gridSize_);
+    }
+
+    template<class CP>
+    const std::vector<Real>& FFTLossModel<CP>::distribution(
+        const Date& d) const
+    {
+        std::vector<Probability> uncDefProb =
+            basket_->remainingProbabilities(d);
+
+        typename std::map<Date, CachedDistribution>::const_iterator it =
+            distributions_.find(d);
+        if(it != distributions_.end() &&
+            it->second.probabilities == uncDefProb)
+            return it->second.density;
+
+        // invert once, outside the integration, and group the names
+        //   sharing loss weight, probability and loadings. Names with
+        //   negligible probability do not contribute.
+        const std::vector<std::vector<Real> >& weights =
+            copula_->factorWeights();
+        std::vector<Real> invProb(uncDefProb.size(), Null<Real>());
+        std::vector<Size> leaders, multiplicities;
+        for(Size i=0; i<uncDefProb.size(); i++) {
+            if(uncDefProb[i] < 1.e-10 || wk_[i] == 0) continue;
+            invProb[i] = copula_->inverseCumulativeY(uncDefProb[i], i);
+            Size h = 0;
+            for(; h<leaders.size(); h++) {
+                Size l = leaders[h];
+                if(wk_[l] == wk_[i] && invProb[l] == invProb[i]
+                    && weights[l] == weights[i]) break;
+            }
+            if(h == leaders.size()) {
+                leaders.push_back(i);
+                multiplicities.push_back(1);
+            } else {
+                multiplicities[h]++;
+            }
+        }
+
+        std::vector<Real> charFunction = copula_->integratedExpectedValue(
+            boost::function<Disposable<std::vector<Real> > (
+                const std::vector<Real>& v1)>(
+                boost::bind(
+                    &FFTLossModel::conditionalCharacteristic,
+                    this,
+                    boost::cref(invProb),
+                    boost::cref(leaders),
+                    boost::cref(multiplicities),
+                    _1)
+                )
+            );
+
+        // rebuild the hermitian spectrum and invert
+        std::vector<std::complex<Real> > spectrum(gridSize_),
+            density(gridSize_);
+        for(Size k=0; k<=gridSize_/2; k++)
+            spectrum[k] = std::complex<Real>(charFunction[2*k],
+                charFunction[2*k+1]);
+        for(Size k=gridSize_/2+1; k<gridSize_; k++)
+            spectrum[k] = std::conj(spectrum[gridSize_-k]);
+        fft_->inverse_transform(spectrum.begin(), spectrum.end(),
+            density.begin());
+
+        CachedDistribution& cached = distributions_[d];
+        cached.probabilities.swap(uncDefProb);
+        Size attainable = std::accumulate(wk_.begin(), wk_.end(), Size(0)) + 1;
+        cached.density.resize(attainable);
+        for(Size j=0; j<attainable; j++)
+            // round-off might leave tiny negative values
+            cached.density[j] = std::max(density[j].real() / gridSize_, 0.);
+        return cached.density;
+    }
+
+    template<class CP>
+    Disposable<std::vector<Real> >
+        FFTLossModel<CP>::conditionalCharacteristic(
+            const std::vector<Real>& invProbs,
+            const std::vector<Size>& leaders,
+            const std::vector<Size>& multiplicities,
+            const std::vector<Real>& mktFactor) const
+    {
+        std::vector<Probability> pDef(leaders.size());
+        for(Size h=0; h<leaders.size(); h++)
+            pDef[h] = copula_->conditionalDefaultProbabilityInvP(
+                invProbs[leaders[h]], leaders[h], mktFactor);
+
+        const Size nFreqs = gridSize_/2 + 1;
+        std::vector<Real> result(2 * nFreqs);
+        const long nFreqsL = static_cast<long>(nFreqs);
+        #pragma omp parallel for
+        for(long kl=0; kl<nFreqsL; kl++) {
+            const Size k = static_cast<Size>(kl);
+            std::complex<Real> phi(1., 0.);
+            for(Size h=0; h<leaders.size(); h++) {
+                // name loss phase: exp(-2 pi i k w/N)
+                std::complex<Real> term = (1.-pDef[h]) +
+                    pDef[h] * roots_[(k * wk_[leaders[h]]) % gridSize_];
+                phi *= multiplicities[h] == 1 ? term :
+                    std::pow(term, static_cast<int>(multiplicities[h]));
+            }
+            result[2*k]   = phi.real();
+            result[2*k+1] = phi.imag();
+        }
+        return result;
+    }
+
+    template<class CP>
+    inline Real FFTLossModel<CP>::expectedTrancheLoss(
+        const Date& date) const
+    {
+        const std::vector<Real>& density = distribution(date);
+        Real expLoss = 0.;
+        for(Size j=0; j<density.size(); j++) {
+            Real loss = trancheLoss(j * lossUnit_);
+            expLoss += loss * density[j];
+            // past the detachment the loss is constant:
+            if(j * lossUnit_ >= detachAmount_) {
+                Real tail = 0.;
+                for(Size l=j+1; l<density.size(); l++) tail += density[l];
+                expLoss += loss * tail;
+                break;
+            }
+        }
+        return expLoss;
+    }
+
+    template<class CP>
+    inline Disposable<std::vector<Real> >
+        FFTLossModel<CP>::lossProbability(const Date& date) const {
+        std::vector<Real> result = distribution(date);
+        return result;
+    }
+
+    template<class CP>
+    Disposable<std::map<Real, Probability> >
+        FFTLossModel<CP>::lossDistribution(const Date& d) const
+    {
+        std::map<Real, Probability> distrib;
+        const std::vector<Real>& values = distribution(d);
+        Real sum = 0.;
+        for(Size i=0; i<values.size(); i++) {
+            sum += values[i];
+            distrib.insert(std::make_pair(i * lossUnit_, sum));
+        }
+        return distrib;
+    }
+
+    template<class CP>
+    Probability FFTLossModel<CP>::probOverLoss(const Date& d,
+        Real lossFraction) const
+    {
+        // tranche fraction to portfolio loss
+        Real portfLoss = attachAmount_ +
+            (detachAmount_ - attachAmount_) * lossFraction;
+        const std::vector<Real>& values = distribution(d);
+        Probability prob = 0.;
+        for(Size i=0; i<values.size(); i++)
+            if(i * lossUnit_ >= portfLoss) prob += values[i];
+        return prob;
+    }
+
+    template<class CP>
+    Real FFTLossModel<CP>::percentile(const Date& d,
+        Real percentile) const
+    {
+        const std::vector<Real>& values = distribution(d);
+        Real sum = 0.;
+        Size i = 0;
+        for(; i<values.size(); i++) {
+            sum += values[i];
+            if(sum >= percentile) break;
+        }
+        if(i == values.size()) i--;
+        return trancheLoss(i * lossUnit_);
+    }
+
+    template<class CP>
+    Real FFTLossModel<CP>::expectedShortfall(const Date& d,
+        Real perctl) const
+    {
+        if(d == Settings::instance().evaluationDate()) return 0.;
+        QL_REQUIRE(perctl >= 0. && perctl < 1.,
+            "Percentile argument out of bounds.");
+        const std::vector<Real>& values = distribution(d);
+        // losses in the tail, splitting the atom crossing the percentile
+        Real sum = 0., tailLoss = 0.;
+        for(Size i=0; i<values.size(); i++) {
+            Real next = sum + values[i];
+            if(next > perctl)
+                tailLoss += trancheLoss(i * lossUnit_) *
+                    (next - std::max(sum, perctl));
+            sum = next;
+        }
+        return tailLoss / (1.-perctl);
+    }
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include <ql/math/beta.hpp>
 #include <ql/math/statistics/histogram.hpp>
 #include <ql/math/statistics/riskstatistics.hpp>
+#include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/experimental/credit/basket.hpp>
@@ -36,6 +37,10 @@
 
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* Intended to replace
     ql\experimental\credit\randomdefaultmodel.Xpp
 */
@@ -67,16 +72,46 @@ namespace QuantLib {
     // replaces class Loss
     template <class simEventOwner> struct simEvent;
 
+    /*! Read only view on the events of one simulation.\par
+    Simulations are stored packed one after the other in a single buffer
+    rather than in a vector per simulation; a path with no events then costs
+    only its offset into the buffer.
+    */
+    template <class simEventType>
+    class SimulationEvents {
+      public:
+        typedef const simEventType* const_iterator;
+        SimulationEvents(const_iterator begin, const_iterator end)
+        : begin_(begin), end_(end) {}
+        Size size() const { return end_ - begin_; }
+        bool empty() const { return begin_ == end_; }
+        const simEventType& operator[](Size i) const { return begin_[i]; }
+        const_iterator begin() const { return begin_; }
+        const_iterator end() const { return end_; }
+      private:
+        const_iterator begin_, end_;
+    };
+
 
     /*! Base class for latent model monte carlo simulation. Independent of the
     copula type and the generator.
     Generates the factors and variable samples and determines event threshold
     but it is not responsible for actual event specification; thats the derived
     classes responsibility according to what they model.
-    Derived classes need mainly to implement nextSample (Worker::nextSample in
-    the multithreaded version) to compute the simulation event generated, if
-    any, from the latent variables sample. They also have the accompanying
-    event trait to specify.
+    Derived classes need mainly to implement nextSample to compute the
+    simulation events generated, if any, from the latent variables sample and
+    append them to the buffer given. They also have the accompanying event
+    trait to specify.
+
+    The simulations are run in contiguous blocks of fixed size, each on its
+    own copy of the factor sampler positioned at the start of the block with
+    skipTo; low-discrepancy samplers skip ahead in their sequence, while the
+    pseudo-random ones start an independent stream for each block. When
+    compiled with OpenMP the blocks are run concurrently; since the blocks do
+    not depend on the number of threads, neither do the simulated events.
+    nextSample must then be safe to be called concurrently; the default term
+    structures are evaluated once before the simulation starts (see
+    initDates) so that lazy calculations are not triggered from the workers.
     */
     /* CRTP used for performance to avoid virtual table resolution in the Monte
     Carlo. Not only in sample generation but access; quite an amount of time can
@@ -100,6 +135,7 @@ namespace QuantLib {
         // random generation is performed in this class only.
         typedef typename LatentModel<copulaPolicy>::template FactorSampler<USNG>
             copulaRNG_type;
+        typedef simEvent<derivedRandomLM<copulaPolicy, USNG> > simEventType;
     protected:
         RandomLM(Size numFactors,
             Size numLMVars,
@@ -111,6 +147,7 @@ namespace QuantLib {
 
         void update() {
             simsBuffer_.clear();
+            simsOffsets_.clear();
             // tell basket to notify instruments, etc, we are invalid
             if(!basket_.empty()) basket_->notifyObservers();
             LazyObject::update();
@@ -119,29 +156,94 @@ namespace QuantLib {
         void performCalculations() const {
             static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
                 this)->initDates();//in update?
-            copulasRng_ = boost::make_shared<copulaRNG_type>(copula_, seed_);
             performSimulations();
         }
 
         void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
-            for(Size i=nSims_; i; i--) {
-                const std::vector<Real>& sample =
-                    copulasRng_->nextSequence().value;
+            simsBuffer_.clear();
+            simsOffsets_.assign(1, 0);
+            simsOffsets_.reserve(nSims_ + 1);
+            const Size blockSize = simsPerBlock_;
+            const Size nBlocks = (nSims_ + blockSize - 1) / blockSize;
+            #ifdef _OPENMP
+            const bool concurrent = nBlocks > 1 && omp_get_max_threads() > 1;
+            #else
+            const bool concurrent = false;
+            #endif
+            if(!concurrent) {
+                // straight into the buffer
+                for(Size b=0; b<nBlocks; b++) {
+                    const Size first = b * blockSize;
+                    copulaRNG_type blockRng(copula_, seed_);
+                    blockRng.skipTo(first);
+                    simulateBlock(blockRng,
+                        std::min(blockSize, nSims_ - first),
+                        simsBuffer_, simsOffsets_);
+                }
+                return;
+            }
+
+            std::vector<std::vector<simEventType> > blockEvents(nBlocks);
+            std::vector<std::vector<Size> > blockOffsets(nBlocks);
+            std::vector<std::string> blockErrors(nBlocks);
+            const long nBlocksL = static_cast<long>(nBlocks);
+            #pragma omp parallel for schedule(dynamic)
+            for(long b=0; b<nBlocksL; b++) {
+                // exceptions can not leave the parallel region
+                try {
+                    const Size first = b * blockSize;
+                    const Size n = std::min(blockSize, nSims_ - first);
+                    copulaRNG_type blockRng(copula_, seed_);
+                    blockRng.skipTo(first);
+                    blockOffsets[b].reserve(n);
+                    simulateBlock(blockRng, n, blockEvents[b],
+                        blockOffsets[b]);
+                } catch(std::exception& e) {
+                    blockErrors[b] = e.what();
+                }
+            }
+            for(Size b=0; b<nBlocks; b++)
+                QL_REQUIRE(blockErrors[b].empty(), blockErrors[b]);
+
+            // gather, in sequence order
+            Size totalEvents = 0;
+            for(Size b=0; b<nBlocks; b++)
+                totalEvents += blockEvents[b].size();
+            simsBuffer_.reserve(totalEvents);
+            for(Size b=0; b<nBlocks; b++) {
+                const Size base = simsBuffer_.size();
+                simsBuffer_.insert(simsBuffer_.end(), blockEvents[b].begin(),
+                    blockEvents[b].end());
+                for(Size i=0; i<blockOffsets[b].size(); i++)
+                    simsOffsets_.push_back(base + blockOffsets[b][i]);
+                std::vector<simEventType>().swap(blockEvents[b]);
+            }
+        }
+
+        /* Runs nSims consecutive simulations on the given sampler, appending
+        the events to the buffer and the end offset of each simulation to the
+        offsets. */
+        void simulateBlock(const copulaRNG_type& rng, Size nSims,
+            std::vector<simEventType>& events,
+            std::vector<Size>& offsets) const {
+            for(Size i=nSims; i; i--) {
+                const std::vector<Real>& sample = rng.nextSequence().value;
                 static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+                    this)->nextSample(sample, events);
+                offsets.push_back(events.size());
             }
         }
 
-        /* Method to access simulation results and avoiding a copy of
-        each thread results buffer. PerformCalculations should have been called.
-        Here in the monothread version this method is redundant/trivial but
-        serves to detach the statistics access to the way the simulations are
-        stored.
+        /* Method to access simulation results. PerformCalculations should
+        have been called. Detaches the statistics access from the way the
+        simulations are stored.
         */
-        const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
-            getSim(const Size iSim) const { return simsBuffer_[iSim]; }
+        SimulationEvents<simEventType> getSim(const Size iSim) const {
+            const simEventType* data =
+                simsBuffer_.empty() ? 0 : &simsBuffer_[0];
+            return SimulationEvents<simEventType>(data + simsOffsets_[iSim],
+                data + simsOffsets_[iSim+1]);
+        }
 
         /* Allows statistics to be written generically for fixed and random
         recovery rates. */
@@ -212,11 +314,16 @@ namespace QuantLib {
 
         const Size nSims_;
 
-        mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
-            USNG > > > > simsBuffer_;
+        // events of all simulations, packed; the events of the i-th
+        //   simulation are in [simsOffsets_[i], simsOffsets_[i+1])
+        mutable std::vector<simEventType> simsBuffer_;
+        mutable std::vector<Size> simsOffsets_;
 
         mutable copulaPolicy copula_;
-        mutable boost::shared_ptr<copulaRNG_type> copulasRng_;
+
+        // simulations run on each positioned sampler; a power of two keeps
+        //   each block of a Sobol sequence a (t,m,s)-net
+        static const Size simsPerBlock_ = 1024;
 
         // Maximum time inversion horizon
         static const Size maxHorizon_ = 4050; // over 11 years
@@ -242,7 +349,7 @@ namespace QuantLib {
         Real counts = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
             Size simCount = 0;
-            const std::vector<simEvent<D<C, URNG> > >& events =
+            const SimulationEvents<simEvent<D<C, URNG> > > events =
                 getSim(iSim);
             for(Size iEvt=0; iEvt < events.size(); iEvt++)
                 // duck type on the members:
@@ -270,7 +377,8 @@ namespace QuantLib {
 
         std::vector<Probability> hitsByDate(basketSize, 0.);
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimulationEvents<simEvent<D<C, URNG> > > events =
+                getSim(iSim);
             std::map<unsigned short, unsigned short> namesDefaulting;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 // if event is within time horizon...
@@ -314,7 +422,8 @@ namespace QuantLib {
         Real expectedDefi = 0.;
         Real expectedDefj = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimulationEvents<simEvent<D<C, URNG> > > events =
+                getSim(iSim);
             Real imatch = 0., jmatch = 0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if((val > events[iEvt].dayFromRef) &&
@@ -355,10 +464,11 @@ namespace QuantLib {
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
-        // Real trancheLoss= 0.;
-        GeneralStatistics lossStats;
+        // no need to keep the samples for the mean and its error
+        IncrementalStatistics lossStats;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimulationEvents<simEvent<D<C, URNG> > > events =
+                getSim(iSim);
 
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
@@ -416,7 +526,8 @@ namespace QuantLib {
         Real detachAmount = basket_->detachmentAmount();
 
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimulationEvents<simEvent<D<C, URNG> > > events =
+                getSim(iSim);
 
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
@@ -456,10 +567,18 @@ namespace QuantLib {
         BigInteger val = d.serialNumber() - today.serialNumber();
         if(val <= 0) return 0.;// plus basket realized losses
 
-        //GenericRiskStatistics<GeneralStatistics> statsX;
-        std::vector<Real> losses;
+        // only the tail beyond the quantile is needed; the largest losses
+        //   are kept in a min-heap of bounded size rather than storing all
+        //   of them.
+        Real posit = std::ceil(percent * nSims_);
+        posit = posit >= 0. ? posit : 0.;
+        Size position = std::min(static_cast<Size>(posit), nSims_-1);
+        const Size tailSize = nSims_ - position;
+        std::vector<Real> tail;
+        tail.reserve(tailSize);
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimulationEvents<simEvent<D<C, URNG> > > events =
+                getSim(iSim);
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if(val > static_cast<BigInteger>(events[iEvt].dayFromRef)) {
@@ -475,22 +594,24 @@ namespace QuantLib {
             }
             portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
                 detachAmount - attachAmount);
-            losses.push_back(portfSimLoss);
+            if(tail.size() < tailSize) {
+                tail.push_back(portfSimLoss);
+                std::push_heap(tail.begin(), tail.end(), std::greater<Real>());
+            } else if(portfSimLoss > tail.front()) {
+                std::pop_heap(tail.begin(), tail.end(), std::greater<Real>());
+                tail.back() = portfSimLoss;
+                std::push_heap(tail.begin(), tail.end(), std::greater<Real>());
+            }
         }
 
-        std::sort(losses.begin(), losses.end());
-        Real posit = std::ceil(percent * nSims_);
-        posit = posit >= 0. ? posit : 0.;
-        Size position = static_cast<Size>(posit);
-        Real perctlInf = losses[position];//q_{\alpha}
+        Real perctlInf = tail.front();//q_{\alpha}
 
         // the prob of values strictly larger than the quantile value.
         Probability probOverQ =
-            static_cast<Real>(std::distance(losses.begin() + position,
-                losses.end())) / static_cast<Real>(nSims_);
+            static_cast<Real>(tailSize) / static_cast<Real>(nSims_);
 
         return ( perctlInf * (1.-percent-probOverQ) +//<-correction term
-            std::accumulate(losses.begin() + position, losses.end(), Real(0.))/nSims_
+            std::accumulate(tail.begin(), tail.end(), Real(0.))/nSims_
                 )/(1.-percent);
 
         /* Alternative ESF definition; find the first loss larger than the
@@ -550,7 +671,8 @@ namespace QuantLib {
         Date today = Settings::instance().evaluationDate();
         BigInteger val = d.serialNumber() - today.serialNumber();
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimulationEvents<simEvent<D<C, URNG> > > events =
+                getSim(iSim);
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if(val > static_cast<BigInteger>(events[iEvt].dayFromRef)) {
@@ -653,7 +775,8 @@ namespace QuantLib {
         BigInteger val = date.serialNumber() - today.serialNumber();
 
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimulationEvents<simEvent<D<C, URNG> > > events =
+                getSim(iSim);
             Real portfSimLoss=0.;
             //std::vector<Real> splitBuffer(numLiveNames_, 0.);
             std::vector<simEvent<D<C, URNG> > > splitEventsBuffer;
@@ -865,7 +988,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+            std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -875,6 +999,7 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const boost::shared_ptr<Pool>& pool = this->basket_->pool();
+            horizonDefaultPs_.clear();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
                 horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
                     defaultProbability(this->basket_->defaultKeys()[iName])
@@ -924,11 +1049,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const
     {
         const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-        // starts with no events
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
 
         for(Size iName=0; iName<copula_->size(); iName++) {
             Real latentVarSample =
@@ -956,8 +1080,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().push_back(defaultSimEvent(iName,
-                    dateSTride));
+                events.push_back(defaultSimEvent(iName, dateSTride));
                //emplace_back
             }
         /* Used to remove sims with no events. Uses less memory, faster
@@ -100,7 +100,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomLossLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+            std::vector<defaultSimEvent>& events) const;
 
         // see note on randomdefaultlatentmodel
         void initDates() const {
@@ -112,6 +113,7 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const boost::shared_ptr<Pool>& pool = this->basket_->pool();
+            horizonDefaultPs_.clear();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
                 horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
                     defaultProbability(this->basket_->defaultKeys()[iName])
@@ -153,10 +155,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomLossLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const 
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const 
     {
         const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
 
         // half the model is defaults, the other half are RRs...
         for(Size iName=0; iName<copula_->size()/2; iName++) {
@@ -210,7 +212,7 @@ namespace QuantLib {
                 Real recovery = 
                     copula_->conditionalRecovery(latentRRVarSample,
                         iName, eventDate);
-                this->simsBuffer_.back().push_back(
+                events.push_back(
                   defaultSimEvent(iName, dateSTride, recovery));
                 //emplace_back
             }
@@ -219,10 +221,6 @@ namespace QuantLib {
         default probability, otherwise is more expensive and sim access has 
         to be modified. However low probability is also an indicator that 
         variance reduction is needed. */
-        //if(simsBuffer.back().empty()) {
-        //    emptySims_++;// Size; intilzd to zero
-        //    simsBuffer.pop_back();
-        //}
         }
     }
 
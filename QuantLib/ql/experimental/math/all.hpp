@@ -8,6 +8,7 @@
 #include <ql/experimental/math/frankcopularng.hpp>
 #include <ql/experimental/math/gaussiancopulapolicy.hpp>
 #include <ql/experimental/math/latentmodel.hpp>
+#include <ql/experimental/math/multidimgridintegrator.hpp>
 #include <ql/experimental/math/multidimintegrator.hpp>
 #include <ql/experimental/math/multidimquadrature.hpp>
 #include <ql/experimental/math/numericaldifferentiation.hpp>
@@ -22,6 +22,7 @@
 
 #include <ql/experimental/math/multidimquadrature.hpp>
 #include <ql/experimental/math/multidimintegrator.hpp>
+#include <ql/experimental/math/multidimgridintegrator.hpp>
 #include <ql/math/integrals/trapezoidintegral.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 // for template spezs
@@ -45,6 +46,37 @@
 namespace QuantLib {
 
     namespace detail {
+        /* Seed of the independent stream used by the samplers that can not
+        skip ahead for the samples from the n-th on. A null seed (a random
+        one) is kept as such. */
+        inline BigNatural streamSeed(BigNatural seed, unsigned long n) {
+            if(seed == 0 || n == 0) return seed;
+            // 32 bits integer hash
+            unsigned long h = (seed ^ (n * 0x9E3779B9UL)) & 0xffffffffUL;
+            h = (h ^ 61) ^ (h >> 16);
+            h = (h * 9) & 0xffffffffUL;
+            h = h ^ (h >> 4);
+            h = (h * 0x27d4eb2dUL) & 0xffffffffUL;
+            h = h ^ (h >> 15);
+            return h == 0 ? 1 : h;
+        }
+
+        /* Positions a sequence generator on its n-th sample. Generators
+        able to skip ahead (e.g. SobolRsg) do so; pseudo-random ones are
+        restarted on the independent stream given by streamSeed. */
+        template <class USNG>
+        inline void skipSequenceTo(USNG& generator, BigNatural,
+                                   unsigned long n) {
+            generator.skipTo(n);
+        }
+
+        template <class URNG>
+        inline void skipSequenceTo(RandomSequenceGenerator<URNG>& generator,
+                                   BigNatural seed, unsigned long n) {
+            generator = RandomSequenceGenerator<URNG>(generator.dimension(),
+                URNG(streamSeed(seed, n)));
+        }
+
         // havent figured out how to do this in-place
         struct multiplyV {
             typedef Disposable<std::vector<Real> > result_type;
@@ -56,6 +88,39 @@ namespace QuantLib {
                 return v;
             }
         };
+
+        // evaluates an integrand taking a set of nodes on a single one
+        inline Real evaluateOnNode(
+            const boost::function<Disposable<std::vector<Real> > (
+                const std::vector<std::vector<Real> >&)>& f,
+            const std::vector<Real>& x) {
+            std::vector<std::vector<Real> > nodes(1, x);
+            return f(nodes)[0];
+        }
+
+        // multiplies the values of an integrand taking a set of nodes by
+        //   the density at each of them
+        template <class Copula>
+        class densityWeightedBatch {
+          public:
+            typedef Disposable<std::vector<Real> > result_type;
+            explicit densityWeightedBatch(const Copula& copula)
+            : copula_(copula) {}
+            Disposable<std::vector<Real> > operator()(
+                const boost::function<Disposable<std::vector<Real> > (
+                    const std::vector<std::vector<Real> >&)>& f,
+                const std::vector<std::vector<Real> >& nodes) const {
+                std::vector<Real> values = f(nodes);
+                QL_REQUIRE(values.size() == nodes.size(),
+                    "integrand returned " << values.size() <<
+                    " values for " << nodes.size() << " nodes");
+                for(Size i=0; i<values.size(); i++)
+                    values[i] *= copula_.density(nodes[i]);
+                return values;
+            }
+          private:
+            const Copula& copula_;
+        };
     }
 
     //! \name Latent model direct integration facility.
@@ -88,6 +153,18 @@ namespace QuantLib {
             const std::vector<Real>& arg)>& f) const {
             QL_FAIL("No vector integration provided");
         }
+        // integral of a scalar function evaluated on a set of nodes at once
+        /* The function returns its values at each of the nodes it is given,
+        in the same order. Integrators working on a precomputed grid pass all
+        of their nodes in a single call, so that the integrand can share the
+        work common to all of them; the others call it on one node at a
+        time. */
+        virtual Real integrateBatch(
+            const boost::function<Disposable<std::vector<Real> > (
+            const std::vector<std::vector<Real> >& args)>& f) const {
+            return integrate(
+                boost::bind(&detail::evaluateOnNode, boost::cref(f), _1));
+        }
         virtual ~LMIntegration() {}
     };
 
@@ -107,7 +184,9 @@ namespace QuantLib {
         typedef 
         enum LatentModelIntegrationType {
             GaussianQuadrature,
-            Trapezoid
+            Trapezoid,
+            GaussianTensorGrid,
+            GaussianSparseGrid
             // etc....
         } LatentModelIntegrationType;
     }
@@ -133,6 +212,28 @@ namespace QuantLib {
         virtual ~IntegrationBase() {}
     };
 
+    template<> class IntegrationBase<GaussHermiteGridIntegrator> : 
+    public GaussHermiteGridIntegrator, public LMIntegration {
+    public:
+        IntegrationBase(Size dimension, Size order, GridType grid) 
+        : GaussHermiteGridIntegrator(dimension, order, grid) {}
+        Real integrate(const boost::function<Real (
+            const std::vector<Real>& arg)>& f) const {
+                return GaussHermiteGridIntegrator::operator()(f);
+        }
+        Disposable<std::vector<Real> > integrateV(
+            const boost::function<Disposable<std::vector<Real> >  (
+                const std::vector<Real>& arg)>& f) const {
+                return GaussHermiteGridIntegrator::integrateV(f);
+        }
+        Real integrateBatch(
+            const boost::function<Disposable<std::vector<Real> > (
+                const std::vector<std::vector<Real> >& args)>& f) const {
+                return GaussHermiteGridIntegrator::integrateBatch(f);
+        }
+        virtual ~IntegrationBase() {}
+    };
+
     template<> class IntegrationBase<MultidimIntegral> : 
         public MultidimIntegral, public LMIntegration {
     public:
@@ -415,7 +516,7 @@ namespace QuantLib {
                 BigNatural seed = 0) 
             : sequenceGen_(copula.numFactors(), seed), // base case construction
               x_(std::vector<Real>(copula.numFactors()), 1.0),
-              copula_(copula) { }
+              copula_(copula), seed_(seed) { }
             /*! Returns a sample of the factor set \f$ M_k\,Z_i\f$. 
             This method has the vocation of being specialized at particular 
             types of the copula with a more efficient inversion to generate the 
@@ -434,11 +535,21 @@ namespace QuantLib {
                 x_.value = copula_.allFactorCumulInverter(sample.value);
                 return x_;
             }
+            /*! Positions the sampler, which must not have been drawn from
+            yet, on the n-th sample of its sequence. Sequence generators
+            providing a skipTo method, as SobolRsg does, skip ahead; a
+            RandomSequenceGenerator starts instead an independent stream,
+            seeded from the original seed and the position.
+            */
+            void skipTo(unsigned long n) {
+                detail::skipSequenceTo(sequenceGen_, seed_, n);
+            }
         private:
             USNG sequenceGen_;// copy, we might be mutithreaded
             mutable sample_type x_;
             // no copies
             const copulaType& copula_;
+            BigNatural seed_;
         };
         //@}
     protected:
@@ -485,6 +596,24 @@ namespace QuantLib {
                                (integrals, -35., 35.);
                         break;
                         }
+                    /* Grid integrations evaluate the integrand on all the
+                    nodes at once (in parallel when OpenMP is enabled), the
+                    sparse one is meant for models with three or more
+                    factors. */
+                    case LatentModelIntegrationType::GaussianTensorGrid:
+                        return 
+                            boost::make_shared<
+                            IntegrationBase<GaussHermiteGridIntegrator> >(
+                                dimension, 25, 
+                                GaussHermiteGridIntegrator::TensorProduct);
+                        break;
+                    case LatentModelIntegrationType::GaussianSparseGrid:
+                        return 
+                            boost::make_shared<
+                            IntegrationBase<GaussHermiteGridIntegrator> >(
+                                dimension, 25, 
+                                GaussHermiteGridIntegrator::Sparse);
+                        break;
                     default:
                         QL_FAIL("Unknown latent model integration type.");
                 }
@@ -599,6 +728,19 @@ namespace QuantLib {
                         boost::bind(&copulaPolicyImpl::density, copula_, _1),
                         boost::bind(boost::cref(f), _1)));
         }
+        /*! Integrates over the density domain a scalar function evaluated on
+         a set of nodes at once (see LMIntegration::integrateBatch.)
+        */
+        Real integratedExpectedValueBatch(
+            const boost::function<Disposable<std::vector<Real> >(
+                const std::vector<std::vector<Real> >& v1)>& f) const {
+            return
+                integration()->integrateBatch(
+                    boost::bind<Disposable<std::vector<Real> > >(
+                        detail::densityWeightedBatch<copulaPolicyImpl>(
+                            copula_),
+                        boost::cref(f), _1));
+        }
     protected:
         // Integrable models must provide their integrator.
         // Arguable, not having the integration in the LM class saves that 
@@ -738,7 +880,9 @@ namespace QuantLib {
     */
     /*! \brief  Specialization for direct Gaussian Box-Muller generation.\par
     The implementation of Box-Muller in the library is the rejection variant so
-    do not use it within a multithreaded simulation.
+    it can not skip ahead; skipTo starts instead an independent stream, seeded
+    from the original seed and the position, for the samples from the given
+    one on.
     */
     template<class TC> template<class URNG, bool dummy>
     class LatentModel<TC>
@@ -750,17 +894,23 @@ namespace QuantLib {
         explicit FactorSampler(const GaussianCopulaPolicy& copula,
                                BigNatural seed = 0) 
         : boxMullRng_(copula.numFactors(), 
-            BoxMullerGaussianRng<URNG>(URNG(seed))){ }
+            BoxMullerGaussianRng<URNG>(URNG(seed))), seed_(seed) { }
         const sample_type& nextSequence() const {
                 return boxMullRng_.nextSequence();
         }
+        void skipTo(unsigned long n) {
+            boxMullRng_ = RandomSequenceGenerator<BoxMullerGaussianRng<URNG> >(
+                boxMullRng_.dimension(), BoxMullerGaussianRng<URNG>(
+                    URNG(detail::streamSeed(seed_, n))));
+        }
     private:
         RandomSequenceGenerator<BoxMullerGaussianRng<URNG> > boxMullRng_;
+        BigNatural seed_;
     };
 
     /*! \brief Specialization for direct T samples generation.\par
-    The PolarT is a rejection algorithm so do not use it within a 
-    multithreaded simulation.
+    The PolarT is a rejection algorithm so it can not skip ahead; as for the
+    Box-Muller specialization, skipTo starts an independent stream instead.
     The RandomSequenceGenerator class does not admit heterogeneous 
     distribution samples so theres a trick here since the template parameter is 
     not what it is used internally.
@@ -773,12 +923,19 @@ namespace QuantLib {
         typedef Sample<std::vector<Real> > sample_type;
         explicit FactorSampler(const TCopulaPolicy& copula, BigNatural seed = 0)
         : sequence_(std::vector<Real> (copula.numFactors()), 1.0),
-          urng_(seed) {
+          urng_(seed), seed_(seed) {
             // 1 == urng.dimension() is enforced by the sample type
             const std::vector<Real>& varF = copula.varianceFactors();
-            for(Size i=0; i<varF.size(); i++)// ...use back inserter lambda
+            for(Size i=0; i<varF.size(); i++) {
+                degreesOfFreedom_.push_back(2./(1.-varF[i]*varF[i]));
                 trng_.push_back(
-                    PolarStudentTRng<URNG>(2./(1.-varF[i]*varF[i]), urng_));
+                    PolarStudentTRng<URNG>(degreesOfFreedom_.back(), urng_));
+            }
+        }
+        void skipTo(unsigned long n) {
+            urng_ = URNG(detail::streamSeed(seed_, n));
+            for(Size i=0; i<trng_.size(); i++)
+                trng_[i] = PolarStudentTRng<URNG>(degreesOfFreedom_[i], urng_);
         }
         const sample_type& nextSequence() const {
             Size i=0;
@@ -792,6 +949,8 @@ namespace QuantLib {
         mutable sample_type sequence_;
         URNG urng_;
         mutable std::vector<PolarStudentTRng<URNG> > trng_;
+        BigNatural seed_;
+        std::vector<Real> degreesOfFreedom_;
     };
 
 
@@ -0,0 +1,294 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/math/multidimgridintegrator.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
+#include <map>
+#include <string>
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    namespace {
+
+        #ifdef _OPENMP
+        Size numberOfBlocks(Size n) {
+            return std::max<Size>(std::min<Size>(omp_get_max_threads(), n), 1);
+        }
+        #else
+        Size numberOfBlocks(Size) {
+            return 1;
+        }
+        #endif
+
+        Real binomialCoefficient(Size n, Size k) {
+            Real result = 1.0;
+            for (Size i=1; i<=k; ++i)
+                result *= Real(n-k+i)/Real(i);
+            return result;
+        }
+
+        // enumerates the multi-indices with entries in [1, maxLevel] and
+        // total within [minSum, maxSum]
+        void sparseLevels(Size dimension, Size maxLevel,
+                          Size minSum, Size maxSum,
+                          std::vector<Size>& current,
+                          std::vector<std::vector<Size> >& result) {
+            Size used = 0;
+            for (Size i=0; i<current.size(); ++i)
+                used += current[i];
+            Size remaining = dimension - current.size();
+            if (remaining == 0) {
+                if (used >= minSum && used <= maxSum)
+                    result.push_back(current);
+                return;
+            }
+            // every remaining entry takes at least one level
+            for (Size l=1; l<=maxLevel && used+l+remaining-1<=maxSum; ++l) {
+                current.push_back(l);
+                sparseLevels(dimension, maxLevel, minSum, maxSum,
+                             current, result);
+                current.pop_back();
+            }
+        }
+
+    }
+
+    GaussHermiteGridIntegrator::GaussHermiteGridIntegrator(Size dimension,
+                                                           Size order,
+                                                           GridType grid)
+    : dimension_(dimension) {
+        QL_REQUIRE(dimension > 0, "null dimension");
+        QL_REQUIRE(order > 0, "null quadrature order");
+        switch (grid) {
+          case TensorProduct:
+            buildTensorGrid(order);
+            break;
+          case Sparse:
+            buildSparseGrid(order);
+            break;
+          default:
+            QL_FAIL("unknown grid type");
+        }
+    }
+
+    void GaussHermiteGridIntegrator::buildTensorGrid(Size order) {
+        GaussHermiteIntegration rule(order);
+        const Array& x = rule.x();
+        const Array& w = rule.weights();
+
+        std::vector<Size> index(dimension_, 0);
+        std::vector<Real> node(dimension_);
+        for (;;) {
+            Real weight = 1.0;
+            for (Size i=0; i<dimension_; ++i) {
+                node[i] = x[index[i]];
+                weight *= w[index[i]];
+            }
+            nodes_.push_back(node);
+            weights_.push_back(weight);
+            // odometer increment
+            Size i = 0;
+            while (i<dimension_ && ++index[i] == order)
+                index[i++] = 0;
+            if (i == dimension_)
+                break;
+        }
+    }
+
+    void GaussHermiteGridIntegrator::buildSparseGrid(Size order) {
+        QL_REQUIRE(order % 2 == 1,
+                   "sparse grids need an odd finest order, " << order
+                   << " given");
+        // level l uses the rule with 2l-1 points
+        const Size levels = (order+1)/2;
+        std::vector<Array> x(levels), w(levels);
+        for (Size l=0; l<levels; ++l) {
+            GaussHermiteIntegration rule(2*l+1);
+            x[l] = rule.x();
+            w[l] = rule.weights();
+            // the centre node is shared by all the rules
+            for (Size j=0; j<x[l].size(); ++j)
+                if (std::fabs(x[l][j]) < 1.0e-12)
+                    x[l][j] = 0.0;
+        }
+
+        // Smolyak combination technique:
+        //   A(q,d) = sum_{q-d+1 <= |l| <= q} (-1)^{q-|l|}
+        //                C(d-1, q-|l|) U^{l_1} x ... x U^{l_d}
+        const Size d = dimension_;
+        const Size q = d + levels - 1;
+        std::vector<std::vector<Size> > multiIndices;
+        std::vector<Size> current;
+        sparseLevels(d, levels, std::max(d, q+1-d), q,
+                     current, multiIndices);
+
+        std::map<std::vector<Real>, Real> grid;
+        std::vector<Real> node(d);
+        for (Size m=0; m<multiIndices.size(); ++m) {
+            const std::vector<Size>& l = multiIndices[m];
+            Size total = 0;
+            for (Size i=0; i<d; ++i)
+                total += l[i];
+            Real coefficient = binomialCoefficient(d-1, q-total);
+            if ((q-total) % 2 == 1)
+                coefficient = -coefficient;
+
+            std::vector<Size> index(d, 0);
+            for (;;) {
+                Real weight = coefficient;
+                for (Size i=0; i<d; ++i) {
+                    node[i] = x[l[i]-1][index[i]];
+                    weight *= w[l[i]-1][index[i]];
+                }
+                grid[node] += weight;
+                Size i = 0;
+                while (i<d && ++index[i] == x[l[i]-1].size())
+                    index[i++] = 0;
+                if (i == d)
+                    break;
+            }
+        }
+
+        nodes_.reserve(grid.size());
+        weights_.reserve(grid.size());
+        for (std::map<std::vector<Real>, Real>::const_iterator i =
+                 grid.begin(); i != grid.end(); ++i) {
+            // nodes whose contributions cancel out are dropped
+            if (i->second == 0.0)
+                continue;
+            nodes_.push_back(i->first);
+            weights_.push_back(i->second);
+        }
+    }
+
+    Real GaussHermiteGridIntegrator::operator()(
+            const boost::function<Real (const std::vector<Real>&)>& f) const {
+        const Size n = size();
+        const Size nBlocks = numberOfBlocks(n);
+        std::vector<Real> partial(nBlocks, 0.0);
+        std::vector<std::string> errors(nBlocks);
+        const long nBlocksL = static_cast<long>(nBlocks);
+        #pragma omp parallel for schedule(static, 1)
+        for (long b=0; b<nBlocksL; ++b) {
+            // exceptions can not leave the parallel region
+            try {
+                Real sum = 0.0;
+                for (Size i=n*b/nBlocks; i<n*(b+1)/nBlocks; ++i)
+                    sum += weights_[i] * f(nodes_[i]);
+                partial[b] = sum;
+            } catch (std::exception& e) {
+                errors[b] = e.what();
+            }
+        }
+        Real sum = 0.0;
+        for (Size b=0; b<nBlocks; ++b) {
+            QL_REQUIRE(errors[b].empty(), errors[b]);
+            sum += partial[b];
+        }
+        return sum;
+    }
+
+    Disposable<std::vector<Real> > GaussHermiteGridIntegrator::integrateV(
+            const boost::function<Disposable<std::vector<Real> > (
+                const std::vector<Real>&)>& f) const {
+        const Size n = size();
+        const Size nBlocks = numberOfBlocks(n);
+        std::vector<std::vector<Real> > partial(nBlocks);
+        std::vector<std::string> errors(nBlocks);
+        const long nBlocksL = static_cast<long>(nBlocks);
+        #pragma omp parallel for schedule(static, 1)
+        for (long b=0; b<nBlocksL; ++b) {
+            try {
+                std::vector<Real>& sum = partial[b];
+                for (Size i=n*b/nBlocks; i<n*(b+1)/nBlocks; ++i) {
+                    std::vector<Real> term = f(nodes_[i]);
+                    if (sum.empty())
+                        sum.resize(term.size(), 0.0);
+                    QL_REQUIRE(term.size() == sum.size(),
+                               "integrand returned " << term.size()
+                               << " values instead of " << sum.size());
+                    for (Size j=0; j<term.size(); ++j)
+                        sum[j] += weights_[i] * term[j];
+                }
+            } catch (std::exception& e) {
+                errors[b] = e.what();
+            }
+        }
+        std::vector<Real> result;
+        for (Size b=0; b<nBlocks; ++b) {
+            QL_REQUIRE(errors[b].empty(), errors[b]);
+            if (partial[b].empty())
+                continue;
+            if (result.empty()) {
+                result.swap(partial[b]);
+            } else {
+                QL_REQUIRE(result.size() == partial[b].size(),
+                           "inconsistent integrand sizes");
+                for (Size j=0; j<result.size(); ++j)
+                    result[j] += partial[b][j];
+            }
+        }
+        return result;
+    }
+
+    Real GaussHermiteGridIntegrator::integrateBatch(
+            const boost::function<Disposable<std::vector<Real> > (
+                const std::vector<std::vector<Real> >&)>& f) const {
+        const Size n = size();
+        const Size nBlocks = numberOfBlocks(n);
+        if (nBlocks == 1)
+            return sum(f(nodes_), 0, n);
+
+        std::vector<Real> partial(nBlocks, 0.0);
+        std::vector<std::string> errors(nBlocks);
+        const long nBlocksL = static_cast<long>(nBlocks);
+        #pragma omp parallel for schedule(static, 1)
+        for (long b=0; b<nBlocksL; ++b) {
+            try {
+                const Size first = n*b/nBlocks, last = n*(b+1)/nBlocks;
+                std::vector<std::vector<Real> > nodes(nodes_.begin()+first,
+                                                      nodes_.begin()+last);
+                partial[b] = sum(f(nodes), first, last);
+            } catch (std::exception& e) {
+                errors[b] = e.what();
+            }
+        }
+        Real result = 0.0;
+        for (Size b=0; b<nBlocks; ++b) {
+            QL_REQUIRE(errors[b].empty(), errors[b]);
+            result += partial[b];
+        }
+        return result;
+    }
+
+    Real GaussHermiteGridIntegrator::sum(const std::vector<Real>& values,
+                                         Size first, Size last) const {
+        QL_REQUIRE(values.size() == last-first,
+                   "integrand returned " << values.size()
+                   << " values for " << last-first << " nodes");
+        Real result = 0.0;
+        for (Size i=0; i<values.size(); ++i)
+            result += weights_[first+i] * values[i];
+        return result;
+    }
+
+}
@@ -0,0 +1,113 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multidimgridintegrator.hpp
+    \brief Gauss-Hermite quadrature on precomputed multidimensional grids
+*/
+
+#ifndef quantlib_math_multidimgridintegrator_hpp
+#define quantlib_math_multidimgridintegrator_hpp
+
+#include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <ql/utilities/disposable.hpp>
+#include <boost/function.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    /*! \brief Integrates a scalar or vector function over \f$ R^n \f$ on a
+        precomputed grid of Gauss-Hermite nodes.
+
+        Unlike GaussianQuadMultidimIntegrator, which recurses along the
+        dimensions calling the integrand through nested function objects,
+        the nodes and weights of the whole grid are built once at
+        construction and the integral is a single weighted sum. This allows
+        the integrand to be evaluated on many nodes in one call (see
+        integrateBatch) and the nodes to be evaluated in parallel when the
+        library is built with OpenMP support; integrands must then be safe
+        to be called concurrently.
+
+        Two grids are available:
+        - TensorProduct: the full product of the one dimensional rule of the
+          given order, with \f$ order^n \f$ nodes.
+        - Sparse: a Smolyak combination of tensor products of one
+          dimensional rules with 1, 3, 5,... up to order points. The number
+          of nodes grows polynomially rather than exponentially with the
+          dimension, which makes models with three or more factors
+          practical as long as the integrand is well approximated by a
+          polynomial times the Hermite weight function. Coinciding nodes are
+          merged and some weights are negative.
+
+        As for the Gauss-Hermite integrator the weights include the inverse
+        of the Hermite weight function, so the integrand is the full function
+        to be integrated over the real domain.
+
+        \test the tensor and sparse grids are checked against the analytic
+              moments of multivariate normal densities.
+    */
+    class GaussHermiteGridIntegrator {
+      public:
+        enum GridType { TensorProduct, Sparse };
+        /*!
+            @param dimension Integration variable dimension.
+            @param order Number of points in the one dimensional rule; in the
+                   sparse grid the finest rule used, it must be odd then.
+            @param grid Grid construction.
+        */
+        GaussHermiteGridIntegrator(Size dimension,
+                                   Size order,
+                                   GridType grid = TensorProduct);
+
+        Size dimension() const { return dimension_; }
+        //! Number of nodes in the grid.
+        Size size() const { return weights_.size(); }
+        const std::vector<std::vector<Real> >& nodes() const {
+            return nodes_;
+        }
+        const std::vector<Real>& weights() const { return weights_; }
+
+        //! Integrates a scalar function evaluated node by node.
+        Real operator()(
+            const boost::function<Real (const std::vector<Real>&)>& f) const;
+        //! Integrates a vector function evaluated node by node.
+        Disposable<std::vector<Real> > integrateV(
+            const boost::function<Disposable<std::vector<Real> > (
+                const std::vector<Real>&)>& f) const;
+        /*! Integrates a scalar function evaluated on sets of nodes; the
+            function receives the nodes and returns the values at each of
+            them in the same order.  The whole grid is passed in one call,
+            or, when the library is built with OpenMP support, one
+            contiguous block of nodes per thread.
+        */
+        Real integrateBatch(
+            const boost::function<Disposable<std::vector<Real> > (
+                const std::vector<std::vector<Real> >&)>& f) const;
+      private:
+        void buildTensorGrid(Size order);
+        void buildSparseGrid(Size order);
+        Real sum(const std::vector<Real>& values,
+                 Size first, Size last) const;
+
+        Size dimension_;
+        std::vector<std::vector<Real> > nodes_;
+        std::vector<Real> weights_;
+    };
+
+}
+
+#endif
@@ -56,6 +56,11 @@ namespace QuantLib {
         sample_type next() const {
             return sample_type(nextGaussian(),1.0);
         }
+        //! writes the next \f$ n \f$ deviates into the buffer
+        void fill(Real* output, Size n) const {
+            for (Size i=0; i<n; ++i)
+                output[i] = nextGaussian();
+        }
       private:
         mutable MersenneTwisterUniformRng mt32_;
         Real nextGaussian() const;
@@ -18,7 +18,8 @@
 */
 
 #include <ql/experimental/risk/creditriskplus.hpp>
-#include <map>
+#include <ql/math/fastfouriertransform.hpp>
+#include <complex>
 
 using std::sqrt;
 
@@ -57,24 +58,62 @@ namespace QuantLib {
                        << relativeDefaultVariance_.size() << ")"
                        << " must be equal to number of sectors (" << n_ << ")");
 
+        QL_REQUIRE(unit_ > 0.0, "loss unit (" << unit_ << ") must be positive");
+
         exposureSum_ = 0.0;
         el_ = 0.0;
         el2_ = 0.0;
+        pdSum_ = 0.0;
+        upperIndex_ = 0;
+        sectorExposure_ = std::vector<Real>(n_, 0.0);
+        sectorEl_ = std::vector<Real>(n_, 0.0);
+        sectorEl2_ = std::vector<Real>(n_, 0.0);
+        exUnit_ = std::vector<unsigned long>(m_, 0);
+        pdAdj_ = std::vector<Real>(m_, 0.0);
+        bandSize_ = std::vector<Size>(1, 0);
+        bandPd_ = std::vector<Real>(1, 0.0);
+
         for (Size i = 0; i < m_; ++i) {
-            QL_REQUIRE(exposure_[i] >= 0.0, "exposure #"
-                                                << i << " is negative ("
-                                                << exposure_[i] << ")");
-            QL_REQUIRE(pd_[i] > 0.0, "pd #" << i << " is negative (" << pd_[i]
-                                            << ")");
-            QL_REQUIRE(sector_[i] < n_, "sector #" << i << " (" << sector_[i]
-                                                   << ") is out of range 0..."
-                                                   << (n_ - 1));
-            exposureSum_ += exposure_[i];
-            el_ += pd_[i] * exposure_[i];
-            el2_ += pd_[i] * exposure_[i]*exposure_[i];
+            checkObligor(i, exposure_[i], pd_[i]);
+            addObligor(i, 1.0);
         }
 
-        QL_REQUIRE(unit_ > 0.0, "loss unit (" << unit_ << ") must be positive");
+        compute();
+    }
+
+    void CreditRiskPlus::updateExposures(
+        const std::vector<Size> &obligor,
+        const std::vector<Real> &exposure,
+        const std::vector<Real> &defaultProbability) {
+
+        QL_REQUIRE(obligor.size() == exposure.size(),
+                   "number of obligors ("
+                       << obligor.size()
+                       << ") must be equal to number of exposures ("
+                       << exposure.size() << ")");
+        QL_REQUIRE(obligor.size() == defaultProbability.size(),
+                   "number of obligors ("
+                       << obligor.size()
+                       << ") must be equal to number of pds ("
+                       << defaultProbability.size() << ")");
+
+        // validate all of the input before touching the aggregates, so
+        // that a rejected update leaves the model unchanged
+        for (Size k = 0; k < obligor.size(); ++k) {
+            Size i = obligor[k];
+            QL_REQUIRE(i < m_, "obligor #" << k << " (" << i
+                                           << ") is out of range 0..."
+                                           << (m_ - 1));
+            checkObligor(i, exposure[k], defaultProbability[k]);
+        }
+
+        for (Size k = 0; k < obligor.size(); ++k) {
+            Size i = obligor[k];
+            addObligor(i, -1.0);
+            exposure_[i] = exposure[k];
+            pd_[i] = defaultProbability[k];
+            addObligor(i, 1.0);
+        }
 
         compute();
     }
@@ -99,108 +138,115 @@ namespace QuantLib {
         return l1 + (p - p1) / (p2 - p1) * (l2 - l1);
     }
 
-    void CreditRiskPlus::compute() {
-
-        std::vector<Real> sectorPdSum_, sectorSpecTerms_;
-
-        sectorPdSum_ = std::vector<Real>(n_, 0.0);
-        sectorExposure_ = std::vector<Real>(n_, 0.0);
-        sectorEl_ = std::vector<Real>(n_, 0.0);
-        sectorSpecTerms_ = std::vector<Real>(n_, 0.0);
-        sectorUl_ = std::vector<Real>(n_, 0.0);
-        marginalLoss_ = std::vector<Real>(m_, 0.0);
-
-        std::vector<Real> pdAdj(m_, 0.0);
-
-        // compute exposure bands
-
-        unsigned long maxNu_ = 0;
-        upperIndex_ = 0;
+    void CreditRiskPlus::checkObligor(Size i, Real exposure,
+                                      Real pd) const {
+        QL_REQUIRE(exposure >= 0.0, "exposure #"
+                                        << i << " is negative ("
+                                        << exposure << ")");
+        QL_REQUIRE(pd > 0.0, "pd #" << i << " is negative (" << pd
+                                    << ")");
+        QL_REQUIRE(sector_[i] < n_, "sector #" << i << " (" << sector_[i]
+                                               << ") is out of range 0..."
+                                               << (n_ - 1));
+    }
 
-        // map of nuC_ to expected loss
-        std::map<unsigned long, Real, std::less<unsigned long> > epsNuC_;
+    void CreditRiskPlus::addObligor(Size i, Real sign) {
 
-        std::map<unsigned long, Real, std::less<unsigned long> >::iterator iter;
+        const Real e = exposure_[i], pd = pd_[i];
 
-        for (Size k = 0; k < m_; ++k) {
-            unsigned long exUnit = (unsigned long)(std::floor(0.5 + exposure_[k] / unit_)); // round
-            if (exposure_[k] > 0 && exUnit == 0)
+        if (sign > 0.0) {
+            // compute exposure band
+            unsigned long exUnit =
+                (unsigned long)(std::floor(0.5 + e / unit_)); // round
+            if (e > 0 && exUnit == 0)
                 exUnit = 1; // but avoid zero exposure
-            if (exUnit > maxNu_)
-                maxNu_ = exUnit;
-            pdAdj[k] = exposure_[k] > 0.0
-                           ? exposure_[k] * pd_[k] / (exUnit * unit_)
-                           : 0.0; // adjusted pd
-            Real el = exUnit * pdAdj[k];
-            if (exUnit > 0) {
-                iter = epsNuC_.find(exUnit);
-                if (iter == epsNuC_.end()) {
-                    epsNuC_.insert(std::pair<unsigned long, Real>(exUnit, el));
-                } else {
-                    (*iter).second += el;
-                }
+            exUnit_[i] = exUnit;
+            pdAdj_[i] = e > 0.0 ? e * pd / (exUnit * unit_)
+                                : 0.0; // adjusted pd
+        }
+
+        const unsigned long exUnit = exUnit_[i];
+        if (exUnit > 0) {
+            if (exUnit >= bandSize_.size()) {
+                bandSize_.resize(exUnit + 1, 0);
+                bandPd_.resize(exUnit + 1, 0.0);
+            }
+            if (sign > 0.0) {
+                ++bandSize_[exUnit];
+                bandPd_[exUnit] += pdAdj_[i];
                 upperIndex_ += exUnit;
+            } else {
+                // empty bands are reset to avoid accumulating round-off
+                if (--bandSize_[exUnit] == 0)
+                    bandPd_[exUnit] = 0.0;
+                else
+                    bandPd_[exUnit] -= pdAdj_[i];
+                upperIndex_ -= exUnit;
             }
         }
 
-        // compute per sector figures
+        exposureSum_ += sign * e;
+        el_ += sign * pd * e;
+        el2_ += sign * pd * e * e;
+        pdSum_ += sign * pdAdj_[i];
+        sectorExposure_[sector_[i]] += sign * e;
+        sectorEl_[sector_[i]] += sign * pd * e;
+        sectorEl2_[sector_[i]] += sign * pd * e * e;
+    }
 
-        Real pdSum_ = 0;
-        for (Size k = 0; k < m_; ++k) {
-            pdSum_ += pdAdj[k];
-            sectorPdSum_[sector_[k]] += pd_[k];
-            sectorExposure_[sector_[k]] += exposure_[k];
-            sectorEl_[sector_[k]] += exposure_[k] * pd_[k];
+    void CreditRiskPlus::compute() {
+
+        // remove bands emptied by updates
+        while (bandSize_.size() > 1 && bandSize_.back() == 0) {
+            bandSize_.pop_back();
+            bandPd_.pop_back();
         }
 
-        for (Size i = 0; i < n_; ++i) {
+        const long n = static_cast<long>(n_), m = static_cast<long>(m_);
+        std::vector<Real> sectorSpecTerms(n_, 0.0), sectorUlTerms(n_, 0.0);
+        sectorUl_ = std::vector<Real>(n_, 0.0);
+        marginalLoss_ = std::vector<Real>(m_, 0.0);
+
+        #pragma omp parallel for
+        for (long i = 0; i < n; ++i) {
 
             // precompute sector specific terms (formula 15 in [1])
 
-            sectorSpecTerms_[i] += relativeDefaultVariance_[i] * sectorEl_[i];
+            Real specTerm = relativeDefaultVariance_[i] * sectorEl_[i];
             for (Size j = 0; j < n_; ++j) {
-                if (j != i) {
-                    sectorSpecTerms_[i] +=
+                if (j != Size(i)) {
+                    specTerm +=
                         correlation_[i][j] *
                         std::sqrt(relativeDefaultVariance_[i] *
                                   relativeDefaultVariance_[j]) *
                         sectorEl_[j];
                 }
             }
-        }
+            sectorSpecTerms[i] = specTerm;
 
-        // compute synthetic standard deviation (formula 12 in [1])
+            // contribution to the synthetic standard deviation
+            // (formula 12 in [1])
 
-        ul_ = 0.0;
-        for (Size i = 0; i < n_; ++i) {
             sectorUl_[i] =
                 relativeDefaultVariance_[i] * sectorEl_[i] * sectorEl_[i];
-            ul_ += sectorUl_[i];
-            for (Size j = 0; j < n_; ++j) {
-                if (j != i) {
-                    ul_ += correlation_[i][j] *
-                           std::sqrt(relativeDefaultVariance_[i] *
-                                     relativeDefaultVariance_[j]) *
-                           sectorEl_[i] * sectorEl_[j];
-                }
-            }
+            sectorUlTerms[i] = sectorEl_[i] * specTerm;
         }
 
+        ul_ = 0.0;
+        for (Size i = 0; i < n_; ++i)
+            ul_ += sectorUlTerms[i];
+
         Real matchUl_ = ul_; // formula 13 in [1], rhs
-        for (Size k = 0; k < m_; ++k) {
-            Real tmp = pd_[k] * exposure_[k] * exposure_[k];
-            sectorUl_[sector_[k]] += tmp;
-            ul_ += tmp;
-        }
-        ul_ = std::sqrt(ul_);
+        ul_ = std::sqrt(ul_ + el2_);
         for (Size i = 0; i < n_; ++i)
-            sectorUl_[i] = std::sqrt(sectorUl_[i]);
+            sectorUl_[i] = std::sqrt(sectorUl_[i] + sectorEl2_[i]);
 
         // compute risk contributions (formula 15 in [1])
 
-        for (Size k = 0; k < m_; ++k) {
+        #pragma omp parallel for
+        for (long k = 0; k < m; ++k) {
             marginalLoss_[k] = pd_[k] * exposure_[k] / ul_ *
-                               (sectorSpecTerms_[sector_[k]] + exposure_[k]);
+                               (sectorSpecTerms[sector_[k]] + exposure_[k]);
         }
 
         // compute sigmaC_ and deduced figures
@@ -210,26 +256,49 @@ namespace QuantLib {
         Real betaC_ = sigmaC_ * sigmaC_ / pdSum_;
         Real pC_ = betaC_ / (1.0 + betaC_);
 
-        // compute loss distribution
-
-        loss_.clear();
-        loss_.push_back(std::pow(1.0 - pC_, alphaC_)); // A(0)
-
-        Real res;
-        for (unsigned long n = 0; n < upperIndex_ - 1; ++n) { // compute A(n+1)
-                                                              // recursively
-            res = 0.0;
-            for (unsigned long j = 0;
-                 j <= std::min<unsigned long>(maxNu_ - 1, n); ++j) {
-                iter = epsNuC_.find(j + 1);
-                if (iter != epsNuC_.end()) {
-                    res += (*iter).second * loss_[n - j] * alphaC_;
-                    if (j <= n - 1)
-                        res += (*iter).second / ((Real)(j + 1)) *
-                               ((Real)(n - j)) * loss_[n - j];
-                }
-            }
-            loss_.push_back(res * pC_ / (pdSum_ * ((Real)(n + 1))));
+        computeLossDistribution(alphaC_, pC_);
+    }
+
+    void CreditRiskPlus::computeLossDistribution(Real alpha, Real p) {
+
+        /* The probability generating function of the loss in units is
+
+               G(z) = ( (1-p) / (1 - p Q(z)) )^alpha
+
+           with Q(z) = sum_nu bandPd_[nu] / pdSum_ z^nu. G is evaluated on
+           a circle of radius r < 1 and inverted by FFT; the grid is twice
+           the size of the loss distribution and the damping r^N reduces
+           further the aliasing of the (unbounded) tail. */
+
+        const Size size = std::max<unsigned long>(upperIndex_, 1);
+        const Size order = std::max<Size>(
+            FastFourierTransform::min_order(2 * size), 1);
+        FastFourierTransform fft(order);
+        const Size N = fft.output_size();
+        const Real r = std::pow(1.0e-8, 1.0 / N);
+
+        std::vector<std::complex<Real> > q(bandPd_.size()), g(N);
+        Real rNu = 1.0;
+        for (Size nu = 0; nu < bandPd_.size(); ++nu) {
+            q[nu] = bandPd_[nu] / pdSum_ * rNu;
+            rNu *= r;
+        }
+        fft.transform(q.begin(), q.end(), g.begin());
+
+        const long nPoints = static_cast<long>(N);
+        #pragma omp parallel for
+        for (long k = 0; k < nPoints; ++k)
+            g[k] = std::pow((1.0 - p) / (1.0 - p * g[k]), alpha);
+
+        std::vector<std::complex<Real> > a(N);
+        fft.inverse_transform(g.begin(), g.end(), a.begin());
+
+        loss_ = std::vector<Real>(size);
+        rNu = 1.0;
+        for (Size i = 0; i < size; ++i) {
+            // round-off can produce tiny negative values in the far tail
+            loss_[i] = std::max(a[i].real() / (N * rNu), 0.0);
+            rNu *= r;
         }
     }
 }
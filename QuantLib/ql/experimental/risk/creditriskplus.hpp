@@ -34,6 +34,15 @@ namespace QuantLib {
     /*! Extended CreditRisk+ model as described in [1] Integrating Correlations, Risk,
       July 1999 and the references therein.
 
+      The loss distribution is obtained by inverting the probability
+      generating function of the portfolio loss with a fast Fourier
+      transform. Exposures are aggregated in bands of the loss unit, so that
+      the cost of the inversion depends on the total exposure in units
+      rather than on the number of obligors; exposures of single obligors
+      can be changed with updateExposures() without aggregating the whole
+      portfolio again. When the library is built with OpenMP support the
+      obligor and sector figures are computed in parallel.
+
       \warning the input correlation matrix is not checked for positive
       definiteness
 
@@ -72,10 +81,18 @@ namespace QuantLib {
 
         Real lossQuantile(const Real p);
 
+        /*! changes exposure and default probability of the given obligors
+            and recomputes the model; the contribution of the other obligors
+            to the exposure bands and sectors is not recalculated.
+        */
+        void updateExposures(const std::vector<Size> &obligor,
+                             const std::vector<Real> &exposure,
+                             const std::vector<Real> &defaultProbability);
+
       private:
 
-        const std::vector<Real> exposure_;
-        const std::vector<Real> pd_;
+        std::vector<Real> exposure_;
+        std::vector<Real> pd_;
         const std::vector<Size> sector_;
         const std::vector<Real> relativeDefaultVariance_;
         const Matrix correlation_;
@@ -89,7 +106,20 @@ namespace QuantLib {
         Real exposureSum_, el_, el2_, ul_;
         unsigned long upperIndex_;
 
+        // exposure bands: units and adjusted pd of each obligor, number of
+        // obligors and sum of adjusted pds in each band
+        std::vector<unsigned long> exUnit_;
+        std::vector<Real> pdAdj_;
+        std::vector<Size> bandSize_;
+        std::vector<Real> bandPd_;
+        // sums over the obligors in each sector of pd * exposure^2
+        std::vector<Real> sectorEl2_;
+        Real pdSum_;
+
+        void checkObligor(Size i, Real exposure, Real pd) const;
+        void addObligor(Size i, Real sign);
         void compute();
+        void computeLossDistribution(Real alpha, Real p);
     };
 }
 
@@ -27,11 +27,15 @@
 
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/pricingengine.hpp>
+#include <ql/quote.hpp>
+#include <ql/settings.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/time/date.hpp>
 #include <boost/any.hpp>
+#include <deque>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace QuantLib {
 
@@ -72,6 +76,29 @@ namespace QuantLib {
         */
         void setPricingEngine(const boost::shared_ptr<PricingEngine>&);
         //@}
+        //! \name Result caching
+        //@{
+        /*! When enabled, the results of each calculation are stored
+            together with the values of the given quotes and the
+            evaluation date, and calculations for a set of values
+            already stored (e.g., when a bumped quote is restored) are
+            served from the cache instead of the pricing engine.  When
+            the cache is full, the oldest results are discarded.
+
+            \warning The cache is correct only if the results depend on
+                     the market through the given quotes and the
+                     evaluation date alone; it is the responsibility of
+                     the user to pass all the relevant quotes.
+            \warning The cache is not used if the
+                     <b>performCalculation</b> method is overridden in
+                     a derived class, nor with engines not derived from
+                     GenericEngine.  It is cleared when a new pricing
+                     engine is set.
+        */
+        void enableResultCache(const std::vector<Handle<Quote> >& quotes,
+                               Size size = 100);
+        void disableResultCache();
+        //@}
         /*! When a derived argument structure is defined for an
             instrument, this method should be overridden to fill
             it. This is mandatory in case a pricing engine is used.
@@ -108,6 +135,9 @@ namespace QuantLib {
         mutable std::map<std::string,boost::any> additionalResults_;
         //@}
         boost::shared_ptr<PricingEngine> engine_;
+      private:
+        class ResultCache;
+        boost::shared_ptr<ResultCache> resultCache_;
     };
 
     class Instrument::results : public virtual PricingEngine::results {
@@ -124,6 +154,56 @@ namespace QuantLib {
     };
 
 
+    class Instrument::ResultCache {
+      public:
+        ResultCache(const std::vector<Handle<Quote> >& quotes, Size size)
+        : quotes_(quotes), size_(size) {
+            QL_REQUIRE(size > 0, "null cache size given");
+        }
+        //! values of the quotes, followed by the evaluation date
+        std::vector<Real> key() const {
+            std::vector<Real> result(quotes_.size()+1);
+            for (Size i=0; i<quotes_.size(); ++i)
+                result[i] = quotes_[i]->isValid() ? quotes_[i]->value()
+                                                  : Null<Real>();
+            result.back() =
+                Settings::instance().evaluationDate().value().serialNumber();
+            return result;
+        }
+        boost::shared_ptr<PricingEngine::results>
+        find(const std::vector<Real>& key) const {
+            std::map<std::vector<Real>,
+                     boost::shared_ptr<PricingEngine::results> >
+                ::const_iterator i = results_.find(key);
+            if (i == results_.end())
+                return boost::shared_ptr<PricingEngine::results>();
+            return i->second;
+        }
+        void store(const std::vector<Real>& key,
+                   const boost::shared_ptr<PricingEngine::results>& r) {
+            if (!r || results_.count(key) != 0)
+                return;
+            if (keys_.size() == size_) {
+                results_.erase(keys_.front());
+                keys_.pop_front();
+            }
+            results_[key] = r;
+            keys_.push_back(key);
+        }
+        void clear() {
+            results_.clear();
+            keys_.clear();
+        }
+      private:
+        std::vector<Handle<Quote> > quotes_;
+        Size size_;
+        std::map<std::vector<Real>,
+                 boost::shared_ptr<PricingEngine::results> > results_;
+        // in order of insertion
+        std::deque<std::vector<Real> > keys_;
+    };
+
+
     // inline definitions
 
     inline Instrument::Instrument()
@@ -137,10 +217,23 @@ namespace QuantLib {
         engine_ = e;
         if (engine_)
             registerWith(engine_);
+        if (resultCache_)
+            resultCache_->clear();
         // trigger (lazy) recalculation and notify observers
         update();
     }
 
+    inline void Instrument::enableResultCache(
+                                 const std::vector<Handle<Quote> >& quotes,
+                                 Size size) {
+        resultCache_ = boost::shared_ptr<ResultCache>(
+                                                new ResultCache(quotes, size));
+    }
+
+    inline void Instrument::disableResultCache() {
+        resultCache_.reset();
+    }
+
     inline void Instrument::setupArguments(PricingEngine::arguments*) const {
         QL_FAIL("Instrument::setupArguments() not implemented");
     }
@@ -162,10 +255,23 @@ namespace QuantLib {
 
     inline void Instrument::performCalculations() const {
         QL_REQUIRE(engine_, "null pricing engine");
+        std::vector<Real> key;
+        if (resultCache_) {
+            key = resultCache_->key();
+            boost::shared_ptr<PricingEngine::results> cached =
+                resultCache_->find(key);
+            if (cached) {
+                engine_->setResults(*cached);
+                fetchResults(engine_->getResults());
+                return;
+            }
+        }
         engine_->reset();
         setupArguments(engine_->getArguments());
         engine_->getArguments()->validate();
         engine_->calculate();
+        if (resultCache_)
+            resultCache_->store(key, engine_->copyResults());
         fetchResults(engine_->getResults());
     }
 
@@ -30,7 +30,10 @@
 #include <ql/errors.hpp>
 #include <ql/utilities/disposable.hpp>
 #include <ql/utilities/null.hpp>
+#include <ql/math/arrayarena.hpp>
+#include <boost/config.hpp>
 #include <boost/iterator/reverse_iterator.hpp>
+// no longer used here, but client code might rely on it
 #include <boost/scoped_array.hpp>
 #include <boost/type_traits.hpp>
 #include <functional>
@@ -46,7 +49,18 @@ namespace QuantLib {
         As such, it is <b>not</b> meant to be used as a container -
         <tt>std::vector</tt> should be used instead.
 
-        \test construction of arrays is checked in a number of cases
+        Arrays of up to four elements are stored inside the object, so
+        that small arrays (e.g., the states of multi-dimensional
+        processes) don't allocate memory.  Larger ones take their
+        storage from the current ArrayArena, if any, and from the heap
+        otherwise.  Move construction and assignment are available
+        when the compiler supports rvalue references, besides the
+        Disposable mechanism.
+
+        \test construction of arrays is checked in a number of cases;
+              swapping and assignment are checked for all combinations
+              of inline and allocated storage, and the recycling of
+              storage by an arena is checked.
     */
     class Array {
       public:
@@ -62,12 +76,19 @@ namespace QuantLib {
         Array(Size size, Real value, Real increment);
         Array(const Array&);
         Array(const Disposable<Array>&);
+        #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        Array(Array&&);
+        #endif
         //! creates the array from an iterable sequence
         template <class ForwardIterator>
         Array(ForwardIterator begin, ForwardIterator end);
+        ~Array();
 
         Array& operator=(const Array&);
         Array& operator=(const Disposable<Array>&);
+        #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        Array& operator=(Array&&);
+        #endif
         bool operator==(const Array&) const;
         bool operator!=(const Array&) const;
         //@}
@@ -135,8 +156,17 @@ namespace QuantLib {
         //@}
 
       private:
-        boost::scoped_array<Real> data_;
+        enum { inlineSize = 4 };
+        Real* allocate(Size n);
+        void deallocate();
+        template <class I>
+        void initialize(I begin, I end, const boost::true_type&);
+        template <class I>
+        void initialize(I begin, I end, const boost::false_type&);
+        // points to buffer_ for small arrays
+        Real* data_;
         Size n_;
+        Real buffer_[inlineSize];
     };
 
     //! specialization of null template for this class
@@ -207,22 +237,39 @@ namespace QuantLib {
 
     // inline definitions
 
+    inline Real* Array::allocate(Size n) {
+        if (n <= inlineSize)
+            return buffer_;
+        if (ArrayArena* arena = ArrayArena::current())
+            return arena->allocate(n);
+        return new Real[n];
+    }
+
+    inline void Array::deallocate() {
+        if (data_ != buffer_) {
+            if (ArrayArena* arena = ArrayArena::current())
+                arena->release(data_, n_);
+            else
+                delete[] data_;
+        }
+    }
+
     inline Array::Array(Size size)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {}
+    : data_(allocate(size)), n_(size) {}
 
     inline Array::Array(Size size, Real value)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : data_(allocate(size)), n_(size) {
         std::fill(begin(),end(),value);
     }
 
     inline Array::Array(Size size, Real value, Real increment)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : data_(allocate(size)), n_(size) {
         for (iterator i=begin(); i!=end(); i++,value+=increment)
             *i = value;
     }
 
     inline Array::Array(const Array& from)
-    : data_(from.n_ ? new Real[from.n_] : (Real*)(0)), n_(from.n_) {
+    : data_(allocate(from.n_)), n_(from.n_) {
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
         if (n_)
         #endif
@@ -230,59 +277,63 @@ namespace QuantLib {
     }
 
     inline Array::Array(const Disposable<Array>& from)
-    : data_((Real*)(0)), n_(0) {
+    : data_(buffer_), n_(0) {
         swap(const_cast<Disposable<Array>&>(from));
     }
 
-    namespace detail {
-
-        template <class I>
-        inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
-                                 Size& n_,
-                                 I begin, I end,
-                                 const boost::true_type&) {
-            // we got redirected here from a call like Array(3, 4)
-            // because it matched the constructor below exactly with
-            // ForwardIterator = int.  What we wanted was fill an
-            // Array with a given value, which we do here.
-            Size n = begin;
-            Real value = end;
-            data_.reset(n ? new Real[n] : (Real*)(0));
-            n_ = n;
-            std::fill(a.begin(),a.end(),value);
-        }
-
-        template <class I>
-        inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
-                                 Size& n_,
-                                 I begin, I end,
-                                 const boost::false_type&) {
-            // true iterators
-            Size n = std::distance(begin, end);
-            data_.reset(n ? new Real[n] : (Real*)(0));
-            n_ = n;
-            #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-            if (n_)
-            #endif
-            std::copy(begin, end, a.begin());
-        }
-
+    #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    inline Array::Array(Array&& from)
+    : data_(buffer_), n_(0) {
+        swap(from);
+    }
+    #endif
+
+    template <class I>
+    inline void Array::initialize(I begin, I end, const boost::true_type&) {
+        // we got redirected here from a call like Array(3, 4)
+        // because it matched the constructor below exactly with
+        // ForwardIterator = int.  What we wanted was fill an
+        // Array with a given value, which we do here.
+        Size n = begin;
+        Real value = end;
+        data_ = allocate(n);
+        n_ = n;
+        std::fill(this->begin(),this->end(),value);
+    }
+
+    template <class I>
+    inline void Array::initialize(I begin, I end, const boost::false_type&) {
+        // true iterators
+        Size n = std::distance(begin, end);
+        data_ = allocate(n);
+        n_ = n;
+        #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
+        if (n_)
+        #endif
+        std::copy(begin, end, this->begin());
     }
 
     template <class ForwardIterator>
-    inline Array::Array(ForwardIterator begin, ForwardIterator end) {
+    inline Array::Array(ForwardIterator begin, ForwardIterator end)
+    : data_(buffer_), n_(0) {
         // Unfortunately, calls such as Array(3, 4) match this constructor.
         // We have to detect integral types and dispatch.
-        detail::_fill_array_(*this, data_, n_, begin, end,
-                             boost::is_integral<ForwardIterator>());
+        initialize(begin, end, boost::is_integral<ForwardIterator>());
+    }
+
+    inline Array::~Array() {
+        deallocate();
     }
 
     inline Array& Array::operator=(const Array& from) {
-        // strong guarantee
-        Array temp(from);
-        swap(temp);
+        if (n_ == from.n_) {
+            // no need to reallocate; copying can't throw
+            std::copy(from.begin(),from.end(),begin());
+        } else {
+            // strong guarantee
+            Array temp(from);
+            swap(temp);
+        }
         return *this;
     }
 
@@ -299,6 +350,13 @@ namespace QuantLib {
         return *this;
     }
 
+    #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    inline Array& Array::operator=(Array&& from) {
+        swap(from);
+        return *this;
+    }
+    #endif
+
     inline const Array& Array::operator+=(const Array& v) {
         QL_REQUIRE(n_ == v.n_,
                    "arrays with different sizes (" << n_ << ", "
@@ -366,28 +424,28 @@ namespace QuantLib {
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
         #endif
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real Array::at(Size i) const {
         QL_REQUIRE(i<n_,
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real Array::front() const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[0];
+        return data_[0];
     }
 
     inline Real Array::back() const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[n_-1];
+        return data_[n_-1];
     }
 
     inline Real& Array::operator[](Size i) {
@@ -396,28 +454,28 @@ namespace QuantLib {
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
         #endif
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real& Array::at(Size i) {
         QL_REQUIRE(i<n_,
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real& Array::front() {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[0];
+        return data_[0];
     }
 
     inline Real& Array::back() {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[n_-1];
+        return data_[n_-1];
     }
 
     inline Size Array::size() const {
@@ -429,19 +487,19 @@ namespace QuantLib {
     }
 
     inline Array::const_iterator Array::begin() const {
-        return data_.get();
+        return data_;
     }
 
     inline Array::iterator Array::begin() {
-        return data_.get();
+        return data_;
     }
 
     inline Array::const_iterator Array::end() const {
-        return data_.get()+n_;
+        return data_+n_;
     }
 
     inline Array::iterator Array::end() {
-        return data_.get()+n_;
+        return data_+n_;
     }
 
     inline Array::const_reverse_iterator Array::rbegin() const {
@@ -462,7 +520,24 @@ namespace QuantLib {
 
     inline void Array::swap(Array& from) {
         using std::swap;
-        data_.swap(from.data_);
+        bool inlined = (data_ == buffer_),
+             fromInlined = (from.data_ == from.buffer_);
+        if (inlined && fromInlined) {
+            Real temp[inlineSize];
+            std::copy(buffer_, buffer_+n_, temp);
+            std::copy(from.buffer_, from.buffer_+from.n_, buffer_);
+            std::copy(temp, temp+n_, from.buffer_);
+        } else if (inlined) {
+            std::copy(buffer_, buffer_+n_, from.buffer_);
+            data_ = from.data_;
+            from.data_ = from.buffer_;
+        } else if (fromInlined) {
+            std::copy(from.buffer_, from.buffer_+from.n_, buffer_);
+            from.data_ = data_;
+            data_ = buffer_;
+        } else {
+            swap(data_, from.data_);
+        }
         swap(n_,from.n_);
     }
 
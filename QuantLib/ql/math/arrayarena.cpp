@@ -0,0 +1,68 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/arrayarena.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        // each thread has its own chain of arenas
+        #if defined(_MSC_VER)
+        __declspec(thread) ArrayArena* currentArena = 0;
+        #else
+        __thread ArrayArena* currentArena = 0;
+        #endif
+
+    }
+
+    ArrayArena::ArrayArena() : previous_(currentArena) {
+        currentArena = this;
+    }
+
+    ArrayArena::~ArrayArena() {
+        currentArena = previous_;
+        for (std::map<Size, std::vector<Real*> >::iterator i =
+                 storage_.begin(); i != storage_.end(); ++i) {
+            for (Size j=0; j<i->second.size(); ++j)
+                delete[] i->second[j];
+        }
+    }
+
+    ArrayArena* ArrayArena::current() {
+        return currentArena;
+    }
+
+    Real* ArrayArena::allocate(Size n) {
+        std::map<Size, std::vector<Real*> >::iterator i = storage_.find(n);
+        if (i == storage_.end() || i->second.empty())
+            return new Real[n];
+        Real* p = i->second.back();
+        i->second.pop_back();
+        return p;
+    }
+
+    void ArrayArena::release(Real* p, Size n) {
+        // called by destructors, which mustn't throw
+        try {
+            storage_[n].push_back(p);
+        } catch (...) {
+            delete[] p;
+        }
+    }
+
+}
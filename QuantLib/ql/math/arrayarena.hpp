@@ -0,0 +1,67 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file arrayarena.hpp
+    \brief scoped recycling of array storage
+*/
+
+#ifndef quantlib_array_arena_hpp
+#define quantlib_array_arena_hpp
+
+#include <ql/types.hpp>
+#include <boost/noncopyable.hpp>
+#include <map>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Scoped recycling of array storage
+    /*! While an instance of this class is alive, the storage released
+        by the arrays destroyed in the same thread is kept instead of
+        being freed, and it is given to the arrays of the same size
+        built afterwards.  Loops creating temporaries of the same
+        sizes at each step, such as finite-difference rollbacks or
+        Monte Carlo simulations, stop allocating memory after the
+        first step.  The kept storage is freed when the instance is
+        destroyed; arrays outliving it free their own storage as usual,
+        so that the instance can be safely used as a local variable
+        around the loop.
+
+        Instances can be nested; the innermost one is used.
+
+        \warning Instances must be destroyed in the reverse order of
+                 construction, which is guaranteed when they are used
+                 as local variables.
+    */
+    class ArrayArena : private boost::noncopyable {
+      public:
+        ArrayArena();
+        ~ArrayArena();
+        //! the innermost arena in the current thread, if any
+        static ArrayArena* current();
+        //! storage for the given number of elements
+        Real* allocate(Size n);
+        //! keeps the storage for later use
+        void release(Real* p, Size n);
+      private:
+        ArrayArena* previous_;
+        std::map<Size, std::vector<Real*> > storage_;
+    };
+
+}
+
+#endif
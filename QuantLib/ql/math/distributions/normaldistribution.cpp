@@ -22,6 +22,7 @@
 
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
+#include <algorithm>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -126,6 +127,31 @@ namespace QuantLib {
         return z;
     }
 
+    void InverseCumulativeNormal::transform(Real* x, Size n) const {
+        const Size blockSize = 64;
+        Real u[blockSize];
+        while (n > 0) {
+            const Size block = std::min(n, blockSize);
+            std::copy(x, x+block, u);
+            for (Size i=0; i<block; ++i) {
+                const Real z = u[i] - 0.5;
+                const Real r = z*z;
+                x[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                    (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+            }
+            for (Size i=0; i<block; ++i) {
+                if (u[i] < x_low_ || x_high_ < u[i])
+                    x[i] = tail_value(u[i]);
+            }
+            if (average_ != 0.0 || sigma_ != 1.0) {
+                for (Size i=0; i<block; ++i)
+                    x[i] = average_ + sigma_*x[i];
+            }
+            x += block;
+            n -= block;
+        }
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
@@ -136,6 +136,12 @@ namespace QuantLib {
 
             return z;
         }
+        /*! transforms in place \f$ n \f$ uniform deviates; the results
+            are the same as the ones returned by operator().  The central
+            region is evaluated for the whole block without branching, so
+            that the compiler can vectorize it, and the tails are fixed
+            in a second pass. */
+        void transform(Real* x, Size n) const;
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
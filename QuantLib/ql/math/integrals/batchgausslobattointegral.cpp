@@ -0,0 +1,249 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/integrals/batchgausslobattointegral.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace {
+
+        const Real alpha = std::sqrt(2.0/3.0);
+        const Real beta  = 1.0/std::sqrt(5.0);
+
+        // the 7 nodes of the rules on [-1,1]
+        const Real nodes[] = { -1.0, -alpha, -beta, 0.0, beta, alpha, 1.0 };
+
+        struct Panel {
+            Real a, b;
+            // values of the integrand at the 7 nodes, by row
+            Matrix values;
+            // Kronrod estimate and its distance from the Lobatto one
+            Array integral, error;
+            Real maxError;
+            bool refined;
+        };
+
+        void checkSize(const Matrix& y, Size nodes, Size dimension) {
+            QL_REQUIRE(y.rows() == nodes && y.columns() == dimension,
+                       "integrand returned a " << y.rows() << "x"
+                       << y.columns() << " matrix; "
+                       << nodes << "x" << dimension << " required");
+        }
+
+        // evaluates the integrand at the interior nodes of the panels
+        // starting from the given one, whose endpoint values are set
+        void evaluate(const BatchGaussLobattoIntegral::Integrand& f,
+                      std::vector<Panel>& panels,
+                      Size first,
+                      Size dimension) {
+            const Size n = panels.size() - first;
+            Array x(5*n);
+            for (Size k=0; k<n; ++k) {
+                const Panel& p = panels[first+k];
+                const Real h = (p.b-p.a)/2, m = (p.a+p.b)/2;
+                for (Size j=1; j<6; ++j)
+                    x[5*k+j-1] = m + nodes[j]*h;
+            }
+            Matrix y(5*n, dimension);
+            f(x, y);
+            checkSize(y, 5*n, dimension);
+
+            for (Size k=0; k<n; ++k) {
+                Panel& p = panels[first+k];
+                const Real h = (p.b-p.a)/2;
+                for (Size j=1; j<6; ++j)
+                    std::copy(y.row_begin(5*k+j-1), y.row_end(5*k+j-1),
+                              p.values.row_begin(j));
+                p.integral = Array(dimension);
+                p.error = Array(dimension);
+                p.maxError = 0.0;
+                p.refined = false;
+                for (Size c=0; c<dimension; ++c) {
+                    const Real f0 = p.values[0][c], f1 = p.values[1][c],
+                               f2 = p.values[2][c], f3 = p.values[3][c],
+                               f4 = p.values[4][c], f5 = p.values[5][c],
+                               f6 = p.values[6][c];
+                    const Real integral2 = (h/6)*(f0+f6+5*(f2+f4));
+                    const Real integral1 = (h/1470)*(77*(f0+f6)
+                                                     +432*(f1+f5)
+                                                     +625*(f2+f4)+672*f3);
+                    p.integral[c] = integral1;
+                    p.error[c] = std::fabs(integral1-integral2);
+                    p.maxError = std::max(p.maxError, p.error[c]);
+                }
+            }
+        }
+
+        class ScalarIntegrand {
+          public:
+            explicit ScalarIntegrand(const boost::function<Real (Real)>& f)
+            : f_(f) {}
+            void operator()(const Array& x, Matrix& y) const {
+                for (Size i=0; i<x.size(); ++i)
+                    y[i][0] = f_(x[i]);
+            }
+          private:
+            boost::function<Real (Real)> f_;
+        };
+
+    }
+
+    BatchGaussLobattoIntegral::BatchGaussLobattoIntegral(Size maxEvaluations,
+                                                         Real absAccuracy,
+                                                         Real relAccuracy)
+    : Integrator(absAccuracy, maxEvaluations), relAccuracy_(relAccuracy) {
+        QL_REQUIRE(maxEvaluations >= 37,
+                   "required maxEvaluations (" << maxEvaluations <<
+                   ") not allowed. It must be >= 37");
+    }
+
+    Disposable<Array> BatchGaussLobattoIntegral::operator()(
+                                                      const Integrand& f,
+                                                      Size dimension,
+                                                      Real a,
+                                                      Real b) const {
+        QL_REQUIRE(dimension > 0, "null integrand dimension");
+        setNumberOfEvaluations(0);
+        if (a == b) {
+            setAbsoluteError(0.0);
+            Array result(dimension, 0.0);
+            return result;
+        }
+        if (b > a)
+            return integrateBatch(f, dimension, a, b);
+        Array result = integrateBatch(f, dimension, b, a);
+        result *= -1.0;
+        return result;
+    }
+
+    Real BatchGaussLobattoIntegral::integrate(
+                                      const boost::function<Real (Real)>& f,
+                                      Real a,
+                                      Real b) const {
+        return integrateBatch(ScalarIntegrand(f), 1, a, b)[0];
+    }
+
+    Disposable<Array> BatchGaussLobattoIntegral::integrateBatch(
+                                                      const Integrand& f,
+                                                      Size dimension,
+                                                      Real a,
+                                                      Real b) const {
+        // initial panel
+        std::vector<Panel> panels(1);
+        panels[0].a = a;
+        panels[0].b = b;
+        panels[0].values = Matrix(7, dimension);
+        Array endpoints(2);
+        endpoints[0] = a;
+        endpoints[1] = b;
+        Matrix y(2, dimension);
+        f(endpoints, y);
+        checkSize(y, 2, dimension);
+        std::copy(y.row_begin(0), y.row_end(0), panels[0].values.row_begin(0));
+        std::copy(y.row_begin(1), y.row_end(1), panels[0].values.row_begin(6));
+        evaluate(f, panels, 0, dimension);
+        increaseNumberOfEvaluations(7);
+
+        Array result = panels[0].integral, error = panels[0].error;
+        // max-heap of the panels still to be refined by error estimate
+        std::vector<std::pair<Real,Size> > heap(
+                             1, std::make_pair(panels[0].maxError, Size(0)));
+
+        // the first panel is always refined, since an estimate on
+        // the whole interval is hardly reliable
+        bool converged = false;
+        while (!heap.empty() && !converged) {
+            std::pop_heap(heap.begin(), heap.end());
+            const Size k = heap.back().second;
+            heap.pop_back();
+
+            const Real h = (panels[k].b-panels[k].a)/2,
+                       m = (panels[k].a+panels[k].b)/2;
+            Real x[7];
+            x[0] = panels[k].a;
+            x[6] = panels[k].b;
+            bool splittable = true;
+            for (Size j=1; j<7; ++j) {
+                if (j < 6)
+                    x[j] = m + nodes[j]*h;
+                if (x[j] <= x[j-1])
+                    splittable = false;
+            }
+            if (!splittable) {
+                // no more machine numbers in the panel; its estimate
+                // is the best we can get
+                continue;
+            }
+
+            QL_REQUIRE(numberOfEvaluations()+30 <= maxEvaluations(),
+                       "max number of evaluations reached");
+
+            const Size first = panels.size();
+            panels.resize(first+6);
+            for (Size j=0; j<6; ++j) {
+                Panel& child = panels[first+j];
+                child.a = x[j];
+                child.b = x[j+1];
+                child.values = Matrix(7, dimension);
+                std::copy(panels[k].values.row_begin(j),
+                          panels[k].values.row_end(j),
+                          child.values.row_begin(0));
+                std::copy(panels[k].values.row_begin(j+1),
+                          panels[k].values.row_end(j+1),
+                          child.values.row_begin(6));
+            }
+            evaluate(f, panels, first, dimension);
+            increaseNumberOfEvaluations(30);
+
+            result -= panels[k].integral;
+            error -= panels[k].error;
+            for (Size j=first; j<first+6; ++j) {
+                result += panels[j].integral;
+                error += panels[j].error;
+                heap.push_back(std::make_pair(panels[j].maxError, j));
+                std::push_heap(heap.begin(), heap.end());
+            }
+            panels[k].refined = true;
+            panels[k].values = Matrix();
+
+            converged = true;
+            for (Size c=0; c<dimension && converged; ++c) {
+                Real tolerance = absoluteAccuracy();
+                if (relAccuracy_ != Null<Real>())
+                    tolerance = std::max(tolerance,
+                                         relAccuracy_*std::fabs(result[c]));
+                converged = (error[c] <= tolerance);
+            }
+        }
+
+        // the final sums are taken over the unrefined panels, so that
+        // no rounding error is accumulated by the updates above
+        std::fill(result.begin(), result.end(), 0.0);
+        std::fill(error.begin(), error.end(), 0.0);
+        for (Size k=0; k<panels.size(); ++k) {
+            if (!panels[k].refined) {
+                result += panels[k].integral;
+                error += panels[k].error;
+            }
+        }
+        setAbsoluteError(*std::max_element(error.begin(), error.end()));
+        return result;
+    }
+
+}
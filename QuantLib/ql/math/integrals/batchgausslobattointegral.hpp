@@ -0,0 +1,90 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchgausslobattointegral.hpp
+    \brief globally adaptive Gauss-Lobatto integration of batched,
+           vector-valued integrands
+*/
+
+#ifndef quantlib_batch_gauss_lobatto_integral_hpp
+#define quantlib_batch_gauss_lobatto_integral_hpp
+
+#include <ql/math/integrals/integral.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    //! Globally adaptive Gauss-Lobatto integration of batched integrands
+    /*! This class uses the same 4-point Gauss-Lobatto and 7-point
+        Kronrod rules as GaussLobattoIntegral, but it is meant for
+        integrands which are expensive to evaluate:
+
+        - all the new nodes of a refinement step are passed to the
+          integrand in a single call, so that it can share work among
+          them;
+        - the integrand can be vector-valued, so that several integrals
+          over the same domain (e.g., a price for a number of strikes
+          or maturities) are calculated in a single pass;
+        - the endpoints and the interior nodes of a panel become the
+          endpoints of its sub-panels, so that no value is calculated
+          twice;
+        - the refinement is global and iterative: panels are kept in a
+          heap ordered by their error estimate, and the one with the
+          largest error is split until the sum of the estimates meets
+          the required accuracy for every component.
+
+        The absolute error returned by absoluteError() is the largest
+        one among the components; the number of evaluations counts the
+        nodes, regardless of the number of components.
+
+        \test the results are checked against known values and against
+              the scalar integration of each component.
+    */
+    class BatchGaussLobattoIntegral : public Integrator {
+      public:
+        /*! The integrand must write in the i-th row of \c y the values
+            of its components at the node \c x[i]; \c y is sized by the
+            caller.
+        */
+        typedef boost::function<void (const Array& x, Matrix& y)> Integrand;
+
+        BatchGaussLobattoIntegral(Size maxEvaluations,
+                                  Real absAccuracy,
+                                  Real relAccuracy = Null<Real>());
+
+        using Integrator::operator();
+        //! integrals over \f$ [a,b] \f$ of the components of \f$ f \f$
+        Disposable<Array> operator()(const Integrand& f,
+                                     Size dimension,
+                                     Real a,
+                                     Real b) const;
+      protected:
+        Real integrate(const boost::function<Real (Real)>& f,
+                       Real a,
+                       Real b) const;
+      private:
+        Disposable<Array> integrateBatch(const Integrand& f,
+                                         Size dimension,
+                                         Real a,
+                                         Real b) const;
+        Real relAccuracy_;
+    };
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 */
 
 #include <ql/math/integrals/gausslobattointegral.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -110,45 +111,73 @@ namespace QuantLib {
         }
     }
     
+    namespace {
+
+        // interval still to be integrated, with the values of the
+        // integrand at its endpoints
+        struct Panel {
+            Real a, b, fa, fb;
+            Panel(Real a, Real b, Real fa, Real fb)
+            : a(a), b(b), fa(fa), fb(fb) {}
+        };
+
+    }
+
     Real GaussLobattoIntegral::adaptivGaussLobattoStep(
                                      const boost::function<Real (Real)>& f,
                                      Real a, Real b, Real fa, Real fb,
                                      Real acc) const {
-        QL_REQUIRE(numberOfEvaluations() < maxEvaluations(),
-                   "max number of iterations reached");
-        
-        const Real h=(b-a)/2; 
-        const Real m=(a+b)/2;
-        
-        const Real mll=m-alpha_*h; 
-        const Real ml =m-beta_*h; 
-        const Real mr =m+beta_*h; 
-        const Real mrr=m+alpha_*h;
-        
-        const Real fmll= f(mll);
-        const Real fml = f(ml);
-        const Real fm  = f(m);
-        const Real fmr = f(mr);
-        const Real fmrr= f(mrr);
-        increaseNumberOfEvaluations(5);
-        
-        const Real integral2=(h/6)*(fa+fb+5*(fml+fmr));
-        const Real integral1=(h/1470)*(77*(fa+fb)
-                                       +432*(fmll+fmrr)+625*(fml+fmr)+672*fm);
-        
-        // avoid 80 bit logic on x86 cpu
-        volatile Real dist = acc + (integral1-integral2);
-        if(Real(dist)==acc || mll<=a || b<=mrr) {
-            QL_REQUIRE(m>a && b>m,"Interval contains no more machine number");
-            return integral1;
-        }
-        else {
-            return  adaptivGaussLobattoStep(f,a,mll,fa,fmll,acc)  
-                  + adaptivGaussLobattoStep(f,mll,ml,fmll,fml,acc)
-                  + adaptivGaussLobattoStep(f,ml,m,fml,fm,acc)
-                  + adaptivGaussLobattoStep(f,m,mr,fm,fmr,acc)
-                  + adaptivGaussLobattoStep(f,mr,mrr,fmr,fmrr,acc)
-                  + adaptivGaussLobattoStep(f,mrr,b,fmrr,fb,acc);
+        // The panels are refined depth-first, in the same order as a
+        // recursive implementation would, but the pending ones are kept
+        // on the heap; this way, a large number of evaluations can't
+        // cause a stack overflow.
+        std::vector<Panel> pending(1, Panel(a, b, fa, fb));
+        Real result = 0.0;
+
+        while (!pending.empty()) {
+            QL_REQUIRE(numberOfEvaluations() < maxEvaluations(),
+                       "max number of iterations reached");
+
+            const Panel panel = pending.back();
+            pending.pop_back();
+
+            const Real h=(panel.b-panel.a)/2;
+            const Real m=(panel.a+panel.b)/2;
+
+            const Real mll=m-alpha_*h;
+            const Real ml =m-beta_*h;
+            const Real mr =m+beta_*h;
+            const Real mrr=m+alpha_*h;
+
+            const Real fmll= f(mll);
+            const Real fml = f(ml);
+            const Real fm  = f(m);
+            const Real fmr = f(mr);
+            const Real fmrr= f(mrr);
+            increaseNumberOfEvaluations(5);
+
+            const Real integral2=(h/6)*(panel.fa+panel.fb+5*(fml+fmr));
+            const Real integral1=(h/1470)*(77*(panel.fa+panel.fb)
+                                   +432*(fmll+fmrr)+625*(fml+fmr)+672*fm);
+
+            // avoid 80 bit logic on x86 cpu
+            volatile Real dist = acc + (integral1-integral2);
+            if(Real(dist)==acc || mll<=panel.a || panel.b<=mrr) {
+                QL_REQUIRE(m>panel.a && panel.b>m,
+                           "Interval contains no more machine number");
+                result += integral1;
+            }
+            else {
+                // pushed in reverse order so that the leftmost
+                // sub-panel is the next to be refined
+                pending.push_back(Panel(mrr,panel.b,fmrr,panel.fb));
+                pending.push_back(Panel(mr,mrr,fmr,fmrr));
+                pending.push_back(Panel(m,mr,fm,fmr));
+                pending.push_back(Panel(ml,m,fml,fm));
+                pending.push_back(Panel(mll,ml,fmll,fml));
+                pending.push_back(Panel(panel.a,mll,panel.fa,fmll));
+            }
         }
+        return result;
     }
 }
@@ -19,6 +19,7 @@
 
 #include <ql/math/integrals/kronrodintegral.hpp>
 #include <ql/types.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -349,7 +350,7 @@ namespace QuantLib {
     GaussKronrodAdaptive::integrate(const boost::function<Real (Real)>& f,
                                     Real a,
                                     Real b) const {
-        return integrateRecursively(f, a, b, absoluteAccuracy());
+        return integrateAdaptively(f, a, b, absoluteAccuracy());
     }
 
     // weights for 7-point Gauss-Legendre integration
@@ -378,59 +379,77 @@ namespace QuantLib {
                                  0.949107912342758,
                                  0.991455371120813 };
 
-    Real GaussKronrodAdaptive::integrateRecursively(
+    Real GaussKronrodAdaptive::integrateAdaptively(
                                     const boost::function<Real (Real)>& f,
                                     Real a,
                                     Real b,
                                     Real tolerance) const {
 
-            Real halflength = (b - a) / 2;
-            Real center = (a + b) / 2;
-
-            Real g7; // will be result of G7 integral
-            Real k15; // will be result of K15 integral
-
-            Real t, fsum; // t (abscissa) and f(t)
-            Real fc = f(center);
-            g7 = fc * g7w[0];
-            k15 = fc * k15w[0];
-
-            // calculate g7 and half of k15
-            Integer j, j2;
-            for (j = 1, j2 = 2; j < 4; j++, j2 += 2) {
-                t = halflength * k15t[j2];
-                fsum = f(center - t) + f(center + t);
-                g7  += fsum * g7w[j];
-                k15 += fsum * k15w[j2];
-            }
-
-            // calculate other half of k15
-            for (j2 = 1; j2 < 8; j2 += 2) {
-                t = halflength * k15t[j2];
-                fsum = f(center - t) + f(center + t);
-                k15 += fsum * k15w[j2];
-            }
-
-            // multiply by (a - b) / 2
-            g7 = halflength * g7;
-            k15 = halflength * k15;
-
-            // 15 more function evaluations have been used
-            increaseNumberOfEvaluations(15);
-
-            // error is <= k15 - g7
-            // if error is larger than tolerance then split the interval
-            // in two and integrate recursively
-            if (std::fabs(k15 - g7) < tolerance) {
-                return k15;
-            } else {
-                QL_REQUIRE(numberOfEvaluations()+30 <=
-                           maxEvaluations(),
-                           "maximum number of function evaluations "
-                           "exceeded");
-                return integrateRecursively(f, a, center, tolerance/2)
-                    + integrateRecursively(f, center, b, tolerance/2);
+            // intervals still to be integrated, with their tolerance;
+            // they are kept on the heap rather than on the stack so
+            // that a large number of subdivisions can't overflow it.
+            std::vector<std::pair<std::pair<Real,Real>,Real> > pending;
+            pending.push_back(std::make_pair(std::make_pair(a, b),
+                                             tolerance));
+            Real result = 0.0;
+
+            while (!pending.empty()) {
+                a = pending.back().first.first;
+                b = pending.back().first.second;
+                tolerance = pending.back().second;
+                pending.pop_back();
+
+                Real halflength = (b - a) / 2;
+                Real center = (a + b) / 2;
+
+                Real g7; // will be result of G7 integral
+                Real k15; // will be result of K15 integral
+
+                Real t, fsum; // t (abscissa) and f(t)
+                Real fc = f(center);
+                g7 = fc * g7w[0];
+                k15 = fc * k15w[0];
+
+                // calculate g7 and half of k15
+                Integer j, j2;
+                for (j = 1, j2 = 2; j < 4; j++, j2 += 2) {
+                    t = halflength * k15t[j2];
+                    fsum = f(center - t) + f(center + t);
+                    g7  += fsum * g7w[j];
+                    k15 += fsum * k15w[j2];
+                }
+
+                // calculate other half of k15
+                for (j2 = 1; j2 < 8; j2 += 2) {
+                    t = halflength * k15t[j2];
+                    fsum = f(center - t) + f(center + t);
+                    k15 += fsum * k15w[j2];
+                }
+
+                // multiply by (a - b) / 2
+                g7 = halflength * g7;
+                k15 = halflength * k15;
+
+                // 15 more function evaluations have been used
+                increaseNumberOfEvaluations(15);
+
+                // error is <= k15 - g7
+                // if error is larger than tolerance then split the
+                // interval in two; the left half is refined first
+                if (std::fabs(k15 - g7) < tolerance) {
+                    result += k15;
+                } else {
+                    QL_REQUIRE(numberOfEvaluations()+30 <=
+                               maxEvaluations(),
+                               "maximum number of function evaluations "
+                               "exceeded");
+                    pending.push_back(std::make_pair(
+                        std::make_pair(center, b), tolerance/2));
+                    pending.push_back(std::make_pair(
+                        std::make_pair(a, center), tolerance/2));
+                }
             }
+            return result;
         }
 
 
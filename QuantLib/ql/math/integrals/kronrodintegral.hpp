@@ -92,10 +92,10 @@ namespace QuantLib {
                          Real a,
                          Real b) const;
       private:
-          Real integrateRecursively(const boost::function<Real (Real)>& f,
-                                    Real a,
-                                    Real b,
-                                    Real tolerance) const;
+          Real integrateAdaptively(const boost::function<Real (Real)>& f,
+                                   Real a,
+                                   Real b,
+                                   Real tolerance) const;
       };
 }
 
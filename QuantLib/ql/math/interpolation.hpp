@@ -30,14 +30,65 @@
 #include <ql/math/comparison.hpp>
 #include <ql/errors.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        //! locates the interval containing a point, starting from a guess
+        /*! Returns the index \f$ i \f$, clipped to \f$ [0, n-2] \f$,
+            of the last node such that \f$ x_i \le x \f$.  The search
+            moves away from the guess in steps of doubling size until
+            the point is bracketed, and then bisects the bracket; this
+            takes constant time when successive points are close to each
+            other and logarithmic time in the worst case.
+        */
+        template <class I>
+        Size hunt(const I& begin, const I& end, Real x, Size guess) {
+            const Size n = end - begin;
+            if (x < *begin)
+                return 0;
+            else if (x > *(end-1))
+                return n-2;
+            Size lo, hi, step = 1;
+            if (guess > n-2)
+                guess = n-2;
+            if (begin[guess] <= x) {
+                lo = guess;
+                hi = lo+1;
+                while (hi < n-1 && begin[hi] <= x) {
+                    lo = hi;
+                    step *= 2;
+                    hi = std::min(lo+step, n-1);
+                }
+            } else {
+                // guess > 0 here, since x is not below the first node
+                hi = guess;
+                lo = hi-1;
+                while (lo > 0 && x < begin[lo]) {
+                    hi = lo;
+                    step *= 2;
+                    lo = hi > step ? hi-step : 0;
+                }
+            }
+            return std::upper_bound(begin+lo, begin+hi, x) - begin - 1;
+        }
+
+    }
+
     //! base class for 1-D interpolations.
     /*! Classes derived from this class will provide interpolated
         values from two sequences of equal length, representing
         discretized values of a variable and a function of the former,
         respectively.
+
+        \warning Implementations derived from templateImpl remember
+                 the interval found by the last lookup and use it as
+                 the starting guess for the next one. The guess is
+                 written without synchronization, so concurrent calls
+                 on the same instance may race on it; since it is only
+                 a guess, the interpolated values are not affected.
     */
     class Interpolation : public Extrapolator {
       protected:
@@ -55,6 +106,10 @@ namespace QuantLib {
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
+            virtual void values(const Real* x, Real* y, Size n) const {
+                for (Size i=0; i<n; ++i)
+                    y[i] = value(x[i]);
+            }
         };
         boost::shared_ptr<Impl> impl_;
       public:
@@ -66,7 +121,7 @@ namespace QuantLib {
           public:
             templateImpl(const I1& xBegin, const I1& xEnd, const I2& yBegin,
                          const int requiredPoints = 2)
-            : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin) {
+            : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin), lastIndex_(0) {
                 QL_REQUIRE(static_cast<int>(xEnd_-xBegin_) >= requiredPoints,
                            "not enough points to interpolate: at least " <<
                            requiredPoints <<
@@ -98,15 +153,18 @@ namespace QuantLib {
                 for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
                     QL_REQUIRE(*j > *i, "unsorted x values");
                 #endif
-                if (x < *xBegin_)
-                    return 0;
-                else if (x > *(xEnd_-1))
-                    return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                // curves are usually queried at increasing times, so
+                // the search starts from the result of the last call.
+                // The latter is only used as a guess and doesn't
+                // affect the result.
+                Size i = detail::hunt(xBegin_, xEnd_, x, lastIndex_);
+                lastIndex_ = i;
+                return i;
             }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
+            // starting guess for the next search; see locate()
+            mutable Size lastIndex_;
         };
       public:
         Interpolation() {}
@@ -116,6 +174,16 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        /*! writes in y the interpolated values at the n points x;
+            for points sorted in increasing order, locating them takes
+            linear time overall.
+        */
+        void operator()(const Real* x, Real* y, Size n,
+                        bool allowExtrapolation = false) const {
+            for (Size i=0; i<n; ++i)
+                checkRange(x[i],allowExtrapolation);
+            impl_->values(x, y, n);
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
@@ -25,7 +25,7 @@
 #ifndef quantlib_interpolation2D_hpp
 #define quantlib_interpolation2D_hpp
 
-#include <ql/math/interpolations/extrapolation.hpp>
+#include <ql/math/interpolation.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/errors.hpp>
@@ -40,6 +40,12 @@ namespace QuantLib {
         representing the discretized values of the \f$ x \f$ and \f$ y
         \f$ variables, and a \f$ N \times M \f$ matrix representing
         the tabulated function values.
+
+        \warning as for Interpolation, the intervals found by the last
+                 lookups are kept without synchronization as starting
+                 guesses for the next ones; concurrent calls on the
+                 same instance may race on them without affecting the
+                 interpolated values.
     */
     class Interpolation2D : public Extrapolator {
       protected:
@@ -73,7 +79,7 @@ namespace QuantLib {
                          const I2& yBegin, const I2& yEnd,
                          const M& zData)
             : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin), yEnd_(yEnd),
-              zData_(zData) {
+              zData_(zData), lastX_(0), lastY_(0) {
                 QL_REQUIRE(xEnd_-xBegin_ >= 2,
                            "not enough x points to interpolate: at least 2 "
                            "required, " << xEnd_-xBegin_ << " provided");
@@ -126,28 +132,26 @@ namespace QuantLib {
                 for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
                     QL_REQUIRE(*j > *i, "unsorted x values");
                 #endif
-                if (x < *xBegin_)
-                    return 0;
-                else if (x > *(xEnd_-1))
-                    return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                // searches start from the results of the last calls,
+                // see Interpolation::templateImpl::locate
+                Size i = detail::hunt(xBegin_, xEnd_, x, lastX_);
+                lastX_ = i;
+                return i;
             }
             Size locateY(Real y) const {
                 #if defined(QL_EXTRA_SAFETY_CHECKS)
                 for (I2 k=yBegin_, l=yBegin_+1; l!=yEnd_; ++k, ++l)
                     QL_REQUIRE(*l > *k, "unsorted y values");
                 #endif
-                if (y < *yBegin_)
-                    return 0;
-                else if (y > *(yEnd_-1))
-                    return yEnd_-yBegin_-2;
-                else
-                    return std::upper_bound(yBegin_,yEnd_-1,y)-yBegin_-1;
+                Size j = detail::hunt(yBegin_, yEnd_, y, lastY_);
+                lastY_ = j;
+                return j;
             }
             I1 xBegin_, xEnd_;
             I2 yBegin_, yEnd_;
             const M& zData_;
+            // starting guesses for the next searches
+            mutable Size lastX_, lastY_;
         };
       public:
         Interpolation2D() {}
@@ -56,9 +56,58 @@
 #pragma clang diagnostic pop
 #endif
 
+#if defined(QL_USE_BLAS)
+#if defined(CL_TAPE_NOAD) || defined(CL_TAPE_CPPAD) || defined(CL_TAPE_ADOLC)
+#error BLAS support requires Real to be defined as double
+#endif
+#include <cblas.h>
+#endif
+
 
 namespace QuantLib {
 
+    const Disposable<Matrix> operator*(const Matrix& m1, const Matrix& m2) {
+        QL_REQUIRE(m1.columns() == m2.rows(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "multiplied");
+        const Size rows = m1.rows(), columns = m2.columns(),
+                   inner = m1.columns();
+        Matrix result(rows, columns, 0.0);
+        if (result.empty() || inner == 0)
+            return result;
+
+        #if defined(QL_USE_BLAS)
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                    int(rows), int(columns), int(inner),
+                    1.0, m1.begin(), int(inner), m2.begin(), int(columns),
+                    0.0, result.begin(), int(columns));
+        #else
+        // i-k-j ordering on blocks of the inner and column dimensions: the
+        // innermost loop runs along contiguous rows of m2 and of the result,
+        // and the block of m2 being used stays in cache across the rows of m1
+        const Size blockSize = 64;
+        for (Size kk=0; kk<inner; kk+=blockSize) {
+            const Size kEnd = std::min(kk+blockSize, inner);
+            for (Size jj=0; jj<columns; jj+=blockSize) {
+                const Size jEnd = std::min(jj+blockSize, columns);
+                for (Size i=0; i<rows; ++i) {
+                    Matrix::const_row_iterator a = m1.row_begin(i);
+                    Matrix::row_iterator r = result.row_begin(i);
+                    for (Size k=kk; k<kEnd; ++k) {
+                        const Real aik = a[k];
+                        Matrix::const_row_iterator b = m2.row_begin(k);
+                        for (Size j=jj; j<jEnd; ++j)
+                            r[j] += aik*b[j];
+                    }
+                }
+            }
+        }
+        #endif
+        return result;
+    }
+
     Disposable<Matrix> inverse(const Matrix& m) {
         #if !defined(QL_NO_UBLAS_SUPPORT)
 
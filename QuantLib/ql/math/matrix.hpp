@@ -28,6 +28,7 @@
 
 #include <ql/math/array.hpp>
 #include <ql/utilities/steppingiterator.hpp>
+#include <boost/scoped_array.hpp>
 
 namespace QuantLib {
 
@@ -151,7 +152,11 @@ namespace QuantLib {
     const Disposable<Array> operator*(const Array&, const Matrix&);
     /*! \relates Matrix */
     const Disposable<Array> operator*(const Matrix&, const Array&);
-    /*! \relates Matrix */
+    /*! \relates Matrix
+        The product is computed by blocks fitting in the processor cache;
+        if the library was configured with BLAS support (QL_USE_BLAS) it
+        is delegated to the dgemm routine instead.
+    */
     const Disposable<Matrix> operator*(const Matrix&, const Matrix&);
 
     // misc. operations
@@ -500,11 +505,14 @@ namespace QuantLib {
                    "vectors and matrices with different sizes ("
                    << v.size() << ", " << m.rows() << "x" << m.columns() <<
                    ") cannot be multiplied");
-        Array result(m.columns());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),
-                                   m.column_begin(i),0.0);
+        // accumulate by rows to avoid striding along the columns
+        Array result(m.columns(), 0.0);
+        for (Size i=0; i<v.size(); i++) {
+            const Real vi = v[i];
+            Matrix::const_row_iterator mi = m.row_begin(i);
+            for (Size j=0; j<result.size(); j++)
+                result[j] += vi*mi[j];
+        }
         return result;
     }
 
@@ -520,34 +528,26 @@ namespace QuantLib {
         return result;
     }
 
-    inline const Disposable<Matrix> operator*(const Matrix& m1,
-                                              const Matrix& m2) {
-        QL_REQUIRE(m1.columns() == m2.rows(),
-                   "matrices with different sizes (" <<
-                   m1.rows() << "x" << m1.columns() << ", " <<
-                   m2.rows() << "x" << m2.columns() << ") cannot be "
-                   "multiplied");
-        Matrix result(m1.rows(),m2.columns(),0.0);
-        for (Size i=0; i<result.rows(); ++i) {
-            for (Size k=0; k<m1.columns(); ++k) {
-                for (Size j=0; j<result.columns(); ++j) {
-                    result[i][j] += m1[i][k]*m2[k][j];
+    inline const Disposable<Matrix> transpose(const Matrix& m) {
+        const Size rows = m.rows(), columns = m.columns();
+        Matrix result(columns, rows);
+        // copy by square blocks so that both the rows read and the
+        // columns written stay in cache
+        const Size blockSize = 32;
+        for (Size ii=0; ii<rows; ii+=blockSize) {
+            const Size iEnd = std::min(ii+blockSize, rows);
+            for (Size jj=0; jj<columns; jj+=blockSize) {
+                const Size jEnd = std::min(jj+blockSize, columns);
+                for (Size i=ii; i<iEnd; i++) {
+                    Matrix::const_row_iterator mi = m.row_begin(i);
+                    for (Size j=jj; j<jEnd; j++)
+                        result[j][i] = mi[j];
                 }
             }
         }
         return result;
     }
 
-    inline const Disposable<Matrix> transpose(const Matrix& m) {
-        Matrix result(m.columns(),m.rows());
-        #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-        if (!m.empty())
-        #endif
-        for (Size i=0; i<m.rows(); i++)
-            std::copy(m.row_begin(i),m.row_end(i),result.column_begin(i));
-        return result;
-    }
-
     inline const Disposable<Matrix> outerProduct(const Array& v1,
                                                  const Array& v2) {
         return outerProduct(v1.begin(), v1.end(), v2.begin(), v2.end());
@@ -567,9 +567,15 @@ namespace QuantLib {
 
         Matrix result(size1, size2);
 
-        for (Size i=0; v1begin!=v1end; i++, v1begin++)
-            std::transform(v2begin, v2end, result.row_begin(i),
-                           std::bind1st(std::multiplies<Real>(), *v1begin));
+        // copy the second vector once; the iterators might be expensive
+        // to dereference
+        std::vector<Real> v2(v2begin, v2end);
+        for (Size i=0; v1begin!=v1end; i++, v1begin++) {
+            const Real v1i = *v1begin;
+            Matrix::row_iterator ri = result.row_begin(i);
+            for (Size j=0; j<size2; j++)
+                ri[j] = v1i*v2[j];
+        }
 
         return result;
     }
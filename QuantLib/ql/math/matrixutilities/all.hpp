@@ -11,6 +11,7 @@
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/matrixutilities/symmetriceigendecomposition.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
 #include <ql/math/matrixutilities/tapcorrelations.hpp>
 #include <ql/math/matrixutilities/tqreigendecomposition.hpp>
@@ -22,6 +22,7 @@
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/matrixutilities/symmetriceigendecomposition.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/optimization/conjugategradient.hpp>
 #include <ql/math/optimization/problem.hpp>
@@ -31,6 +32,35 @@ namespace QuantLib {
 
     namespace {
 
+        /* Spectral decomposition of a symmetric matrix. The Jacobi
+           algorithm is kept for small matrices, for which it is fast
+           enough; larger ones are tridiagonalized first, which is several
+           times faster. */
+        class SpectralDecomposition {
+          public:
+            SpectralDecomposition() {}
+            SpectralDecomposition(const Array& eigenvalues,
+                                  const Matrix& eigenvectors)
+            : eigenvalues_(eigenvalues), eigenvectors_(eigenvectors) {}
+            explicit SpectralDecomposition(const Matrix& m) {
+                static const Size householderThreshold = 50;
+                if (m.rows() < householderThreshold) {
+                    SymmetricSchurDecomposition jd(m);
+                    eigenvalues_ = jd.eigenvalues();
+                    eigenvectors_ = jd.eigenvectors();
+                } else {
+                    SymmetricEigenDecomposition ed(m);
+                    eigenvalues_ = ed.eigenvalues();
+                    eigenvectors_ = ed.eigenvectors();
+                }
+            }
+            const Array& eigenvalues() const { return eigenvalues_; }
+            const Matrix& eigenvectors() const { return eigenvectors_; }
+          private:
+            Array eigenvalues_;
+            Matrix eigenvectors_;
+        };
+
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         void checkSymmetry(const Matrix& matrix) {
             Size size = matrix.rows();
@@ -300,7 +330,7 @@ namespace QuantLib {
                        "matrix not square");
 
             Matrix diagonal(size, size, 0.0);
-            SymmetricSchurDecomposition jd(M);
+            SpectralDecomposition jd(M);
             for (Size i=0; i<size; ++i)
                 diagonal[i][i] = std::max<Real>(jd.eigenvalues()[i], 0.0);
 
@@ -351,8 +381,29 @@ namespace QuantLib {
     }
 
 
+    void SpectralDecompositionCache::decompose(const Matrix& m) {
+        if (matrix_.rows() == m.rows() && matrix_.columns() == m.columns() &&
+            std::equal(m.begin(), m.end(), matrix_.begin()))
+            return;
+
+        SpectralDecomposition jd(m);
+        eigenvalues_ = jd.eigenvalues();
+        eigenvectors_ = jd.eigenvectors();
+        matrix_ = m;
+        ++decompositions_;
+    }
+
+
     const Disposable<Matrix> pseudoSqrt(const Matrix& matrix,
                                         SalvagingAlgorithm::Type sa) {
+        SpectralDecompositionCache cache;
+        return pseudoSqrt(matrix, sa, cache);
+    }
+
+
+    const Disposable<Matrix> pseudoSqrt(const Matrix& matrix,
+                                        SalvagingAlgorithm::Type sa,
+                                        SpectralDecompositionCache& cache) {
         Size size = matrix.rows();
 
         #if defined(QL_EXTRA_SAFETY_CHECKS)
@@ -364,7 +415,8 @@ namespace QuantLib {
         #endif
 
         // spectral (a.k.a Principal Component) analysis
-        SymmetricSchurDecomposition jd(matrix);
+        cache.decompose(matrix);
+        SpectralDecomposition jd(cache.eigenvalues(), cache.eigenvectors());
         Matrix diagonal(size, size, 0.0);
 
         // salvaging algorithm
@@ -436,6 +488,17 @@ namespace QuantLib {
                                              Size maxRank,
                                              Real componentRetainedPercentage,
                                              SalvagingAlgorithm::Type sa) {
+        SpectralDecompositionCache cache;
+        return rankReducedSqrt(matrix, maxRank, componentRetainedPercentage,
+                               sa, cache);
+    }
+
+
+    const Disposable<Matrix> rankReducedSqrt(const Matrix& matrix,
+                                             Size maxRank,
+                                             Real componentRetainedPercentage,
+                                             SalvagingAlgorithm::Type sa,
+                                             SpectralDecompositionCache& cache) {
         Size size = matrix.rows();
 
         #if defined(QL_EXTRA_SAFETY_CHECKS)
@@ -456,7 +519,8 @@ namespace QuantLib {
                    "max rank required < 1");
 
         // spectral (a.k.a Principal Component) analysis
-        SymmetricSchurDecomposition jd(matrix);
+        cache.decompose(matrix);
+        SpectralDecomposition jd(cache.eigenvalues(), cache.eigenvectors());
         Array eigenValues = jd.eigenvalues();
 
         // salvaging algorithm
@@ -478,7 +542,7 @@ namespace QuantLib {
                   int maxIterations = 40;
                   Real tolerance = 1e-6;
                   Matrix adjustedMatrix = highamImplementation(matrix, maxIterations, tolerance);
-                  jd = SymmetricSchurDecomposition(adjustedMatrix);
+                  jd = SpectralDecomposition(adjustedMatrix);
                   eigenValues = jd.eigenvalues();
               }
               break;
@@ -33,6 +33,35 @@ namespace QuantLib {
         enum Type { None, Spectral, Hypersphere, LowerDiagonal, Higham };
     };
 
+    //! spectral decomposition kept across pseudo square roots
+    /*! Correlation repair and factor reduction often decompose the
+        same matrix over and over, e.g., for each time of a
+        time-homogeneous correlation or at each calibration.  A cache
+        passed to pseudoSqrt() or rankReducedSqrt() keeps the spectral
+        decomposition of the last matrix it was given and reuses it
+        when the same matrix is passed again.
+
+        \warning a cache is not thread-safe; each thread must use its
+                 own instance.
+    */
+    class SpectralDecompositionCache {
+      public:
+        SpectralDecompositionCache() : decompositions_(0) {}
+        //! decomposes the matrix unless it was the last one given
+        void decompose(const Matrix& m);
+        //! number of decompositions actually performed
+        Size decompositions() const { return decompositions_; }
+        //! eigenvalues of the last matrix, in decreasing order
+        const Array& eigenvalues() const { return eigenvalues_; }
+        //! eigenvectors of the last matrix
+        const Matrix& eigenvectors() const { return eigenvectors_; }
+      private:
+        Matrix matrix_;
+        Array eigenvalues_;
+        Matrix eigenvectors_;
+        Size decompositions_;
+    };
+
     //! Returns the pseudo square root of a real symmetric matrix
     /*! Given a matrix \f$ M \f$, the result \f$ S \f$ is defined
         as the matrix such that \f$ S S^T = M. \f$
@@ -65,6 +94,16 @@ namespace QuantLib {
                         const Matrix&,
                         SalvagingAlgorithm::Type = SalvagingAlgorithm::None);
 
+    //! Returns the pseudo square root of a real symmetric matrix
+    /*! As above, but the spectral decomposition is taken from the
+        given cache when the matrix is the same as in the last call.
+
+        \relates Matrix
+    */
+    const Disposable<Matrix> pseudoSqrt(const Matrix&,
+                                        SalvagingAlgorithm::Type,
+                                        SpectralDecompositionCache&);
+
     //! Returns the rank-reduced pseudo square root of a real symmetric matrix
     /*! The result matrix has rank<=maxRank. If maxRank>=size, then the
         specified percentage of eigenvalues out of the eigenvalues' sum is
@@ -83,6 +122,18 @@ namespace QuantLib {
                                              Real componentRetainedPercentage,
                                              SalvagingAlgorithm::Type);
 
+    //! Returns the rank-reduced pseudo square root of a real symmetric matrix
+    /*! As above, but the spectral decomposition is taken from the
+        given cache when the matrix is the same as in the last call.
+
+        \relates Matrix
+    */
+    const Disposable<Matrix> rankReducedSqrt(const Matrix&,
+                                             Size maxRank,
+                                             Real componentRetainedPercentage,
+                                             SalvagingAlgorithm::Type,
+                                             SpectralDecompositionCache&);
+
 }
 
 
@@ -0,0 +1,152 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/symmetriceigendecomposition.hpp>
+#include <ql/math/matrixutilities/tqreigendecomposition.hpp>
+
+namespace QuantLib {
+
+    SymmetricEigenDecomposition::SymmetricEigenDecomposition(const Matrix& s)
+    : diagonal_(s.rows()) {
+
+        QL_REQUIRE(s.rows() > 0 && s.columns() > 0, "null matrix given");
+        QL_REQUIRE(s.rows()==s.columns(), "input matrix must be square");
+
+        const Size n = s.rows();
+
+        /* Householder reduction to tridiagonal form (tred2 in Wilkinson
+           and Reinsch). The algorithm works on the lower triangle of the
+           matrix accessing it by columns; here it works on the transpose w,
+           i.e., w[j][k] holds the element (k,j), so that the inner loops
+           run along contiguous rows. At the end w holds the transpose of
+           the accumulated orthogonal transformation. */
+        Matrix w(s);
+        Array d(n), e(n, 0.0);
+        Size i, j, k;
+
+        for (j=0; j<n; ++j)
+            d[j] = w[j][n-1];
+
+        for (i=n-1; i>0; --i) {
+            Real scale = 0.0, h = 0.0;
+            for (k=0; k<i; ++k)
+                scale += std::fabs(d[k]);
+            if (scale == 0.0) {
+                e[i] = d[i-1];
+                for (j=0; j<i; ++j) {
+                    d[j] = w[j][i-1];
+                    w[j][i] = 0.0;
+                    w[i][j] = 0.0;
+                }
+            } else {
+                // generate Householder vector
+                for (k=0; k<i; ++k) {
+                    d[k] /= scale;
+                    h += d[k]*d[k];
+                }
+                Real f = d[i-1];
+                Real g = std::sqrt(h);
+                if (f > 0.0)
+                    g = -g;
+                e[i] = scale*g;
+                h -= f*g;
+                d[i-1] = f-g;
+                for (j=0; j<i; ++j)
+                    e[j] = 0.0;
+
+                // apply similarity transformation to remaining columns
+                for (j=0; j<i; ++j) {
+                    f = d[j];
+                    w[i][j] = f;
+                    Matrix::row_iterator wj = w.row_begin(j);
+                    g = e[j] + wj[j]*f;
+                    for (k=j+1; k<i; ++k) {
+                        g += wj[k]*d[k];
+                        e[k] += wj[k]*f;
+                    }
+                    e[j] = g;
+                }
+                f = 0.0;
+                for (j=0; j<i; ++j) {
+                    e[j] /= h;
+                    f += e[j]*d[j];
+                }
+                const Real hh = f/(h+h);
+                for (j=0; j<i; ++j)
+                    e[j] -= hh*d[j];
+                for (j=0; j<i; ++j) {
+                    f = d[j];
+                    g = e[j];
+                    Matrix::row_iterator wj = w.row_begin(j);
+                    for (k=j; k<i; ++k)
+                        wj[k] -= (f*e[k] + g*d[k]);
+                    d[j] = wj[i-1];
+                    wj[i] = 0.0;
+                }
+            }
+            d[i] = h;
+        }
+
+        // accumulate transformations
+        for (i=0; i+1<n; ++i) {
+            w[i][n-1] = w[i][i];
+            w[i][i] = 1.0;
+            const Real h = d[i+1];
+            Matrix::row_iterator wi1 = w.row_begin(i+1);
+            if (h != 0.0) {
+                for (k=0; k<=i; ++k)
+                    d[k] = wi1[k]/h;
+                for (j=0; j<=i; ++j) {
+                    Matrix::row_iterator wj = w.row_begin(j);
+                    Real g = 0.0;
+                    for (k=0; k<=i; ++k)
+                        g += wi1[k]*wj[k];
+                    for (k=0; k<=i; ++k)
+                        wj[k] -= g*d[k];
+                }
+            }
+            for (k=0; k<=i; ++k)
+                wi1[k] = 0.0;
+        }
+        for (j=0; j<n; ++j) {
+            d[j] = w[j][n-1];
+            w[j][n-1] = 0.0;
+        }
+        w[n-1][n-1] = 1.0;
+
+        // eigensystem of the tridiagonal matrix...
+        Array sub(n-1);
+        std::copy(e.begin()+1, e.end(), sub.begin());
+        TqrEigenDecomposition tqr(d, sub);
+
+        // ...rotated back by the Householder transformation
+        eigenVectors_ = transpose(w)*tqr.eigenvectors();
+
+        // eigenvalues are already sorted; check for round-off errors and
+        // use the same sign convention as the Schur decomposition
+        const Real maxEv = tqr.eigenvalues()[0];
+        for (j=0; j<n; ++j) {
+            const Real ev = tqr.eigenvalues()[j];
+            diagonal_[j] = (std::fabs(ev/maxEv)<1e-16 ? 0.0 : ev);
+            if (eigenVectors_[0][j] < 0.0) {
+                for (i=0; i<n; ++i)
+                    eigenVectors_[i][j] = -eigenVectors_[i][j];
+            }
+        }
+    }
+
+}
@@ -0,0 +1,68 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file symmetriceigendecomposition.hpp
+    \brief Eigenvalues/eigenvectors of a real symmetric matrix by
+           Householder tridiagonalization and tridiagonal QR
+*/
+
+#ifndef quantlib_symmetric_eigen_decomposition_hpp
+#define quantlib_symmetric_eigen_decomposition_hpp
+
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! Householder tridiagonalization followed by tridiagonal QR
+    /*! The symmetric matrix is reduced to tridiagonal form by Householder
+        reflections, whose product is accumulated; the eigensystem of the
+        tridiagonal matrix is then obtained by TqrEigenDecomposition and
+        rotated back. The cost is \f$ O(n^3) \f$ with a much smaller
+        constant than the Jacobi sweeps of SymmetricSchurDecomposition,
+        which makes it preferable for large matrices.
+
+        The interface and conventions are the ones of
+        SymmetricSchurDecomposition: eigenvalues are sorted in decreasing
+        order and the first component of each eigenvector is non negative.
+
+        References:
+
+        Wilkinson, J.H. and Reinsch, C. 1971, Linear Algebra, vol. II of
+        Handbook for Automatic Computation (New York: Springer-Verlag)
+
+        "Matrix computation," second edition, by Golub and Van Loan,
+        The Johns Hopkins University Press
+
+        \test the correctness of the returned values is tested by
+              checking their properties and comparing them with the
+              ones of SymmetricSchurDecomposition.
+    */
+    class SymmetricEigenDecomposition {
+      public:
+        /*! \pre s must be symmetric */
+        SymmetricEigenDecomposition(const Matrix& s);
+        const Array& eigenvalues() const { return diagonal_; }
+        const Matrix& eigenvectors() const { return eigenVectors_; }
+      private:
+        Array diagonal_;
+        Matrix eigenVectors_;
+    };
+
+}
+
+
+#endif
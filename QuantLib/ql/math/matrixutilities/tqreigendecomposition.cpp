@@ -41,8 +41,12 @@ namespace QuantLib {
         Array e(n, 0.0);
         std::copy(sub.begin(),sub.end(),e.begin()+1);
         Size i;
-        for (i=0; i < ev_.rows(); ++i) {
-            ev_[i][i] = 1.0;
+        // the rotations are applied to the rows of the transposed
+        // eigenvector matrix, which are contiguous in memory
+        const Size m = ev_.rows();
+        Matrix evT(n, m, 0.0);
+        for (i=0; i < m; ++i) {
+            evT[i][i] = 1.0;
         }
 
         for (Size k=n-1; k >=1; --k) {
@@ -96,10 +100,12 @@ namespace QuantLib {
                         d_[i-1] = g + u;
                         q = cosine*t - h;
 
-                        for (Size j=0; j < ev_.rows(); ++j) {
-                            const Real tmp = ev_[j][i-1];
-                            ev_[j][i-1] = sine*ev_[j][i] + cosine*tmp;
-                            ev_[j][i] = cosine*ev_[j][i] - sine*tmp;
+                        Matrix::row_iterator v0 = evT.row_begin(i-1);
+                        Matrix::row_iterator v1 = evT.row_begin(i);
+                        for (Size j=0; j < m; ++j) {
+                            const Real tmp = v0[j];
+                            v0[j] = sine*v1[j] + cosine*tmp;
+                            v1[j] = cosine*v1[j] - sine*tmp;
                         }
                     } else {
                         // recover from underflow
@@ -120,11 +126,11 @@ namespace QuantLib {
         // sort (eigenvalues, eigenvectors),
         // code taken from symmetricSchureDecomposition.cpp
         std::vector<std::pair<Real, std::vector<Real> > > temp(n);
-        std::vector<Real> eigenVector(ev_.rows());
+        std::vector<Real> eigenVector(m);
         for (i=0; i<n; i++) {
-            if (ev_.rows() > 0)
-                std::copy(ev_.column_begin(i),
-                          ev_.column_end(i), eigenVector.begin());
+            if (m > 0)
+                std::copy(evT.row_begin(i),
+                          evT.row_end(i), eigenVector.begin());
             temp[i] = std::make_pair(d_[i], eigenVector);
         }
         std::sort(temp.begin(), temp.end(),
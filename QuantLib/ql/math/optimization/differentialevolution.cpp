@@ -259,13 +259,35 @@ namespace QuantLib {
                                - lowerBound_[memIter]);
                 }
             }
-            // evaluate objective function as soon as possible to avoid unnecessary loops
+        }
+        // the costs are evaluated once all trial vectors are drawn,
+        // so that they can be calculated concurrently
+        evaluateCosts(population, costFunction, true);
+    }
+
+    void DifferentialEvolution::evaluateCosts(
+                                      std::vector<Candidate>& population,
+                                      const CostFunction& costFunction,
+                                      bool penalizeErrors) const {
+        const long n = static_cast<long>(population.size());
+        std::vector<std::string> errors(population.size());
+        #pragma omp parallel for schedule(dynamic) \
+                                 if(configuration().concurrentEvaluation)
+        for (long i=0; i<n; ++i) {
+            // exceptions can not leave the parallel region
             try {
-                population[popIter].cost = costFunction.value(population[popIter].values);
-            } catch (Error&) {
-                population[popIter].cost = QL_MAX_REAL;
+                population[i].cost = costFunction.value(population[i].values);
+            } catch (Error& e) {
+                if (penalizeErrors)
+                    population[i].cost = QL_MAX_REAL;
+                else
+                    errors[i] = e.what();
+            } catch (std::exception& e) {
+                errors[i] = e.what();
             }
         }
+        for (Size i=0; i<population.size(); ++i)
+            QL_REQUIRE(errors[i].empty(), errors[i]);
     }
 
     void DifferentialEvolution::getCrossoverMask(
@@ -344,15 +366,14 @@ namespace QuantLib {
 
         // use initial values provided by the user
         population.front().values = p.currentValue();
-        population.front().cost = p.costFunction().value(population.front().values);
         // rest of the initial population is random
         for (Size j = 1; j < population.size(); ++j) {
             for (Size i = 0; i < p.currentValue().size(); ++i) {
                 Real l = lowerBound_[i], u = upperBound_[i];
                 population[j].values[i] = l + (u-l)*rng_.nextReal();
             }
-            population[j].cost = p.costFunction().value(population[j].values);
         }
+        evaluateCosts(population, p.costFunction(), false);
     }
 
 }
@@ -50,6 +50,12 @@ namespace QuantLib {
         3) various weights distributions for the differences (dither etc.)
         4) printFullInfo parameter usage to track the algorithm
 
+        The members of a generation are independent of each other; if
+        concurrent evaluation is enabled in the configuration and the
+        library is compiled with OpenMP, their costs are calculated in
+        parallel. The trial vectors are generated beforehand, so that
+        the results don't depend on the number of threads.
+
         \warning This was reported to fail tests on Mac OS X 10.8.4.
     */
 
@@ -86,7 +92,7 @@ namespace QuantLib {
             Size populationMembers;
             Real stepsizeWeight, crossoverProbability;
             unsigned long seed;
-            bool applyBounds, crossoverIsAdaptive;
+            bool applyBounds, crossoverIsAdaptive, concurrentEvaluation;
 
             Configuration()
             : strategy(BestMemberWithJitter),
@@ -96,7 +102,8 @@ namespace QuantLib {
               crossoverProbability(0.9),
               seed(0),
               applyBounds(true),
-              crossoverIsAdaptive(false) {}
+              crossoverIsAdaptive(false),
+              concurrentEvaluation(false) {}
 
             Configuration& withBounds(bool b = true) {
                 applyBounds = b;
@@ -127,6 +134,18 @@ namespace QuantLib {
                 return *this;
             }
 
+            /*! \warning the value() method of the cost function will
+                         be called from different threads at the same
+                         time; it must not modify shared state. This
+                         is not the case, e.g., for the cost functions
+                         used by CalibratedModel::calibrate, which set
+                         the model parameters.
+            */
+            Configuration& withConcurrentEvaluation(bool b = true) {
+                concurrentEvaluation = b;
+                return *this;
+            }
+
             Configuration& withStepsizeWeight(Real w) {
                 QL_ENSURE(w>=0 && w<=2.0,
                           "Step size weight ("<< w
@@ -181,6 +200,10 @@ namespace QuantLib {
         void calculateNextGeneration(std::vector<Candidate>& population,
                                      const CostFunction& costFunction) const;
 
+        void evaluateCosts(std::vector<Candidate>& population,
+                           const CostFunction& costFunction,
+                           bool penalizeErrors) const;
+
         Array rotateArray(Array inputArray) const;
 
         void crossover(const std::vector<Candidate>& oldPopulation,
@@ -113,12 +113,16 @@ namespace QuantLib {
     };
 
     // inline definitions
+    // the counter is updated atomically so that optimization methods
+    // can evaluate thread-safe cost functions concurrently
     inline Real Problem::value(const Array& x) {
+        #pragma omp atomic
         ++functionEvaluation_;
         return costFunction_.value(x);
     }
 
     inline Disposable<Array> Problem::values(const Array& x) {
+        #pragma omp atomic
         ++functionEvaluation_;
         return costFunction_.values(x);
     }
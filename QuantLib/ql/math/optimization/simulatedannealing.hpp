@@ -38,6 +38,15 @@ namespace QuantLib {
             RNG::sample_type RNG::next() const;
         \endcode
 
+        If concurrent evaluation is requested and the library is
+        compiled with OpenMP, the vertices of the initial simplex and
+        of each contraction around the best vertex, which are
+        independent of each other, are evaluated in parallel.
+
+        \warning with concurrent evaluation, the value() method of the
+                 cost function is called from different threads at the
+                 same time; it must not modify shared state.
+
         \ingroup optimizers
     */
 
@@ -54,9 +63,11 @@ namespace QuantLib {
         /*! reduce temperature T by a factor of \f$ (1-\epsilon) \f$ after m moves */
         SimulatedAnnealing(const Real lambda, const Real T0,
                            const Real epsilon, const Size m,
-                           const RNG &rng = RNG())
+                           const RNG &rng = RNG(),
+                           bool concurrentEvaluation = false)
             : scheme_(ConstantFactor), lambda_(lambda), T0_(T0),
-              epsilon_(epsilon), alpha_(0.0), K_(0), rng_(rng), m_(m) {}
+              epsilon_(epsilon), alpha_(0.0), K_(0), rng_(rng),
+              concurrentEvaluation_(concurrentEvaluation), m_(m) {}
 
         /*! budget a total of K moves, set temperature T to the initial
           temperature times \f$ ( 1 - k/K )^\alpha \f$ with k being the total number
@@ -65,9 +76,11 @@ namespace QuantLib {
           algorithm.
         */
         SimulatedAnnealing(const Real lambda, const Real T0, const Size K,
-                           const Real alpha, const RNG &rng = RNG())
+                           const Real alpha, const RNG &rng = RNG(),
+                           bool concurrentEvaluation = false)
             : scheme_(ConstantBudget), lambda_(lambda), T0_(T0), epsilon_(0.0),
-              alpha_(alpha), K_(K), rng_(rng) {}
+              alpha_(alpha), K_(K), rng_(rng),
+              concurrentEvaluation_(concurrentEvaluation) {}
 
         EndCriteria::Type minimize(Problem &P, const EndCriteria &ec);
 
@@ -77,9 +90,11 @@ namespace QuantLib {
         const Real lambda_, T0_, epsilon_, alpha_;
         const Size K_;
         const RNG rng_;
+        const bool concurrentEvaluation_;
 
         Real simplexSize();
         void amotsa(Problem &, Real);
+        void evaluateVertices(Problem &, bool checkValues);
 
         Real T_;
         std::vector<Array> vertices_;
@@ -137,6 +152,33 @@ namespace QuantLib {
         return;
     }
 
+    template <class RNG>
+    void SimulatedAnnealing<RNG>::evaluateVertices(Problem &P,
+                                                   bool checkValues) {
+        // all vertices but the lowest one, which are independent
+        const long n = static_cast<long>(n_);
+        const long lowest = static_cast<long>(ilo_);
+        std::vector<std::string> errors(n_ + 1);
+        #pragma omp parallel for schedule(dynamic) if(concurrentEvaluation_)
+        for (long i = 0; i <= n; i++) {
+            if (i == lowest)
+                continue;
+            // exceptions can not leave the parallel region
+            try {
+                if (checkValues && !P.constraint().test(vertices_[i]))
+                    values_[i] = QL_MAX_REAL;
+                else
+                    values_[i] = P.value(vertices_[i]);
+                if (checkValues && boost::math::isnan(values_[i]))
+                    values_[i] = QL_MAX_REAL;
+            } catch (std::exception &e) {
+                errors[i] = e.what();
+            }
+        }
+        for (Size i = 0; i < errors.size(); i++)
+            QL_REQUIRE(errors[i].empty(), errors[i]);
+    }
+
     template <class RNG>
     EndCriteria::Type SimulatedAnnealing<RNG>::minimize(Problem &P,
                                                         const EndCriteria &ec) {
@@ -158,15 +200,8 @@ namespace QuantLib {
             P.constraint().update(vertices_[i_ + 1], direction, lambda_);
         }
         values_ = Array(n_ + 1, 0.0);
-        for (i_ = 0; i_ <= n_; i_++) {
-            if (!P.constraint().test(vertices_[i_]))
-                values_[i_] = QL_MAX_REAL;
-            else
-                values_[i_] = P.value(vertices_[i_]);
-            if (boost::math::isnan(ytry_)) { // handle NAN
-                values_[i_] = QL_MAX_REAL;
-            }
-        }
+        ilo_ = -1; // no vertex is skipped
+        evaluateVertices(P, true);
 
         // minimize
 
@@ -235,14 +270,13 @@ namespace QuantLib {
                         if (ytry_ >= ysave_) {
                             for (i_ = 0; i_ < n_ + 1; i_++) {
                                 if (i_ != ilo_) {
-                                    for (j_ = 0; j_ < n_; j_++) {
-                                        sum_[j_] = 0.5 * (vertices_[i_][j_] +
-                                                          vertices_[ilo_][j_]);
-                                        vertices_[i_][j_] = sum_[j_];
-                                    }
-                                    values_[i_] = P.value(sum_);
+                                    for (j_ = 0; j_ < n_; j_++)
+                                        vertices_[i_][j_] =
+                                            0.5 * (vertices_[i_][j_] +
+                                                   vertices_[ilo_][j_]);
                                 }
                             }
+                            evaluateVertices(P, false);
                             iteration_ += n_;
                             for (i_ = 0; i_ < n_; i_++)
                                 sum_[i_] = 0.0;
@@ -48,6 +48,11 @@ namespace QuantLib {
         explicit BoxMullerGaussianRng(const RNG& uniformGenerator);
         //! returns a sample from a Gaussian distribution
         sample_type next() const;
+        //! writes the next \f$ n \f$ deviates into the buffer
+        void fill(Real* output, Size n) const {
+            for (Size i=0; i<n; ++i)
+                output[i] = next().value;
+        }
       private:
         RNG uniformGenerator_;
         mutable bool returnFirst_;
@@ -30,6 +30,7 @@
 #include <ql/math/randomnumbers/haltonrsg.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/primenumbers.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -55,6 +56,23 @@ namespace QuantLib {
     }
 
     const HaltonRsg::sample_type& HaltonRsg::nextSequence() const {
+        draw(&sequence_.value[0]);
+        return sequence_;
+    }
+
+    void HaltonRsg::fill(Real* output, Size samples) const {
+        for (Size j=0; j<samples; ++j, output += dimensionality_)
+            draw(output);
+        if (samples > 0)
+            std::copy(output-dimensionality_, output,
+                      sequence_.value.begin());
+    }
+
+    void HaltonRsg::skipTo(unsigned long n) {
+        sequenceCounter_ = n;
+    }
+
+    void HaltonRsg::draw(Real* output) const {
         ++sequenceCounter_;
         unsigned long b, k;
         double f, h;
@@ -68,10 +86,9 @@ namespace QuantLib {
                 h += (k%b)*f;
                 k /= b;
             }
-            sequence_.value[i] = h+randomShift_[i];
-            sequence_.value[i] -= long(sequence_.value[i]);
+            output[i] = h+randomShift_[i];
+            output[i] -= long(output[i]);
         }
-        return sequence_;
     }
 
 }
@@ -48,11 +48,18 @@ namespace QuantLib {
                   bool randomStart = true,
                   bool randomShift = false);
         const sample_type& nextSequence() const;
+        /*! writes the next \f$ samples \f$ draws one after the other
+            into the buffer, which must hold at least
+            \f$ samples \times dimension \f$ values. */
+        void fill(Real* output, Size samples) const;
+        /*! skip to the n-th sample in the low-discrepancy sequence */
+        void skipTo(unsigned long n);
         const sample_type& lastSequence() const {
             return sequence_;
         }
         Size dimension() const {return dimensionality_;}
       private:
+        void draw(Real* output) const;
         Size dimensionality_;
         mutable unsigned long sequenceCounter_;
         mutable sample_type sequence_;
@@ -25,7 +25,7 @@
 #ifndef quantlib_inversecumulative_rng_h
 #define quantlib_inversecumulative_rng_h
 
-#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/randomnumbers/inversecumulativersg.hpp>
 
 namespace QuantLib {
 
@@ -41,6 +41,10 @@ namespace QuantLib {
         \code
             RNG::sample_type RNG::next() const;
         \endcode
+        and, if the fill method is used,
+        \code
+            void RNG::fill(Real* output, Size n) const;
+        \endcode
 
         The inverse cumulative distribution is supplied by IC.
 
@@ -58,6 +62,11 @@ namespace QuantLib {
         explicit InverseCumulativeRng(const RNG& uniformGenerator);
         //! returns a sample from a Gaussian distribution
         sample_type next() const;
+        //! writes the next \f$ n \f$ deviates into the buffer
+        void fill(Real* output, Size n) const {
+            uniformGenerator_.fill(output, n);
+            detail::inverseCumulativeTransform(ICND_, output, n);
+        }
       private:
         RNG uniformGenerator_;
         IC ICND_;
@@ -26,7 +26,9 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -51,6 +53,10 @@ namespace QuantLib {
             IC::IC();
             Real IC::operator() const;
         \endcode
+        The fill method also requires
+        \code
+            void USG::fill(Real* output, Size samples) const;
+        \endcode
     */
     template <class USG, class IC>
     class InverseCumulativeRsg {
@@ -61,7 +67,16 @@ namespace QuantLib {
                              const IC& inverseCumulative);
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
+        /*! writes the next \f$ samples \f$ draws one after the other
+            into the buffer, which must hold at least
+            \f$ samples \times dimension \f$ values. */
+        void fill(Real* output, Size samples) const;
         const sample_type& lastSequence() const { return x_; }
+        /*! skip to the n-th sample of the underlying sequence; only
+            available if USG provides a skipTo(unsigned long) method. */
+        void skipTo(unsigned long n) {
+            uniformSequenceGenerator_.skipTo(n);
+        }
         Size dimension() const { return dimension_; }
       private:
         USG uniformSequenceGenerator_;
@@ -84,6 +99,23 @@ namespace QuantLib {
       x_(std::vector<Real> (dimension_), 1.0),
       ICD_(inverseCum) {}
 
+    namespace detail {
+
+        template <class IC>
+        inline void inverseCumulativeTransform(const IC& ic,
+                                               Real* x, Size n) {
+            for (Size i=0; i<n; ++i)
+                x[i] = ic(x[i]);
+        }
+
+        inline void inverseCumulativeTransform(
+                                        const InverseCumulativeNormal& ic,
+                                        Real* x, Size n) {
+            ic.transform(x, n);
+        }
+
+    }
+
     template <class USG, class IC>
     inline const typename InverseCumulativeRsg<USG, IC>::sample_type&
     InverseCumulativeRsg<USG, IC>::nextSequence() const {
@@ -96,6 +128,19 @@ namespace QuantLib {
         return x_;
     }
 
+    template <class USG, class IC>
+    inline void InverseCumulativeRsg<USG, IC>::fill(Real* output,
+                                                    Size samples) const {
+        uniformSequenceGenerator_.fill(output, samples);
+        detail::inverseCumulativeTransform(ICD_, output,
+                                           samples*dimension_);
+        if (samples > 0) {
+            x_.weight = uniformSequenceGenerator_.lastSequence().weight;
+            std::copy(output+(samples-1)*dimension_,
+                      output+samples*dimension_, x_.value.begin());
+        }
+    }
+
 }
 
 
@@ -68,6 +68,7 @@
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -122,6 +123,26 @@ namespace QuantLib {
         mt[0] = UPPER_MASK; /*MSB is 1; assuring non-zero initial array*/
     }
 
+    void MersenneTwisterUniformRng::fill(Real* output, Size n) const {
+        while (n > 0) {
+            if (mti==N)
+                twist();
+            const Size block = std::min(n, N-mti);
+            const unsigned long* state = mt+mti;
+            for (Size i=0; i<block; ++i) {
+                unsigned long y = state[i];
+                y ^= (y >> 11);
+                y ^= (y << 7) & 0x9d2c5680UL;
+                y ^= (y << 15) & 0xefc60000UL;
+                y ^= (y >> 18);
+                output[i] = (Real(y) + 0.5)/4294967296.0;
+            }
+            mti += block;
+            output += block;
+            n -= block;
+        }
+    }
+
     void MersenneTwisterUniformRng::twist() const {
         static const unsigned long mag01[2]={0x0UL, MATRIX_A};
         /* mag01[x] = x * MATRIX_A  for x=0,1 */
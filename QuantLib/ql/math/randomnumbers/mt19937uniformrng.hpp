@@ -70,6 +70,11 @@ namespace QuantLib {
             y ^= (y >> 18);
             return y;
         }
+        /*! writes the next \f$ n \f$ random numbers in the (0.0, 1.0)
+            interval into the buffer; the numbers are the same that
+            \f$ n \f$ calls to nextReal() would return, but they are
+            tempered one state block at a time. */
+        void fill(Real* output, Size n) const;
       private:
         void seedInitialization(unsigned long seed);
         void twist() const;
@@ -26,6 +26,7 @@
 
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -43,6 +44,8 @@ namespace QuantLib {
             LDS::sample_type LDS::nextSequence() const;
             Size LDS::dimension() const;
         \endcode
+        The skipTo() and fill() methods are only available if LDS
+        provides them with the same signature.
 
         \pre LDS and PRS must have the same dimension \f$ N \f$
 
@@ -66,6 +69,16 @@ namespace QuantLib {
                       BigNatural prsSeed = 0);
         //! returns next sample using a given randomizing vector
         const sample_type& nextSequence() const;
+        /*! writes the next \f$ samples \f$ draws one after the other
+            into the buffer, which must hold at least
+            \f$ samples \times dimension \f$ values. */
+        void fill(Real* output, Size samples) const;
+        /*! re-initialize the low discrepancy generator and skip to its
+            n-th sample; the randomizing vector is not changed. */
+        void skipTo(unsigned long n) {
+            ldsg_ = pristineldsg_;
+            ldsg_.skipTo(n);
+        }
         const sample_type& lastSequence() const {
             return x;
         }
@@ -133,6 +146,23 @@ namespace QuantLib {
     return x;
     }
 
+    template <class LDS, class PRS>
+    void RandomizedLDS<LDS, PRS>::fill(Real* output, Size samples) const {
+        ldsg_.fill(output, samples);
+        for (Size j=0; j<samples; ++j) {
+            for (Size i = 0; i < dimension_; i++) {
+                output[i] += randomizer_.value[i];
+                if (output[i]>1.0)
+                    output[i] -= 1.0;
+            }
+            output += dimension_;
+        }
+        if (samples > 0) {
+            x.weight = randomizer_.weight * ldsg_.lastSequence().weight;
+            std::copy(output-dimension_, output, x.value.begin());
+        }
+    }
+
 }
 
 
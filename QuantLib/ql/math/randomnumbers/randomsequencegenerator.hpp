@@ -27,6 +27,7 @@
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -43,6 +44,10 @@ namespace QuantLib {
         \code
             unsigned long RNG::nextInt32() const;
         \endcode
+        and the fill method needs
+        \code
+            void RNG::fill(Real* output, Size n) const;
+        \endcode
 
         \warning do not use with low-discrepancy sequence generator.
     */
@@ -74,6 +79,18 @@ namespace QuantLib {
             }
             return sequence_;
         }
+        /*! writes the next \f$ samples \f$ draws one after the other
+            into the buffer, which must hold at least
+            \f$ samples \times dimension \f$ values. */
+        void fill(Real* output, Size samples) const {
+            rng_.fill(output, samples*dimensionality_);
+            if (samples > 0) {
+                sequence_.weight = 1.0;
+                std::copy(output+(samples-1)*dimensionality_,
+                          output+samples*dimensionality_,
+                          sequence_.value.begin());
+            }
+        }
         std::vector<BigNatural> nextInt32Sequence() const {
             for (Size i=0; i<dimensionality_; i++) {
                 int32Sequence_[i] = rng_.nextInt32();
@@ -64,7 +64,12 @@ namespace QuantLib {
 
 
     //! default traits for pseudo-random number generation
-    /*! \test a sequence generator is generated and tested by comparing
+    /*! Both rng_type and rsg_type provide a fill() method drawing a
+        block of Gaussian deviates at once; the uniform deviates are
+        tempered one Mersenne-Twister state block at a time and then
+        transformed by the block version of InverseCumulativeNormal.
+
+        \test a sequence generator is generated and tested by comparing
               samples against known good values.
     */
     typedef GenericPseudoRandom<MersenneTwisterUniformRng,
@@ -101,6 +106,9 @@ namespace QuantLib {
 
 
     //! default traits for low-discrepancy sequence generation
+    /*! rsg_type provides a fill() method drawing a block of Gaussian
+        sequences at once.
+    */
     typedef GenericLowDiscrepancy<SobolRsg,
                                   InverseCumulativeNormal> LowDiscrepancy;
 
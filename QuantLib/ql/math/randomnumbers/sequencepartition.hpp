@@ -0,0 +1,100 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file sequencepartition.hpp
+    \brief Disjoint slices of a low-discrepancy sequence
+*/
+
+#ifndef quantlib_sequence_partition_hpp
+#define quantlib_sequence_partition_hpp
+
+#include <ql/errors.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    //! Disjoint contiguous slices of a low-discrepancy sequence
+    /*! Splits the first \f$ samples \f$ draws of a sequence into
+        consecutive blocks, so that each of a number of workers can draw
+        its own block with an independent copy of the generator and the
+        union of the draws is exactly the sequence that a single
+        generator would have returned. Unlike leap-frogging, this keeps
+        the low-discrepancy properties of the whole set of points.
+
+        For Sobol sequences, the points of a block of \f$ 2^m \f$ draws
+        starting at a multiple of \f$ 2^m \f$ form a (t,m,s)-net; a
+        power-of-two granularity makes every full slice such a block.
+
+        Class RSG must be copyable and implement
+        \code
+            void RSG::skipTo(unsigned long n);
+        \endcode
+        positioning a generator which has not been drawn from yet on
+        the n-th point of its sequence, as SobolRsg, HaltonRsg,
+        RandomizedLDS, LatticeRsg and SobolBrownianBridgeRsg do.
+    */
+    template <class RSG>
+    class SequencePartition {
+      public:
+        /*!
+            @param generator   Generator not drawn from yet.
+            @param samples     Total number of draws to be partitioned.
+            @param slices      Number of slices, usually the number of
+                               workers.
+            @param granularity The size of each slice but the last one
+                               is a multiple of this number.
+        */
+        SequencePartition(const RSG& generator,
+                          unsigned long samples,
+                          Size slices,
+                          unsigned long granularity = 1)
+        : generator_(generator), samples_(samples), slices_(slices) {
+            QL_REQUIRE(slices > 0, "null number of slices");
+            QL_REQUIRE(granularity > 0, "null granularity");
+            blockSize_ = (samples + slices - 1) / slices;
+            blockSize_ = ((blockSize_ + granularity - 1) / granularity)
+                         * granularity;
+        }
+        //! number of slices; some of the last ones might be empty
+        Size size() const { return slices_; }
+        //! index in the sequence of the first draw of the i-th slice
+        unsigned long start(Size i) const {
+            QL_REQUIRE(i < slices_, "slice " << i << " out of range");
+            return std::min<unsigned long>(i*blockSize_, samples_);
+        }
+        //! number of draws in the i-th slice
+        unsigned long samples(Size i) const {
+            unsigned long first = start(i);
+            return std::min<unsigned long>(blockSize_, samples_ - first);
+        }
+        //! generator returning the draws of the i-th slice
+        RSG slice(Size i) const {
+            RSG generator(generator_);
+            generator.skipTo(start(i));
+            return generator;
+        }
+      private:
+        RSG generator_;
+        unsigned long samples_;
+        Size slices_;
+        unsigned long blockSize_;
+    };
+
+}
+
+
+#endif
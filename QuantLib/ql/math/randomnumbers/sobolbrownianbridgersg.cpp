@@ -48,6 +48,23 @@ namespace QuantLib {
         return seq_;
     }
 
+    void SobolBrownianBridgeRsg::fill(Real* output, Size samples) const {
+        std::vector<Real> step(factors_);
+        for (Size j=0; j<samples; ++j) {
+            gen_.nextPath();
+            for (Size i=0; i < steps_; ++i) {
+                gen_.nextStep(step);
+                output = std::copy(step.begin(), step.end(), output);
+            }
+        }
+        if (samples > 0)
+            std::copy(output-dim_, output, seq_.value.begin());
+    }
+
+    void SobolBrownianBridgeRsg::skipTo(unsigned long n) {
+        gen_.skipTo(n);
+    }
+
     const SobolBrownianBridgeRsg::sample_type&
     SobolBrownianBridgeRsg::lastSequence() const {
         return seq_;
@@ -41,6 +41,13 @@ namespace QuantLib {
                                    = SobolRsg::JoeKuoD7);
 
         const sample_type& nextSequence() const;
+        /*! writes the next \f$ samples \f$ draws one after the other
+            into the buffer, which must hold at least
+            \f$ samples \times dimension \f$ values. */
+        void fill(Real* output, Size samples) const;
+        /*! skip to the n-th sample; the generator must not have been
+            used yet. */
+        void skipTo(unsigned long n);
         const sample_type& lastSequence() const;
         Size dimension() const;
 
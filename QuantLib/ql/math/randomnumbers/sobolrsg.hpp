@@ -28,6 +28,7 @@
 
 #include <ql/methods/montecarlo/sample.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -117,7 +118,11 @@ namespace QuantLib {
         SobolRsg(Size dimensionality,
                  unsigned long seed = 0,
                  DirectionIntegers directionIntegers = Jaeckel);
-        /*! skip to the n-th sample in the low-discrepancy sequence */
+        /*! skip to the n-th sample in the low-discrepancy sequence;
+            the cost is proportional to the number of bits of n rather
+            than to n itself, so that disjoint slices of the sequence can
+            be handed out to different workers (see SequencePartition.)
+        */
         void skipTo(unsigned long n);
         const std::vector<unsigned long>& nextInt32Sequence() const;
         const SobolRsg::sample_type& nextSequence() const {
@@ -127,6 +132,10 @@ namespace QuantLib {
                 sequence_.value[k] = v[k] * normalizationFactor_;
             return sequence_;
         }
+        /*! writes the next \f$ samples \f$ draws one after the other
+            into the buffer, which must hold at least
+            \f$ samples \times dimension \f$ values. */
+        void fill(Real* output, Size samples) const;
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
       private:
@@ -140,6 +149,21 @@ namespace QuantLib {
         std::vector<std::vector<unsigned long> > directionIntegers_;
     };
 
+
+    // inline definitions
+
+    inline void SobolRsg::fill(Real* output, Size samples) const {
+        for (Size j=0; j<samples; ++j) {
+            const std::vector<unsigned long>& v = nextInt32Sequence();
+            for (Size k=0; k<dimensionality_; ++k)
+                output[k] = v[k] * normalizationFactor_;
+            output += dimensionality_;
+        }
+        if (samples > 0)
+            std::copy(output-dimensionality_, output,
+                      sequence_.value.begin());
+    }
+
 }
 
 #endif
@@ -20,7 +20,8 @@
 */
 
 #include <ql/math/statistics/incrementalstatistics.hpp>
-#include <iomanip>
+#include <algorithm>
+#include <limits>
 
 namespace QuantLib {
 
@@ -29,28 +30,23 @@ namespace QuantLib {
     }
 
     Size IncrementalStatistics::samples() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::count>(acc_);
+        return samples_;
     }
 
     Real IncrementalStatistics::weightSum() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::sum_of_weights>(acc_);
+        return weightSum_;
     }
 
     Real IncrementalStatistics::mean() const {
         QL_REQUIRE(weightSum() > 0.0, "sampleWeight_= 0, unsufficient");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::weighted_mean>(acc_);
+        return mean_;
     }
 
     Real IncrementalStatistics::variance() const {
         QL_REQUIRE(weightSum() > 0.0, "sampleWeight_= 0, unsufficient");
         QL_REQUIRE(samples() > 1, "sample number <= 1, unsufficient");
         Real n = static_cast<Real>(samples());
-        return n / (n - 1.0) *
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::weighted_variance>(acc_);
+        return n / (n - 1.0) * m2_ / weightSum_;
     }
 
     Real IncrementalStatistics::standardDeviation() const {
@@ -66,47 +62,37 @@ namespace QuantLib {
         Real n = static_cast<Real>(samples());
         Real r1 = n / (n - 2.0);
         Real r2 = (n - 1.0) / (n - 2.0);
-        return std::sqrt(r1 * r2) * 
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::weighted_skewness>(acc_);
+        Real m2 = m2_ / weightSum_, m3 = m3_ / weightSum_;
+        return std::sqrt(r1 * r2) * m3 / std::pow(m2, 1.5);
     }
 
     Real IncrementalStatistics::kurtosis() const {
         QL_REQUIRE(samples() > 3,
                    "sample number <= 3, unsufficient");
-        boost::accumulators::extract_result<
-            boost::accumulators::tag::weighted_kurtosis>(acc_);
         Real n = static_cast<Real>(samples());
         Real r1 = (n - 1.0) / (n - 2.0);
         Real r2 = (n + 1.0) / (n - 3.0);
         Real r3 = (n - 1.0) / (n - 3.0);
-        return ((3.0 + boost::accumulators::extract_result<
-                           boost::accumulators::tag::weighted_kurtosis>(acc_)) *
-                    r2 -
-                3.0 * r3) *
-               r1;
+        Real m2 = m2_ / weightSum_, m4 = m4_ / weightSum_;
+        return (m4 / (m2 * m2) * r2 - 3.0 * r3) * r1;
     }
 
     Real IncrementalStatistics::min() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::min>(acc_);
+        return min_;
     }
 
     Real IncrementalStatistics::max() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::max>(acc_);
+        return max_;
     }
 
     Size IncrementalStatistics::downsideSamples() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::count>(downsideAcc_);
+        return downsideSamples_;
     }
 
     Real IncrementalStatistics::downsideWeightSum() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::sum_of_weights>(downsideAcc_);
+        return downsideWeightSum_;
     }
 
     Real IncrementalStatistics::downsideVariance() const {
@@ -114,9 +100,7 @@ namespace QuantLib {
         QL_REQUIRE(downsideSamples() > 1, "sample number <= 1, unsufficient");
         Real n = static_cast<Real>(downsideSamples());
         Real r1 = n / (n - 1.0);
-        return r1 *
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::moment<2> >(downsideAcc_);
+        return r1 * downsideSquareSum_ / downsideWeightSum_;
     }
 
     Real IncrementalStatistics::downsideDeviation() const {
@@ -126,14 +110,69 @@ namespace QuantLib {
     void IncrementalStatistics::add(Real value, Real valueWeight) {
         QL_REQUIRE(valueWeight >= 0.0, "negative weight (" << valueWeight
                                                            << ") not allowed");
-        acc_(value, boost::accumulators::weight = valueWeight);
-        if(value < 0.0)
-            downsideAcc_(value, boost::accumulators::weight = valueWeight);
+        addMoments(1, valueWeight, value, 0.0, 0.0, 0.0);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        if (value < 0.0) {
+            ++downsideSamples_;
+            downsideWeightSum_ += valueWeight;
+            downsideSquareSum_ += valueWeight * value * value;
+        }
+    }
+
+    void IncrementalStatistics::merge(const IncrementalStatistics& other) {
+        if (other.samples_ == 0)
+            return;
+        addMoments(other.samples_, other.weightSum_, other.mean_,
+                   other.m2_, other.m3_, other.m4_);
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        downsideSamples_ += other.downsideSamples_;
+        downsideWeightSum_ += other.downsideWeightSum_;
+        downsideSquareSum_ += other.downsideSquareSum_;
+    }
+
+    void IncrementalStatistics::addMoments(Size n, Real w, Real mean,
+                                           Real m2, Real m3, Real m4) {
+        // central moments of the union of two sets, see Pebay (2008)
+        samples_ += n;
+        const Real wa = weightSum_, wb = w;
+        if (wb == 0.0)
+            return;
+        // the sums are compensated (Kahan) so that the rounding
+        // errors don't grow with the number of samples
+        kahanAdd(weightSum_, weightError_, wb);
+        kahanAdd(weightedSum_, weightedError_, wb*mean);
+        const Real wt = weightSum_;
+        const Real delta = mean - mean_;
+        const Real d2 = delta*delta;
+        kahanAdd(m4_, m4Error_,
+                 m4 + d2*d2*wa*wb*(wa*wa-wa*wb+wb*wb)/(wt*wt*wt)
+                 + 6.0*d2*(wa*wa*m2 + wb*wb*m2_)/(wt*wt)
+                 + 4.0*delta*(wa*m3 - wb*m3_)/wt);
+        kahanAdd(m3_, m3Error_,
+                 m3 + d2*delta*wa*wb*(wa-wb)/(wt*wt)
+                 + 3.0*delta*(wa*m2 - wb*m2_)/wt);
+        kahanAdd(m2_, m2Error_, m2 + d2*wa*wb/wt);
+        mean_ = weightedSum_/weightSum_;
+    }
+
+    void IncrementalStatistics::kahanAdd(Real& sum, Real& error, Real x) {
+        Real y = x - error;
+        Real t = sum + y;
+        error = (t - sum) - y;
+        sum = t;
     }
 
     void IncrementalStatistics::reset() {
-        acc_ = accumulator_set();
-        downsideAcc_ = downside_accumulator_set();
+        samples_ = 0;
+        weightSum_ = weightError_ = weightedSum_ = weightedError_ = 0.0;
+        mean_ = m2_ = m3_ = m4_ = 0.0;
+        m2Error_ = m3Error_ = m4Error_ = 0.0;
+        min_ = std::numeric_limits<Real>::max();
+        max_ = -std::numeric_limits<Real>::max();
+        downsideSamples_ = 0;
+        downsideWeightSum_ = downsideSquareSum_ = 0.0;
     }
 
 }
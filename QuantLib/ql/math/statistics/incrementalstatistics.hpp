@@ -21,8 +21,6 @@
 
 /*! \file incrementalstatistics.hpp
     \brief statistics tool based on incremental accumulation
-           in the meantime, this is just a wrapper to the boost
-           accumulator library, kept for backward compatibility
 */
 
 #ifndef quantlib_incremental_statistics_hpp
@@ -31,24 +29,15 @@
 #include <ql/utilities/null.hpp>
 #include <ql/errors.hpp>
 
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/count.hpp>
-#include <boost/accumulators/statistics/sum.hpp>
-#include <boost/accumulators/statistics/min.hpp>
-#include <boost/accumulators/statistics/max.hpp>
-#include <boost/accumulators/statistics/weighted_mean.hpp>
-#include <boost/accumulators/statistics/weighted_variance.hpp>
-#include <boost/accumulators/statistics/weighted_skewness.hpp>
-#include <boost/accumulators/statistics/weighted_kurtosis.hpp>
-#include <boost/accumulators/statistics/weighted_moment.hpp>
-
 namespace QuantLib {
 
     //! Statistics tool based on incremental accumulation
     /*! It can accumulate a set of data and return statistics (e.g: mean,
         variance, skewness, kurtosis, error estimation, etc.).
-        This class is a wrapper to the boost accumulator library.
+        The central moments are updated with the one-pass formulas of
+        Welford and Pebay (2008), which avoid the cancellation errors of
+        raw power sums and allow to merge instances filled separately,
+        e.g., by different threads.
     */
 
     class IncrementalStatistics {
@@ -146,29 +135,21 @@ namespace QuantLib {
             for (;begin!=end;++begin,++wbegin)
                 add(*begin, *wbegin);
         }
+        //! adds the data collected by another instance
+        void merge(const IncrementalStatistics& other);
         //! resets the data to a null set
         void reset();
         //@}
-     private:
-       typedef boost::accumulators::accumulator_set<
-           Real,
-           boost::accumulators::stats<
-               boost::accumulators::tag::count, boost::accumulators::tag::min,
-               boost::accumulators::tag::max,
-               boost::accumulators::tag::weighted_mean,
-               boost::accumulators::tag::weighted_variance,
-               boost::accumulators::tag::weighted_skewness,
-               boost::accumulators::tag::weighted_kurtosis,
-               boost::accumulators::tag::sum_of_weights>,
-           Real> accumulator_set;
-        accumulator_set acc_;
-        typedef boost::accumulators::accumulator_set<
-            Real, boost::accumulators::stats<
-                      boost::accumulators::tag::count,
-                      boost::accumulators::tag::weighted_moment<2>,
-                      boost::accumulators::tag::sum_of_weights>,
-            Real> downside_accumulator_set;
-        downside_accumulator_set downsideAcc_;
+      private:
+        void addMoments(Size n, Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+        static void kahanAdd(Real& sum, Real& error, Real x);
+        Size samples_;
+        Real weightSum_, weightError_, weightedSum_, weightedError_;
+        Real mean_, m2_, m3_, m4_, m2Error_, m3Error_, m4Error_;
+        Real min_, max_;
+        Size downsideSamples_;
+        Real downsideWeightSum_, downsideSquareSum_;
     };
 
 }
@@ -43,6 +43,14 @@ namespace QuantLib {
         requested to the 1-D underlying StatisticsType class, with the
         usual compile-time checks provided by the template approach.
 
+        The covariance is accumulated as centered co-moments, updated
+        with Welford's formula for each sample and with a rank-k
+        update for each batch of samples passed to addSamples().
+        Instances filled separately, e.g., by different threads, can be
+        combined with merge() as long as StatisticsType provides a
+        merge() method, as Statistics, IncrementalStatistics and
+        StreamingStatistics do.
+
         \test the correctness of the returned values is tested by
               checking them against numerical calculations.
     */
@@ -131,20 +139,50 @@ namespace QuantLib {
                        "sample size mismatch: " << dimension_ <<
                        " required, " << std::distance(begin, end) <<
                        " provided");
-
-            quadraticSum_ += weight * outerProduct(begin, end,
-                                                   begin, end);
+            QL_REQUIRE(weight >= 0.0,
+                       "negative weight (" << weight << ") not allowed");
+
+            if (weight > 0.0) {
+                Iterator x = begin;
+                for (Size i=0; i<dimension_; ++x, ++i)
+                    delta_[i] = *x - mean_[i];
+                Real newWeight = weightSum_ + weight;
+                Real f = weight*weightSum_/newWeight;
+                // only the lower triangle is updated
+                for (Size i=0; i<dimension_; ++i) {
+                    mean_[i] += delta_[i]*weight/newWeight;
+                    Matrix::row_iterator c = coMoments_.row_begin(i);
+                    Real fi = f*delta_[i];
+                    for (Size j=0; j<=i; ++j)
+                        c[j] += fi*delta_[j];
+                }
+                weightSum_ = newWeight;
+            }
 
             for (Size i=0; i<dimension_; ++begin, ++i)
                 stats_[i].add(*begin, weight);
 
         }
+        //! adds a batch of samples, one for each row of the matrix
+        void addSamples(const Matrix& samples);
+        //! adds a batch of samples, each with its weight
+        void addSamples(const Matrix& samples,
+                        const std::vector<Real>& weights);
+        //! adds the data collected by another instance
+        void merge(const GenericSequenceStatistics& other);
         //@}
       protected:
         Size dimension_;
         std::vector<statistics_type> stats_;
         mutable std::vector<Real> results_;
-        Matrix quadraticSum_;
+      private:
+        void addCoMoments(Real weight,
+                          const std::vector<Real>& mean,
+                          const Matrix& coMoments);
+        Real weightSum_;
+        std::vector<Real> mean_, delta_;
+        // lower triangle of the sum of w (x-mean) (x-mean)^T
+        Matrix coMoments_;
     };
 
     //! default multi-dimensional statistics tool
@@ -158,7 +196,7 @@ namespace QuantLib {
 
     template <class Stat>
     inline GenericSequenceStatistics<Stat>::GenericSequenceStatistics(Size dimension)
-    : dimension_(0) {
+    : dimension_(0), weightSum_(0.0) {
         reset(dimension);
     }
 
@@ -238,7 +276,9 @@ namespace QuantLib {
                 stats_ = std::vector<Stat>(dimension);
                 results_ = std::vector<Real>(dimension);
             }
-            quadraticSum_ = Matrix(dimension_, dimension_, 0.0);
+            weightSum_ = 0.0;
+            mean_ = delta_ = std::vector<Real>(dimension_, 0.0);
+            coMoments_ = Matrix(dimension_, dimension_, 0.0);
         } else {
             dimension_ = dimension;
         }
@@ -254,14 +294,12 @@ namespace QuantLib {
         QL_REQUIRE(sampleNumber > 1.0,
                    "sample number <=1, unsufficient");
 
-        std::vector<Real> m = mean();
-        Real inv = 1.0/sampleWeight;
+        Real inv = sampleNumber/((sampleNumber-1.0)*weightSum_);
 
-        Matrix result = inv*quadraticSum_;
-        result -= outerProduct(m.begin(), m.end(),
-                               m.begin(), m.end());
-
-        result *= (sampleNumber/(sampleNumber-1.0));
+        Matrix result(dimension_, dimension_);
+        for (Size i=0; i<dimension_; ++i)
+            for (Size j=0; j<=i; ++j)
+                result[i][j] = result[j][i] = coMoments_[i][j]*inv;
         return result;
     }
 
@@ -295,6 +333,103 @@ namespace QuantLib {
         return correlation;
     }
 
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::addSamples(const Matrix& samples) {
+        addSamples(samples, std::vector<Real>(samples.rows(), 1.0));
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::addSamples(
+                                          const Matrix& samples,
+                                          const std::vector<Real>& weights) {
+        const Size k = samples.rows();
+        QL_REQUIRE(weights.size() == k,
+                   "weight size mismatch: " << k << " required, "
+                   << weights.size() << " provided");
+        if (k == 0)
+            return;
+        if (dimension_ == 0) {
+            // stat wasn't initialized yet
+            QL_REQUIRE(samples.columns() > 0, "sample error: empty samples");
+            reset(samples.columns());
+        }
+        QL_REQUIRE(samples.columns() == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << samples.columns() << " provided");
+
+        Real batchWeight = 0.0;
+        for (Size r=0; r<k; ++r) {
+            QL_REQUIRE(weights[r] >= 0.0,
+                       "negative weight (" << weights[r] << ") not allowed");
+            batchWeight += weights[r];
+        }
+
+        if (batchWeight > 0.0) {
+            std::vector<Real> batchMean(dimension_, 0.0);
+            for (Size r=0; r<k; ++r)
+                for (Size i=0; i<dimension_; ++i)
+                    batchMean[i] += weights[r]*samples[r][i];
+            for (Size i=0; i<dimension_; ++i)
+                batchMean[i] /= batchWeight;
+            // co-moments of the batch as a rank-k product
+            Matrix y(k, dimension_);
+            for (Size r=0; r<k; ++r) {
+                Real w = std::sqrt(weights[r]);
+                for (Size i=0; i<dimension_; ++i)
+                    y[r][i] = w*(samples[r][i]-batchMean[i]);
+            }
+            addCoMoments(batchWeight, batchMean, transpose(y)*y);
+        }
+
+        // the weights were checked above, so that no exception
+        // can be thrown from the parallel region
+        const long n = static_cast<long>(dimension_);
+        #pragma omp parallel for
+        for (long i=0; i<n; ++i)
+            for (Size r=0; r<k; ++r)
+                stats_[i].add(samples[r][i], weights[r]);
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                     const GenericSequenceStatistics& other) {
+        if (other.samples() == 0)
+            return;
+        if (dimension_ == 0) {
+            *this = other;
+            return;
+        }
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "dimension mismatch: " << dimension_ << " required, "
+                   << other.dimension_ << " provided");
+        if (other.weightSum_ > 0.0)
+            addCoMoments(other.weightSum_, other.mean_, other.coMoments_);
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::addCoMoments(
+                                             Real weight,
+                                             const std::vector<Real>& mean,
+                                             const Matrix& coMoments) {
+        // Chan, Golub and LeVeque pairwise update
+        Real newWeight = weightSum_ + weight;
+        Real f = weight*weightSum_/newWeight;
+        for (Size i=0; i<dimension_; ++i)
+            delta_[i] = mean[i] - mean_[i];
+        for (Size i=0; i<dimension_; ++i) {
+            mean_[i] += delta_[i]*weight/newWeight;
+            Matrix::row_iterator c = coMoments_.row_begin(i);
+            Matrix::const_row_iterator m = coMoments.row_begin(i);
+            Real fi = f*delta_[i];
+            for (Size j=0; j<=i; ++j)
+                c[j] += m[j] + fi*delta_[j];
+        }
+        weightSum_ = newWeight;
+    }
+
 }
 
 
@@ -0,0 +1,400 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace QuantLib {
+
+    namespace {
+
+        // scale function k_1 of the t-digest and its inverse
+        Real scale(Real q, Real compression) {
+            return compression/(2.0*M_PI) * std::asin(2.0*q-1.0);
+        }
+
+        Real inverseScale(Real k, Real compression) {
+            if (k >= compression/4.0)
+                return 1.0;
+            return 0.5*(std::sin(2.0*M_PI*k/compression) + 1.0);
+        }
+
+        // walks the sorted points until the cumulated weight reaches
+        // the target, as GeneralStatistics::percentile does
+        template <class Iterator>
+        Real walk(Iterator k, Iterator end, Real integral, Real target) {
+            Iterator l = end-1;
+            integral += k->second;
+            while (integral < target && k != l) {
+                ++k;
+                integral += k->second;
+            }
+            return k->first;
+        }
+
+    }
+
+    StreamingStatistics::StreamingStatistics(Real compression,
+                                             Size tailSize)
+    : compression_(compression), tailSize_(tailSize) {
+        QL_REQUIRE(compression >= 10.0,
+                   "compression (" << compression << ") too small");
+        QL_REQUIRE(tailSize > 0, "null tail size");
+        reset();
+    }
+
+    void StreamingStatistics::reset() {
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = QL_MAX_REAL;
+        max_ = QL_MIN_REAL;
+        lower_.clear();
+        upper_.clear();
+        centroids_.clear();
+        buffer_.clear();
+        data_.clear();
+        counts_.clear();
+        upToDate_ = true;
+    }
+
+    void StreamingStatistics::addMoments(Size n, Real w, Real mean,
+                                         Real m2, Real m3, Real m4) {
+        samples_ += n;
+        const Real wa = weightSum_, wb = w, wt = wa + wb;
+        if (wb == 0.0)
+            return;
+        const Real delta = mean - mean_;
+        const Real d2 = delta*delta;
+        m4_ += m4 + d2*d2*wa*wb*(wa*wa-wa*wb+wb*wb)/(wt*wt*wt)
+            + 6.0*d2*(wa*wa*m2 + wb*wb*m2_)/(wt*wt)
+            + 4.0*delta*(wa*m3 - wb*m3_)/wt;
+        m3_ += m3 + d2*delta*wa*wb*(wa-wb)/(wt*wt)
+            + 3.0*delta*(wa*m2 - wb*m2_)/wt;
+        m2_ += m2 + d2*wa*wb/wt;
+        mean_ += delta*wb/wt;
+        weightSum_ = wt;
+    }
+
+    void StreamingStatistics::addToTails(
+                                       const std::pair<Real,Real>& point) {
+        // lower_ is a max-heap of the lowest points...
+        if (lower_.size() < tailSize_) {
+            lower_.push_back(point);
+            std::push_heap(lower_.begin(), lower_.end());
+        } else if (point < lower_.front()) {
+            std::pop_heap(lower_.begin(), lower_.end());
+            lower_.back() = point;
+            std::push_heap(lower_.begin(), lower_.end());
+        }
+        // ...and upper_ a min-heap of the highest ones
+        typedef std::greater<std::pair<Real,Real> > greater;
+        if (upper_.size() < tailSize_) {
+            upper_.push_back(point);
+            std::push_heap(upper_.begin(), upper_.end(), greater());
+        } else if (upper_.front() < point) {
+            std::pop_heap(upper_.begin(), upper_.end(), greater());
+            upper_.back() = point;
+            std::push_heap(upper_.begin(), upper_.end(), greater());
+        }
+    }
+
+    void StreamingStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight>=0.0, "negative weight not allowed");
+        addMoments(1, weight, value, 0.0, 0.0, 0.0);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        addToTails(std::make_pair(value, weight));
+        buffer_.push_back(Centroid(value, weight, 1.0));
+        if (buffer_.size() >= Size(5.0*compression_))
+            compress();
+        upToDate_ = false;
+    }
+
+    void StreamingStatistics::merge(const StreamingStatistics& other) {
+        if (other.samples_ == 0)
+            return;
+        addMoments(other.samples_, other.weightSum_, other.mean_,
+                   other.m2_, other.m3_, other.m4_);
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        if (other.exact()) {
+            // the tails of the other instance overlap; each of its
+            // samples is added once, as in data()
+            std::vector<std::pair<Real,Real> > lower, upper;
+            other.sortedTails(lower, upper);
+            for (Size i=0; i<lower.size(); ++i)
+                addToTails(lower[i]);
+            for (Size i=upper.size()-(other.samples_-lower.size());
+                 i<upper.size(); ++i)
+                addToTails(upper[i]);
+        } else {
+            for (Size i=0; i<other.lower_.size(); ++i)
+                addToTails(other.lower_[i]);
+            for (Size i=0; i<other.upper_.size(); ++i)
+                addToTails(other.upper_[i]);
+        }
+        buffer_.insert(buffer_.end(),
+                       other.centroids_.begin(), other.centroids_.end());
+        buffer_.insert(buffer_.end(),
+                       other.buffer_.begin(), other.buffer_.end());
+        compress();
+        upToDate_ = false;
+    }
+
+    void StreamingStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+        std::vector<Centroid> points;
+        points.reserve(centroids_.size() + buffer_.size());
+        points.insert(points.end(), centroids_.begin(), centroids_.end());
+        points.insert(points.end(), buffer_.begin(), buffer_.end());
+        buffer_.clear();
+        std::sort(points.begin(), points.end());
+
+        Real total = 0.0;
+        for (Size i=0; i<points.size(); ++i)
+            total += points[i].weight;
+
+        centroids_.clear();
+        if (total == 0.0) {
+            // only null weights; nothing to be summarized
+            return;
+        }
+        Centroid current = points.front();
+        Real weightSoFar = 0.0;
+        Real limit = inverseScale(scale(0.0, compression_) + 1.0,
+                                  compression_) * total;
+        for (Size i=1; i<points.size(); ++i) {
+            const Centroid& next = points[i];
+            if (weightSoFar + current.weight + next.weight <= limit) {
+                Real w = current.weight + next.weight;
+                if (w > 0.0)
+                    current.mean += (next.mean-current.mean)*next.weight/w;
+                current.weight = w;
+                current.count += next.count;
+            } else {
+                weightSoFar += current.weight;
+                centroids_.push_back(current);
+                current = next;
+                limit = inverseScale(scale(std::min(weightSoFar/total, 1.0),
+                                           compression_) + 1.0,
+                                     compression_) * total;
+            }
+        }
+        centroids_.push_back(current);
+    }
+
+    Real StreamingStatistics::digestQuantile(Real q) const {
+        compress();
+        QL_REQUIRE(!centroids_.empty(), "empty sample set");
+        const Real target = q*weightSum_;
+        const Centroid& first = centroids_.front();
+        const Centroid& last = centroids_.back();
+        if (target <= 0.5*first.weight) {
+            // between the minimum and the first centroid
+            if (first.weight == 0.0)
+                return first.mean;
+            return min_ + (first.mean-min_)*target/(0.5*first.weight);
+        }
+        if (target >= weightSum_ - 0.5*last.weight) {
+            if (last.weight == 0.0)
+                return last.mean;
+            Real t = (weightSum_-target)/(0.5*last.weight);
+            return max_ + (last.mean-max_)*t;
+        }
+        // linear interpolation between centroid centers
+        Real center = 0.5*first.weight;
+        for (Size i=0; i+1<centroids_.size(); ++i) {
+            const Centroid& a = centroids_[i];
+            const Centroid& b = centroids_[i+1];
+            Real next = center + 0.5*(a.weight + b.weight);
+            if (target <= next) {
+                if (next == center)
+                    return a.mean;
+                return a.mean + (b.mean-a.mean)*(target-center)/(next-center);
+            }
+            center = next;
+        }
+        return last.mean;
+    }
+
+    void StreamingStatistics::sortedTails(
+                        std::vector<std::pair<Real,Real> >& lower,
+                        std::vector<std::pair<Real,Real> >& upper) const {
+        lower = lower_;
+        std::sort(lower.begin(), lower.end());
+        upper = upper_;
+        std::sort(upper.begin(), upper.end());
+    }
+
+    const std::vector<std::pair<Real,Real> >&
+    StreamingStatistics::data() const {
+        if (upToDate_)
+            return data_;
+
+        std::vector<std::pair<Real,Real> > lower, upper;
+        sortedTails(lower, upper);
+        data_.clear();
+        counts_.clear();
+
+        if (exact()) {
+            // the tails cover all the samples: the lowest ones are in
+            // the lower tail and the remaining ones at the top of the
+            // upper tail
+            data_ = lower;
+            data_.insert(data_.end(),
+                         upper.end() - (samples_ - lower.size()),
+                         upper.end());
+            counts_.resize(data_.size(), 1.0);
+            upToDate_ = true;
+            return data_;
+        }
+
+        // exact lower tail...
+        data_ = lower;
+        counts_.resize(data_.size(), 1.0);
+        Real lowerWeight = 0.0, upperWeight = 0.0;
+        for (Size i=0; i<lower.size(); ++i)
+            lowerWeight += lower[i].second;
+        for (Size i=0; i<upper.size(); ++i)
+            upperWeight += upper[i].second;
+        const Real low = lower.back().first, high = upper.front().first;
+
+        // ...digest centroids without the mass of the tails...
+        compress();
+        Real skipBelow = lowerWeight;
+        Real middle = std::max(weightSum_ - lowerWeight - upperWeight, 0.0);
+        for (Size i=0; i<centroids_.size() && middle > 0.0; ++i) {
+            const Centroid& c = centroids_[i];
+            if (c.weight == 0.0)
+                continue;
+            Real w = c.weight;
+            Real skipped = std::min(w, skipBelow);
+            skipBelow -= skipped;
+            w = std::min(w - skipped, middle);
+            if (w <= 0.0)
+                continue;
+            middle -= w;
+            Real x = std::min(std::max(c.mean, low), high);
+            data_.push_back(std::make_pair(x, w));
+            counts_.push_back(c.count*w/c.weight);
+        }
+
+        // ...and exact upper tail
+        data_.insert(data_.end(), upper.begin(), upper.end());
+        counts_.resize(data_.size(), 1.0);
+        upToDate_ = true;
+        return data_;
+    }
+
+    Real StreamingStatistics::mean() const {
+        QL_REQUIRE(samples_ != 0, "empty sample set");
+        return mean_;
+    }
+
+    Real StreamingStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1,
+                   "sample number <=1, unsufficient");
+        return (m2_/weightSum_)*N/(N-1.0);
+    }
+
+    Real StreamingStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2,
+                   "sample number <=2, unsufficient");
+        Real x = m3_/weightSum_;
+        Real sigma = standardDeviation();
+        return (x/(sigma*sigma*sigma))*(N/(N-1.0))*(N/(N-2.0));
+    }
+
+    Real StreamingStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3,
+                   "sample number <=3, unsufficient");
+        Real x = m4_/weightSum_;
+        Real sigma2 = variance();
+
+        Real c1 = (N/(N-1.0)) * (N/(N-2.0)) * ((N+1.0)/(N-3.0));
+        Real c2 = 3.0 * ((N-1.0)/(N-2.0)) * ((N-1.0)/(N-3.0));
+
+        return c1*(x/(sigma2*sigma2))-c2;
+    }
+
+    Real StreamingStatistics::percentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        const Real target = percent*weightSum_;
+        if (exact()) {
+            const std::vector<std::pair<Real,Real> >& points = data();
+            return walk(points.begin(), points.end(), 0.0, target);
+        }
+
+        std::vector<std::pair<Real,Real> > lower, upper;
+        sortedTails(lower, upper);
+        Real lowerWeight = 0.0, upperWeight = 0.0;
+        for (Size i=0; i<lower.size(); ++i)
+            lowerWeight += lower[i].second;
+        for (Size i=0; i<upper.size(); ++i)
+            upperWeight += upper[i].second;
+
+        if (target <= lowerWeight)
+            return walk(lower.begin(), lower.end(), 0.0, target);
+        if (target > weightSum_ - upperWeight)
+            return walk(upper.begin(), upper.end(),
+                        weightSum_ - upperWeight, target);
+        return std::min(std::max(digestQuantile(percent),
+                                 lower.back().first),
+                        upper.front().first);
+    }
+
+    Real StreamingStatistics::topPercentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        const Real target = percent*weightSum_;
+        if (exact()) {
+            const std::vector<std::pair<Real,Real> >& points = data();
+            return walk(points.rbegin(), points.rend(), 0.0, target);
+        }
+
+        std::vector<std::pair<Real,Real> > lower, upper;
+        sortedTails(lower, upper);
+        Real lowerWeight = 0.0, upperWeight = 0.0;
+        for (Size i=0; i<lower.size(); ++i)
+            lowerWeight += lower[i].second;
+        for (Size i=0; i<upper.size(); ++i)
+            upperWeight += upper[i].second;
+
+        if (target <= upperWeight)
+            return walk(upper.rbegin(), upper.rend(), 0.0, target);
+        if (target > weightSum_ - lowerWeight)
+            return walk(lower.rbegin(), lower.rend(),
+                        weightSum_ - lowerWeight, target);
+        return std::min(std::max(digestQuantile(1.0-percent),
+                                 lower.back().first),
+                        upper.front().first);
+    }
+
+}
@@ -0,0 +1,219 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streamingstatistics.hpp
+    \brief statistics tool with bounded memory
+*/
+
+#ifndef quantlib_streaming_statistics_hpp
+#define quantlib_streaming_statistics_hpp
+
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory
+    /*! This class provides the same interface as GeneralStatistics,
+        so that it can be used with GenericGaussianStatistics and
+        GenericRiskStatistics, without storing all the samples:
+
+        - mean, variance, skewness and kurtosis are accumulated with
+          the stable one-pass updates of Chan, Golub and LeVeque
+          extended to higher moments by Pebay (2008);
+        - the \f$ n \f$ lowest and the \f$ n \f$ highest samples are
+          kept exactly, so that percentiles, value-at-risk and expected
+          shortfall in the tails they cover are the same that
+          GeneralStatistics would return;
+        - the rest of the distribution is summarized by a t-digest
+          (Dunning and Ertl, "Computing extremely accurate quantiles
+          using t-digests", 2019) whose size depends on the compression
+          parameter but not on the number of samples.
+
+        As long as no more than \f$ 2n \f$ samples are added, all of them
+        are available and the results are exact.  Beyond that,
+        percentiles between the exact tails are interpolated within the
+        digest, and expectation values are calculated on the exact tails
+        plus the digest centroids in between.
+
+        Instances filled by different threads can be combined by means
+        of the merge() method.
+
+        \test the results are checked against GeneralStatistics.
+    */
+    class StreamingStatistics {
+      public:
+        typedef Real value_type;
+        /*!
+            @param compression Compression parameter of the t-digest;
+                   the number of centroids is of the same order.
+            @param tailSize    Number of the lowest and of the highest
+                   samples kept exactly.
+        */
+        explicit StreamingStatistics(Real compression = 200.0,
+                                     Size tailSize = 1000);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const { return samples_; }
+
+        /*! sorted data if no more than twice the tail size samples
+            were added; otherwise, the exact tails and the digest
+            centroids in between.
+        */
+        const std::vector<std::pair<Real,Real> >& data() const;
+
+        //! sum of data weights
+        Real weightSum() const { return weightSum_; }
+
+        //! mean, as in GeneralStatistics
+        Real mean() const;
+        //! variance, as in GeneralStatistics
+        Real variance() const;
+        Real standardDeviation() const;
+        Real errorEstimate() const;
+        //! skewness, as in GeneralStatistics
+        Real skewness() const;
+        //! excess kurtosis, as in GeneralStatistics
+        Real kurtosis() const;
+        Real min() const;
+        Real max() const;
+
+        /*! Expectation value of a function \f$ f \f$ on a given range
+            as in GeneralStatistics, calculated on the data returned by
+            the data() method.  The number of observations in the range
+            is approximated accordingly.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            const std::vector<std::pair<Real,Real> >& points = data();
+            Real num = 0.0, den = 0.0, N = 0.0;
+            for (Size i=0; i<points.size(); ++i) {
+                Real x = points[i].first, w = points[i].second;
+                if (inRange(x)) {
+                    num += f(x)*w;
+                    den += w;
+                    N += counts_[i];
+                }
+            }
+            Size n = Size(N + 0.5);
+            if (n == 0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,n);
+        }
+
+        /*! \f$ y \f$-th percentile as in GeneralStatistics; exact in the
+            tails, interpolated in the digest otherwise.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! \f$ y \f$-th top percentile as in GeneralStatistics; exact
+            in the tails, interpolated in the digest otherwise.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another instance
+        void merge(const StreamingStatistics& other);
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Real mean, weight, count;
+            Centroid(Real m, Real w, Real c) : mean(m), weight(w), count(c) {}
+            bool operator<(const Centroid& c) const { return mean < c.mean; }
+        };
+        void addMoments(Size n, Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+        void addToTails(const std::pair<Real,Real>& point);
+        void compress() const;
+        Real digestQuantile(Real q) const;
+        bool exact() const { return samples_ <= 2*tailSize_; }
+        void sortedTails(std::vector<std::pair<Real,Real> >& lower,
+                         std::vector<std::pair<Real,Real> >& upper) const;
+
+        Real compression_;
+        Size tailSize_;
+        // moments
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_, min_, max_;
+        // exact tails, kept as heaps
+        std::vector<std::pair<Real,Real> > lower_, upper_;
+        // t-digest
+        mutable std::vector<Centroid> centroids_, buffer_;
+        // cached summary
+        mutable std::vector<std::pair<Real,Real> > data_;
+        mutable std::vector<Real> counts_;
+        mutable bool upToDate_;
+    };
+
+    //! risk measures tool with bounded memory
+    typedef GenericRiskStatistics<GenericGaussianStatistics<
+                                      StreamingStatistics> >
+                                                     StreamingRiskStatistics;
+
+
+    // inline definitions
+
+    inline Real StreamingStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    inline Real StreamingStatistics::errorEstimate() const {
+        return std::sqrt(variance()/samples());
+    }
+
+    inline Real StreamingStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    inline Real StreamingStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+}
+
+
+#endif
@@ -27,6 +27,7 @@
 #include <ql/methods/finitedifferences/stepcondition.hpp>
 #include <ql/methods/finitedifferences/boundarycondition.hpp>
 #include <ql/methods/finitedifferences/operatortraits.hpp>
+#include <ql/math/arrayarena.hpp>
 
 namespace QuantLib {
 
@@ -98,6 +99,9 @@ namespace QuantLib {
             Time dt = (from-to)/steps, t = from;
             evolver_.setStep(dt);
 
+            // the storage of the temporaries is reused at each step
+            ArrayArena arena;
+
             if(!stoppingTimes_.empty() && stoppingTimes_.back() == from) {
                 if (condition)
                     condition->applyTo(a,from);
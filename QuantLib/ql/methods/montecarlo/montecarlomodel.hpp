@@ -27,6 +27,7 @@
 
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
+#include <ql/math/arrayarena.hpp>
 #include <boost/shared_ptr.hpp>
 
 namespace QuantLib {
@@ -94,6 +95,8 @@ namespace QuantLib {
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        // the storage of the paths and temporaries is reused
+        ArrayArena arena;
         for(Size j = 1; j <= samples; j++) {
 
             sample_type path = pathGenerator_->next();
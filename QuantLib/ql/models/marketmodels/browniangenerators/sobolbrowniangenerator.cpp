@@ -204,6 +204,11 @@ namespace QuantLib {
         return 1.0;
     }
 
+    void SobolBrownianGenerator::skipTo(unsigned long n) {
+        generator_.skipTo(n);
+        lastStep_ = 0;
+    }
+
     Size SobolBrownianGenerator::numberOfFactors() const { return factors_; }
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
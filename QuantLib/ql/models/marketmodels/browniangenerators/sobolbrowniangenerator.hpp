@@ -56,6 +56,9 @@ namespace QuantLib {
 
         Real nextPath();
         Real nextStep(std::vector<Real>&);
+        /*! skip to the n-th path; the generator must not have been
+            used yet, since this relies on SobolRsg::skipTo. */
+        void skipTo(unsigned long n);
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
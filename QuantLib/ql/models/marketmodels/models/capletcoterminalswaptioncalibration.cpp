@@ -86,12 +86,15 @@ namespace QuantLib {
         Natural failures = 0;
         Real extraMultiplier = useFullAprox ? 1.0 : 0.0;
 
-        // factor reduction
+        // factor reduction; time-homogeneous correlations repeat the
+        // same matrix, which is then decomposed only once
         std::vector<Matrix> corrPseudo(corr.times().size());
+        SpectralDecompositionCache decompositions;
         for (Size i=0; i<corrPseudo.size(); ++i)
             corrPseudo[i] = rankReducedSqrt(corr.correlation(i),
                                             numberOfFactors, 1.0,
-                                            SalvagingAlgorithm::None);
+                                            SalvagingAlgorithm::None,
+                                            decompositions);
 
         Matrix zedMatrix =
             SwapForwardMappings::coterminalSwapZedMatrix(cs, displacement);
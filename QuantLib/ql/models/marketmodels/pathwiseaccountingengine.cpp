@@ -313,10 +313,25 @@ namespace QuantLib {
         Size numberOfPaths)
     {
         std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
-        for (Size i=0; i<numberOfPaths; ++i)
+        // paths are passed to the statistics in batches, which allows
+        // rank-k updates of the covariance
+        const Size batchSize = std::min<Size>(numberOfPaths, 256);
+        Matrix batch(batchSize, values.size());
+        std::vector<Real> weights(batchSize);
+        for (Size i=0; i<numberOfPaths; i+=batchSize)
         {
-            Real weight = singlePathValues(values);
-            stats.add(values,weight);
+            Size n = std::min(batchSize, numberOfPaths-i);
+            if (n < batchSize)
+            {
+                batch = Matrix(n, values.size());
+                weights.resize(n);
+            }
+            for (Size j=0; j<n; ++j)
+            {
+                weights[j] = singlePathValues(values);
+                std::copy(values.begin(), values.end(), batch.row_begin(j));
+            }
+            stats.addSamples(batch, weights);
         }
     }
 
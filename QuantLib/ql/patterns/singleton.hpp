@@ -30,6 +30,11 @@
     #pragma managed(push, off)
 #endif
 #include <boost/noncopyable.hpp>
+#if defined(QL_ENABLE_SESSIONS)
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/once.hpp>
+#endif
 #if defined(QL_PATCH_MSVC)
     #pragma managed(pop)
 #endif
@@ -45,6 +50,18 @@
 #define QL_MANAGED 0
 #endif
 
+#if defined(QL_ENABLE_SESSIONS) && (QL_MANAGED == 0)
+// Thread-local storage for the instance last used by each thread; the
+// C++03 compiler extensions only support plain data, which is enough
+// for caching a pointer and a session id.
+#  if defined(BOOST_MSVC)
+#    define QL_SINGLETON_THREAD_LOCAL __declspec(thread)
+#  elif defined(__GNUC__) || defined(__INTEL_COMPILER) \
+        || defined(__SUNPRO_CC)
+#    define QL_SINGLETON_THREAD_LOCAL __thread
+#  endif
+#endif
+
 namespace QuantLib {
 
     #if defined(QL_ENABLE_SESSIONS)
@@ -73,6 +90,19 @@ namespace QuantLib {
         as a single implemementation point should synchronization
         features be added.
 
+        When sessions are enabled, a different instance is returned
+        for each value of the user-provided sessionId() function, so
+        that threads running different sessions (e.g., pricing books
+        on different evaluation dates) can work in parallel on their
+        own Settings, IndexManager and other singletons.  Instances
+        are created under a lock; each thread caches the instance of
+        its current session, so that repeated calls from the same
+        session don't search the instance map.
+
+        \warning sessionId() is called at every access to the
+                 instance; it should be cheap, e.g., return an id
+                 kept in thread-local storage.
+
         \ingroup patterns
     */
     template <class T>
@@ -80,6 +110,18 @@ namespace QuantLib {
     #if (QL_MANAGED == 1)
       private:
         static std::map<Integer, boost::shared_ptr<T> > instances_;
+    #endif
+    #if defined(QL_ENABLE_SESSIONS)
+      private:
+        /* The lock is created by call_once on first use: C++03 gives
+           no guarantee that a function-local static is initialized
+           only once when several threads get there, and a class
+           static could be used by another static object before its
+           dynamic initialization has run.  Both members below are
+           statically initialized. */
+        static boost::once_flag once_;
+        static boost::mutex* mutex_;
+        static void createMutex() { mutex_ = new boost::mutex; }
     #endif
       public:
         //! access to the unique instance
@@ -94,22 +136,54 @@ namespace QuantLib {
     std::map<Integer, boost::shared_ptr<T> > Singleton<T>::instances_;
     #endif
 
+    #if defined(QL_ENABLE_SESSIONS)
+    // static member definitions; the mutex is never destroyed, as the
+    // instances it protects
+    template <class T>
+    boost::once_flag Singleton<T>::once_ = BOOST_ONCE_INIT;
+
+    template <class T>
+    boost::mutex* Singleton<T>::mutex_ = 0;
+    #endif
+
     // template definitions
 
     template <class T>
     T& Singleton<T>::instance() {
+        #if defined(QL_ENABLE_SESSIONS)
+        Integer id = sessionId();
+        #if defined(QL_SINGLETON_THREAD_LOCAL)
+        // the instances are never destroyed, so the cached pointer
+        // remains valid for the lifetime of the thread
+        static QL_SINGLETON_THREAD_LOCAL T* cached = 0;
+        static QL_SINGLETON_THREAD_LOCAL Integer cachedId = 0;
+        if (cached != 0 && cachedId == id)
+            return *cached;
+        #endif
+        boost::call_once(&Singleton<T>::createMutex, once_);
+        boost::lock_guard<boost::mutex> lock(*mutex_);
         #if (QL_MANAGED == 0)
+        // initialized under the lock by the first thread getting here
         static std::map<Integer, boost::shared_ptr<T> > instances_;
         #endif
-        #if defined(QL_ENABLE_SESSIONS)
-        Integer id = sessionId();
+        boost::shared_ptr<T>& instance = instances_[id];
+        if (!instance)
+            instance = boost::shared_ptr<T>(new T);
+        #if defined(QL_SINGLETON_THREAD_LOCAL)
+        cached = instance.get();
+        cachedId = id;
+        #endif
+        return *instance;
         #else
-        Integer id = 0;
+        #if (QL_MANAGED == 0)
+        static std::map<Integer, boost::shared_ptr<T> > instances_;
         #endif
-        boost::shared_ptr<T>& instance = instances_[id];
+        // a single session; the map is searched only once
+        static boost::shared_ptr<T>& instance = instances_[0];
         if (!instance)
             instance = boost::shared_ptr<T>(new T);
         return *instance;
+        #endif
     }
 
     // reverts the change above
@@ -120,5 +194,6 @@ namespace QuantLib {
 }
 
 #undef QL_MANAGED
+#undef QL_SINGLETON_THREAD_LOCAL
 
 #endif
@@ -40,6 +40,10 @@ namespace QuantLib {
         virtual const results* getResults() const = 0;
         virtual void reset() = 0;
         virtual void calculate() const = 0;
+        //! copy of the current results, if supported by the engine
+        virtual boost::shared_ptr<results> copyResults() const;
+        //! replaces the current results with a copy of the given ones
+        virtual void setResults(const results&) const;
     };
 
     class PricingEngine::arguments {
@@ -67,11 +71,32 @@ namespace QuantLib {
         const PricingEngine::results* getResults() const { return &results_; }
         void reset() { results_.reset(); }
         void update() { notifyObservers(); }
+        boost::shared_ptr<PricingEngine::results> copyResults() const {
+            return boost::shared_ptr<PricingEngine::results>(
+                                                 new ResultsType(results_));
+        }
+        void setResults(const PricingEngine::results& r) const {
+            const ResultsType* results = dynamic_cast<const ResultsType*>(&r);
+            QL_REQUIRE(results != 0, "wrong results type");
+            results_ = *results;
+        }
       protected:
         mutable ArgumentsType arguments_;
         mutable ResultsType results_;
     };
 
+
+    // inline definitions
+
+    inline boost::shared_ptr<PricingEngine::results>
+    PricingEngine::copyResults() const {
+        return boost::shared_ptr<results>();
+    }
+
+    inline void PricingEngine::setResults(const results&) const {
+        QL_FAIL("results can't be set for this engine");
+    }
+
 }
 
 
@@ -34,11 +34,38 @@ namespace QuantLib {
                    boost::optional<bool> includeSettlementDateFlows)
     : integrationStep_(step), probability_(probability),
       recoveryRate_(recoveryRate), discountCurve_(discountCurve),
-      includeSettlementDateFlows_(includeSettlementDateFlows) {
+      includeSettlementDateFlows_(includeSettlementDateFlows),
+      cachedSettlesAccrual_(false), cachedPaysAtDefaultTime_(false) {
         registerWith(probability_);
         registerWith(discountCurve_);
     }
 
+    void IntegralCdsEngine::update() {
+        cachedLeg_.clear();
+        CreditDefaultSwap::engine::update();
+    }
+
+    void IntegralCdsEngine::resetCouponData() const {
+        Date today = Settings::instance().evaluationDate();
+        Date settlementDate = discountCurve_->referenceDate();
+        if (cachedLeg_ == arguments_.leg
+            && cachedToday_ == today
+            && cachedSettlementDate_ == settlementDate
+            && cachedProtectionStart_ == arguments_.protectionStart
+            && cachedSettlesAccrual_ == arguments_.settlesAccrual
+            && cachedPaysAtDefaultTime_ == arguments_.paysAtDefaultTime)
+            return;
+
+        cachedLeg_ = arguments_.leg;
+        cachedToday_ = today;
+        cachedSettlementDate_ = settlementDate;
+        cachedProtectionStart_ = arguments_.protectionStart;
+        cachedSettlesAccrual_ = arguments_.settlesAccrual;
+        cachedPaysAtDefaultTime_ = arguments_.paysAtDefaultTime;
+        // coupons are filled in as they are needed
+        couponData_.assign(arguments_.leg.size(), CouponData());
+    }
+
     void IntegralCdsEngine::calculate() const {
         QL_REQUIRE(integrationStep_ != Period(),
                    "null period set");
@@ -67,6 +94,8 @@ namespace QuantLib {
         }
         results_.upfrontNPV = upfPVO1 * arguments_.upfrontPayment->amount();
 
+        resetCouponData();
+
         results_.couponLegNPV = 0.0;
         results_.defaultLegNPV = 0.0;
         for (Size i=0; i<arguments_.leg.size(); ++i) {
@@ -74,41 +103,64 @@ namespace QuantLib {
                                                includeSettlementDateFlows_))
                 continue;
 
-            boost::shared_ptr<FixedRateCoupon> coupon =
-                boost::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
+            // the integration grid and whatever doesn't depend on the
+            // default probability are only calculated the first time round
+            CouponData& data = couponData_[i];
+            if (!data.cached) {
+                boost::shared_ptr<FixedRateCoupon> coupon =
+                    boost::dynamic_pointer_cast<FixedRateCoupon>(
+                                                         arguments_.leg[i]);
+
+                Date startDate = (i == 0 ? arguments_.protectionStart :
+                                           coupon->accrualStartDate()),
+                     endDate = coupon->accrualEndDate();
+                Date effectiveStartDate =
+                    (startDate <= today && today <= endDate) ?
+                    today : startDate;
+                data.paymentDate = coupon->date();
+                data.amount = coupon->amount();
+                data.paymentDiscount =
+                    discountCurve_->discount(data.paymentDate);
+
+                Period step = integrationStep_;
+                Date d0 = effectiveStartDate;
+                Date d1 = std::min(d0 + step, endDate);
+                data.dates.push_back(d0);
+                do {
+                    data.dates.push_back(d1);
+                    data.discounts.push_back(
+                        arguments_.paysAtDefaultTime ?
+                        discountCurve_->discount(d1) :
+                        data.paymentDiscount);
+                    if (arguments_.settlesAccrual &&
+                        arguments_.paysAtDefaultTime)
+                        data.accruedAmounts.push_back(
+                                                  coupon->accruedAmount(d1));
+                    d0 = d1;
+                    d1 = std::min(d0 + step, endDate);
+                } while (d0 < endDate);
+                data.cached = true;
+            }
 
             // In order to avoid a few switches, we calculate the NPV
             // of both legs as a positive quantity. We'll give them
             // the right sign at the end.
 
-            Date paymentDate = coupon->date(),
-                 startDate = (i == 0 ? arguments_.protectionStart :
-                                       coupon->accrualStartDate()),
-                 endDate = coupon->accrualEndDate();
-            Date effectiveStartDate =
-                (startDate <= today && today <= endDate) ? today : startDate;
-            Real couponAmount = coupon->amount();
-
-            Probability S = probability_->survivalProbability(paymentDate);
+            Probability S =
+                probability_->survivalProbability(data.paymentDate);
 
             // On one side, we add the fixed rate payments in case of
             // survival.
             results_.couponLegNPV +=
-                S * couponAmount * discountCurve_->discount(paymentDate);
+                S * data.amount * data.paymentDiscount;
 
             // On the other side, we add the payment (and possibly the
             // accrual) in case of default.
 
-            Period step = integrationStep_;
-            Date d0 = effectiveStartDate;
-            Date d1 = std::min(d0 + step, endDate);
-            Probability P0 = probability_->defaultProbability(d0);
-            DiscountFactor endDiscount = discountCurve_->discount(paymentDate);
-            do {
-                DiscountFactor B =
-                    arguments_.paysAtDefaultTime ?
-                    discountCurve_->discount(d1) :
-                    endDiscount;
+            Probability P0 = probability_->defaultProbability(data.dates[0]);
+            for (Size j=1; j<data.dates.size(); ++j) {
+                const Date& d1 = data.dates[j];
+                DiscountFactor B = data.discounts[j-1];
 
                 Probability P1 = probability_->defaultProbability(d1);
                 Probability dP = P1 - P0;
@@ -117,10 +169,10 @@ namespace QuantLib {
                 if (arguments_.settlesAccrual) {
                     if (arguments_.paysAtDefaultTime)
                         results_.couponLegNPV +=
-                            coupon->accruedAmount(d1) * B * dP;
+                            data.accruedAmounts[j-1] * B * dP;
                     else
                         results_.couponLegNPV +=
-                            couponAmount * B * dP;
+                            data.amount * B * dP;
                 }
 
                 // ...and claim.
@@ -131,9 +183,7 @@ namespace QuantLib {
 
                 // setup for next time around the loop
                 P0 = P1;
-                d0 = d1;
-                d1 = std::min(d0 + step, endDate);
-            } while (d0 < endDate);
+            }
         }
 
         Real upfrontSign = 1.0;
@@ -29,6 +29,13 @@
 
 namespace QuantLib {
 
+    /*! As for the mid-point engine, the integration grid of each coupon
+        together with its discount factors and accrued amounts is kept
+        until the engine is notified of a change or prices different
+        coupons, so that repeated recalculations (e.g., while
+        bootstrapping a default curve) only query the default-probability
+        curve.
+    */
     class IntegralCdsEngine : public CreditDefaultSwap::engine {
       public:
         IntegralCdsEngine(
@@ -38,12 +45,32 @@ namespace QuantLib {
               const Handle<YieldTermStructure>& discountCurve,
               boost::optional<bool> includeSettlementDateFlows = boost::none);
         void calculate() const;
+        void update();
       private:
+        struct CouponData {
+            CouponData() : cached(false) {}
+            bool cached;
+            Date paymentDate;
+            Real amount;
+            DiscountFactor paymentDiscount;
+            // integration grid, starting at the effective start date
+            std::vector<Date> dates;
+            // discounts and accrued amounts at the end of each step
+            std::vector<DiscountFactor> discounts;
+            std::vector<Real> accruedAmounts;
+        };
+        void resetCouponData() const;
         Period integrationStep_;
         Handle<DefaultProbabilityTermStructure> probability_;
         Real recoveryRate_;
         Handle<YieldTermStructure> discountCurve_;
         boost::optional<bool> includeSettlementDateFlows_;
+        // cached leg data and the arguments they were built for
+        mutable std::vector<CouponData> couponData_;
+        mutable Leg cachedLeg_;
+        mutable Date cachedToday_, cachedSettlementDate_,
+                     cachedProtectionStart_;
+        mutable bool cachedSettlesAccrual_, cachedPaysAtDefaultTime_;
     };
 
 }
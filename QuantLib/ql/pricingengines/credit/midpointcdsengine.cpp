@@ -33,11 +33,38 @@ namespace QuantLib {
                    boost::optional<bool> includeSettlementDateFlows)
     : probability_(probability), recoveryRate_(recoveryRate),
       discountCurve_(discountCurve),
-      includeSettlementDateFlows_(includeSettlementDateFlows) {
+      includeSettlementDateFlows_(includeSettlementDateFlows),
+      cachedSettlesAccrual_(false), cachedPaysAtDefaultTime_(false) {
         registerWith(probability_);
         registerWith(discountCurve_);
     }
 
+    void MidPointCdsEngine::update() {
+        cachedLeg_.clear();
+        CreditDefaultSwap::engine::update();
+    }
+
+    void MidPointCdsEngine::resetCouponData() const {
+        Date today = Settings::instance().evaluationDate();
+        Date settlementDate = discountCurve_->referenceDate();
+        if (cachedLeg_ == arguments_.leg
+            && cachedToday_ == today
+            && cachedSettlementDate_ == settlementDate
+            && cachedProtectionStart_ == arguments_.protectionStart
+            && cachedSettlesAccrual_ == arguments_.settlesAccrual
+            && cachedPaysAtDefaultTime_ == arguments_.paysAtDefaultTime)
+            return;
+
+        cachedLeg_ = arguments_.leg;
+        cachedToday_ = today;
+        cachedSettlementDate_ = settlementDate;
+        cachedProtectionStart_ = arguments_.protectionStart;
+        cachedSettlesAccrual_ = arguments_.settlesAccrual;
+        cachedPaysAtDefaultTime_ = arguments_.paysAtDefaultTime;
+        // coupons are filled in as they are needed
+        couponData_.assign(arguments_.leg.size(), CouponData());
+    }
+
     void MidPointCdsEngine::calculate() const {
         QL_REQUIRE(!discountCurve_.empty(),
                    "no discount term structure set");
@@ -64,6 +91,8 @@ namespace QuantLib {
         }
         results_.upfrontNPV = upfPVO1 * arguments_.upfrontPayment->amount();
 
+        resetCouponData();
+
         results_.couponLegNPV  = 0.0;
         results_.defaultLegNPV = 0.0;
         for (Size i=0; i<arguments_.leg.size(); ++i) {
@@ -71,58 +100,75 @@ namespace QuantLib {
                                                includeSettlementDateFlows_))
                 continue;
 
-            boost::shared_ptr<FixedRateCoupon> coupon =
-                boost::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
+            // dates, amounts and discounts don't depend on the default
+            // probability and are only calculated the first time round
+            CouponData& data = couponData_[i];
+            if (!data.cached) {
+                boost::shared_ptr<FixedRateCoupon> coupon =
+                    boost::dynamic_pointer_cast<FixedRateCoupon>(
+                                                         arguments_.leg[i]);
+
+                Date startDate = coupon->accrualStartDate();
+                // this is the only point where it might not coincide
+                if (i==0)
+                    startDate = arguments_.protectionStart;
+                data.paymentDate = coupon->date();
+                data.endDate = coupon->accrualEndDate();
+                data.effectiveStartDate =
+                    (startDate <= today && today <= data.endDate) ?
+                    today : startDate;
+                data.defaultDate = // mid-point
+                    data.effectiveStartDate +
+                    (data.endDate-data.effectiveStartDate)/2;
+                data.amount = coupon->amount();
+                data.paymentDiscount =
+                    discountCurve_->discount(data.paymentDate);
+                if (arguments_.paysAtDefaultTime) {
+                    data.defaultDiscount =
+                        discountCurve_->discount(data.defaultDate);
+                    if (arguments_.settlesAccrual)
+                        data.accruedAmount =
+                            coupon->accruedAmount(data.defaultDate);
+                }
+                data.cached = true;
+            }
 
             // In order to avoid a few switches, we calculate the NPV
             // of both legs as a positive quantity. We'll give them
             // the right sign at the end.
 
-            Date paymentDate = coupon->date(),
-                 startDate = coupon->accrualStartDate(),
-                 endDate = coupon->accrualEndDate();
-            // this is the only point where it might not coincide
-            if (i==0)
-                startDate = arguments_.protectionStart;
-            Date effectiveStartDate =
-                (startDate <= today && today <= endDate) ? today : startDate;
-            Date defaultDate = // mid-point
-                effectiveStartDate + (endDate-effectiveStartDate)/2;
-
-            Probability S = probability_->survivalProbability(paymentDate);
+            Probability S =
+                probability_->survivalProbability(data.paymentDate);
             Probability P = probability_->defaultProbability(
-                                                effectiveStartDate,
-                                                endDate);
+                                                data.effectiveStartDate,
+                                                data.endDate);
 
             // on one side, we add the fixed rate payments in case of
             // survival...
             results_.couponLegNPV +=
-                S * coupon->amount() *
-                discountCurve_->discount(paymentDate);
+                S * data.amount * data.paymentDiscount;
             // ...possibly including accrual in case of default.
             if (arguments_.settlesAccrual) {
                 if (arguments_.paysAtDefaultTime) {
                     results_.couponLegNPV +=
-                        P * coupon->accruedAmount(defaultDate) *
-                        discountCurve_->discount(defaultDate);
+                        P * data.accruedAmount * data.defaultDiscount;
                 } else {
                     // pays at the end
                     results_.couponLegNPV +=
-                        P * coupon->amount() *
-                        discountCurve_->discount(paymentDate);
+                        P * data.amount * data.paymentDiscount;
                 }
             }
 
             // on the other side, we add the payment in case of default.
-            Real claim = arguments_.claim->amount(defaultDate,
+            Real claim = arguments_.claim->amount(data.defaultDate,
                                                   arguments_.notional,
                                                   recoveryRate_);
             if (arguments_.paysAtDefaultTime) {
                 results_.defaultLegNPV +=
-                    P * claim * discountCurve_->discount(defaultDate);
+                    P * claim * data.defaultDiscount;
             } else {
                 results_.defaultLegNPV +=
-                    P * claim * discountCurve_->discount(paymentDate);
+                    P * claim * data.paymentDiscount;
             }
         }
 
@@ -30,6 +30,12 @@
 
 namespace QuantLib {
 
+    /*! The engine keeps the coupon dates, amounts and discount factors
+        of the last swap it priced. As long as it is not notified of any
+        change and prices the same coupons, a recalculation only queries
+        the default-probability curve; this is the case when the swap is
+        repriced repeatedly while bootstrapping a default curve.
+    */
     class MidPointCdsEngine : public CreditDefaultSwap::engine {
       public:
         MidPointCdsEngine(
@@ -38,11 +44,26 @@ namespace QuantLib {
               const Handle<YieldTermStructure>& discountCurve,
               boost::optional<bool> includeSettlementDateFlows = boost::none);
         void calculate() const;
+        void update();
       private:
+        struct CouponData {
+            CouponData() : cached(false) {}
+            bool cached;
+            Date paymentDate, effectiveStartDate, endDate, defaultDate;
+            Real amount, accruedAmount;
+            DiscountFactor paymentDiscount, defaultDiscount;
+        };
+        void resetCouponData() const;
         Handle<DefaultProbabilityTermStructure> probability_;
         Real recoveryRate_;
         Handle<YieldTermStructure> discountCurve_;
         boost::optional<bool> includeSettlementDateFlows_;
+        // cached leg data and the arguments they were built for
+        mutable std::vector<CouponData> couponData_;
+        mutable Leg cachedLeg_;
+        mutable Date cachedToday_, cachedSettlementDate_,
+                     cachedProtectionStart_;
+        mutable bool cachedSettlesAccrual_, cachedPaysAtDefaultTime_;
     };
 
 }
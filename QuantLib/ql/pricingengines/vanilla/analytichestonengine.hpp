@@ -85,9 +85,6 @@ namespace QuantLib {
 
         // Simple to use constructor: Using adaptive
         // Gauss-Lobatto integration and Gatheral's version of complex log.
-        // Be aware: using a too large number for maxEvaluations might result
-        // in a stack overflow as the Lobatto integration is a recursive
-        // algorithm.
         AnalyticHestonEngine(const boost::shared_ptr<HestonModel>& model,
                              Real relTolerance, Size maxEvaluations);
 
@@ -143,9 +140,7 @@ namespace QuantLib {
         static Integration gaussChebyshev2nd(Size integrationOrder = 128);
 
         // for an adaptive integration algorithm Gatheral's version has to
-        // be used.Be aware: using a too large number for maxEvaluations might
-        // result in a stack overflow as the these integrations are based on
-        // recursive algorithms.
+        // be used.
         static Integration gaussLobatto(Real relTolerance, Real absTolerance,
                                         Size maxEvaluations = 1000);
 
@@ -19,6 +19,7 @@
 
 #include <ql/termstructure.hpp>
 #include <ql/math/comparison.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -80,4 +81,19 @@ namespace QuantLib {
                             << maxTime() << ")");
     }
 
+    void TermStructure::checkRange(const std::vector<Time>& t,
+                                   bool extrapolate) const {
+        if (t.empty())
+            return;
+        // checking the extremes is enough, and calls maxTime() once
+        Time tMin = t.front(), tMax = t.front();
+        for (Size i=1; i<t.size(); ++i) {
+            tMin = std::min(tMin, t[i]);
+            tMax = std::max(tMax, t[i]);
+        }
+        QL_REQUIRE(tMin >= 0.0,
+                   "negative time (" << tMin << ") given");
+        checkRange(tMax, extrapolate);
+    }
+
 }
@@ -30,6 +30,7 @@
 #include <ql/handle.hpp>
 #include <ql/math/interpolations/extrapolation.hpp>
 #include <ql/utilities/null.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -103,6 +104,9 @@ namespace QuantLib {
         //! time-range check
         void checkRange(Time t,
                         bool extrapolate) const;
+        //! time-range check for a batch of times
+        void checkRange(const std::vector<Time>& t,
+                        bool extrapolate) const;
         bool moving_;
         mutable bool updated_;
         Calendar calendar_;
@@ -0,0 +1,378 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file globalbootstrap.hpp
+    \brief global Newton bootstrapper for piecewise term structures
+*/
+
+#ifndef quantlib_global_bootstrap_hpp
+#define quantlib_global_bootstrap_hpp
+
+#include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/utilities/dataformatters.hpp>
+
+namespace QuantLib {
+
+    //! Global Newton bootstrapper for piecewise term structures
+    /*! Unlike IterativeBootstrap, which solves the pillars one at a
+        time and needs an outer loop when a helper depends on later
+        pillars (global interpolations, or pillars before the last
+        relevant date of a helper), this class solves for all the
+        pillars at once.  The quote errors of the alive helpers are
+        driven to zero by damped quasi-Newton iterations: the Jacobian
+        is calculated once by bumping each pillar in turn, and then
+        kept up to date by Broyden updates.  When the interpolation is
+        local, the entries which are null by construction (helpers
+        ending before the bumped segment) are not calculated.
+
+        If the curve was already bootstrapped, its data and the last
+        Jacobian are used as a starting point, so that a curve is
+        usually rebuilt after a market move with a few evaluations of
+        the helpers and no bumping.
+
+        jacobian() returns the derivatives of the implied quotes of
+        the alive helpers with respect to the curve data at the
+        pillars, calculated at the solution when first requested; its
+        inverse transforms sensitivities to the quotes into
+        sensitivities to the curve data and vice versa.
+
+        \test the curve is checked against the one returned by
+              IterativeBootstrap and the Jacobian against finite
+              differences.
+    */
+    template <class Curve>
+    class GlobalBootstrap {
+        typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
+      public:
+        explicit GlobalBootstrap(Size maxIterations = 50);
+        void setup(Curve* ts);
+        void calculate() const;
+        //! \name Inspectors
+        //@{
+        /*! derivatives of the implied quotes of the alive helpers
+            (rows) with respect to the curve data at the pillars
+            (columns), calculated at the solution.
+
+            \warning the curve must have been calculated, e.g., by
+                     retrieving this instance through its bootstrap()
+                     method.
+        */
+        const Matrix& jacobian() const;
+        //! index of the first helper not expired on the curve date
+        Size firstAliveHelper() const;
+        //! number of Newton iterations used by the last calculation
+        Size iterations() const;
+        //@}
+      private:
+        void initialize() const;
+        void setupHelpers() const;
+        Disposable<Array> errors() const;
+        void calculateJacobian(const Array& errors) const;
+        bool solve(bool validData) const;
+        Curve* ts_;
+        Size n_;
+        Size maxIterations_;
+        mutable bool initialized_, validCurve_, jacobianIsExact_;
+        mutable Size firstAliveHelper_, alive_, iterations_;
+        // first helper depending on each pillar
+        mutable std::vector<Size> firstDependent_;
+        mutable Matrix jacobian_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    GlobalBootstrap<Curve>::GlobalBootstrap(Size maxIterations)
+    : ts_(0), maxIterations_(maxIterations), initialized_(false),
+      validCurve_(false), jacobianIsExact_(false), iterations_(0) {}
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setup(Curve* ts) {
+
+        ts_ = ts;
+        n_ = ts_->instruments_.size();
+        QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
+        for (Size j=0; j<n_; ++j)
+            ts_->registerWith(ts_->instruments_[j]);
+
+        // do not initialize yet: instruments could be invalid here
+        // but valid later when bootstrapping is actually required
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::initialize() const {
+        // ensure helpers are sorted
+        std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
+                  detail::BootstrapHelperSorter());
+        // skip expired helpers
+        Date firstDate = Traits::initialDate(ts_);
+        QL_REQUIRE(ts_->instruments_[n_-1]->pillarDate()>firstDate,
+                   "all instruments expired");
+        firstAliveHelper_ = 0;
+        while (ts_->instruments_[firstAliveHelper_]->pillarDate() <= firstDate)
+            ++firstAliveHelper_;
+        alive_ = n_-firstAliveHelper_;
+        QL_REQUIRE(alive_>=Interpolator::requiredPoints-1,
+                   "not enough alive instruments: " << alive_ <<
+                   " provided, " << Interpolator::requiredPoints-1 <<
+                   " required");
+
+        // calculate dates and times
+        std::vector<Date>& dates = ts_->dates_;
+        std::vector<Time>& times = ts_->times_;
+        dates.resize(alive_+1);
+        times.resize(alive_+1);
+        dates[0] = firstDate;
+        times[0] = ts_->timeFromReference(dates[0]);
+
+        std::vector<Date> latestRelevantDates(alive_+1);
+        Date maxDate = firstDate;
+        for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            dates[i] = helper->pillarDate();
+            times[i] = ts_->timeFromReference(dates[i]);
+            // check for duplicated pillars
+            QL_REQUIRE(dates[i-1]!=dates[i],
+                       "more than one instrument with pillar " << dates[i]);
+
+            latestRelevantDates[i] = helper->latestRelevantDate();
+            QL_REQUIRE(latestRelevantDates[i] > maxDate,
+                       io::ordinal(j+1) << " instrument (pillar: " <<
+                       dates[i] << ") has latestRelevantDate (" <<
+                       latestRelevantDates[i] << ") before or equal to "
+                       "previous instrument's latestRelevantDate (" <<
+                       maxDate << ")");
+            maxDate = latestRelevantDates[i];
+        }
+        ts_->maxDate_ = maxDate;
+
+        // with a local interpolation, the value at a given pillar
+        // only affects the curve after the previous one; since
+        // helpers are sorted by their latest relevant date, the ones
+        // depending on it are those after the first ending there.
+        firstDependent_.resize(alive_+1);
+        for (Size i=1; i<=alive_; ++i) {
+            Size k = 1;
+            if (!Interpolator::global) {
+                while (k < i && latestRelevantDates[k] <= dates[i-1])
+                    ++k;
+            }
+            firstDependent_[i] = k;
+        }
+
+        // set initial guess only if the current curve cannot be used as guess
+        if (!validCurve_ || ts_->data_.size()!=alive_+1) {
+            ts_->data_ = std::vector<Real>(alive_+1, Traits::initialValue(ts_));
+            validCurve_ = false;
+        }
+        initialized_ = true;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::calculate() const {
+
+        // as in IterativeBootstrap, date relative helpers might
+        // change with the evaluation date
+        if (!initialized_ || ts_->moving_)
+            initialize();
+
+        setupHelpers();
+
+        // the previous curve state could be a bad guess; if so,
+        // restart without using it
+        bool solved = false;
+        if (validCurve_) {
+            try {
+                solved = solve(true);
+            } catch (std::exception&) {}
+        }
+        if (!solved) {
+            validCurve_ = false;
+            QL_REQUIRE(solve(false),
+                       "convergence not reached after " << iterations_ <<
+                       " iterations; required accuracy " << ts_->accuracy_);
+        }
+        validCurve_ = true;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setupHelpers() const {
+        for (Size j=firstAliveHelper_; j<n_; ++j) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            // check for valid quote
+            QL_REQUIRE(helper->quote()->isValid(),
+                       io::ordinal(j + 1) << " instrument (maturity: " <<
+                       helper->maturityDate() << ", pillar: " <<
+                       helper->pillarDate() << ") has an invalid quote");
+            // don't try this at home!
+            // This call creates helpers, and removes "const".
+            // There is a significant interaction with observability.
+            helper->setTermStructure(const_cast<Curve*>(ts_));
+        }
+    }
+
+    template <class Curve>
+    bool GlobalBootstrap<Curve>::solve(bool validData) const {
+
+        std::vector<Real>& data = ts_->data_;
+        Real accuracy = ts_->accuracy_;
+
+        if (!validData) {
+            // extrapolate the initial guess a point at a time; as in
+            // IterativeBootstrap, the traits might need an
+            // interpolation on the previous points
+            for (Size i=1; i<=alive_; ++i) {
+                if (i > 1) {
+                    ts_->interpolation_ = Linear().interpolate(
+                        ts_->times_.begin(), ts_->times_.begin()+i,
+                        data.begin());
+                    ts_->interpolation_.update();
+                }
+                Traits::updateGuess(data,
+                                    Traits::guess(i, ts_, false,
+                                                  firstAliveHelper_),
+                                    i);
+            }
+        }
+        ts_->interpolation_ = ts_->interpolator_.interpolate(
+                    ts_->times_.begin(), ts_->times_.end(), data.begin());
+        ts_->interpolation_.update();
+
+        // the Jacobian left by a previous calculation, if any, is
+        // a good enough approximation to start from
+        Array x(alive_), e = errors();
+        if (!validData || jacobian_.rows() != alive_)
+            calculateJacobian(e);
+        Real norm = DotProduct(e, e), change = QL_MAX_REAL;
+        for (iterations_=0; ; ++iterations_) {
+            if (std::sqrt(norm) <= accuracy || change <= accuracy)
+                return true;
+            if (iterations_ == maxIterations_)
+                return false;
+
+            for (Size i=0; i<alive_; ++i)
+                x[i] = data[i+1];
+            // jacobian_ holds the derivatives of the implied quotes,
+            // i.e., minus those of the errors
+            Array step = qrSolve(jacobian_, e);
+
+            // damping: halve the step until the errors decrease
+            Real lambda = 1.0;
+            Array trial;
+            bool improved = false;
+            for (Size k=0; k<30 && !improved; ++k) {
+                try {
+                    for (Size i=0; i<alive_; ++i)
+                        Traits::updateGuess(data, x[i]+lambda*step[i], i+1);
+                    ts_->interpolation_.update();
+                    trial = errors();
+                    improved = DotProduct(trial, trial) < norm;
+                } catch (std::exception&) {}
+                if (!improved)
+                    lambda /= 2.0;
+            }
+            if (!improved) {
+                // restore the last point
+                for (Size i=0; i<alive_; ++i)
+                    Traits::updateGuess(data, x[i], i+1);
+                ts_->interpolation_.update();
+                // an updated Jacobian might have gone astray; if
+                // even an exact one can't improve the solution, we
+                // reached machine precision
+                if (!jacobianIsExact_) {
+                    calculateJacobian(e);
+                    change = QL_MAX_REAL;
+                    continue;
+                }
+                return std::sqrt(DotProduct(step, step)) <= accuracy;
+            }
+
+            // Broyden update of the Jacobian, so that it doesn't need
+            // to be calculated again at each iteration
+            step *= lambda;
+            Array y = e - trial;
+            Array r = y - jacobian_*step;
+            Real s2 = DotProduct(step, step);
+            jacobian_ += outerProduct(r, step) / s2;
+            jacobianIsExact_ = false;
+
+            e = trial;
+            norm = DotProduct(e, e);
+            // a damped step can be small without being close to
+            // the solution
+            change = lambda == 1.0 ? std::sqrt(s2) : QL_MAX_REAL;
+        }
+    }
+
+    template <class Curve>
+    Disposable<Array> GlobalBootstrap<Curve>::errors() const {
+        Array e(alive_);
+        for (Size i=0; i<alive_; ++i)
+            e[i] = ts_->instruments_[firstAliveHelper_+i]->quoteError();
+        return e;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::calculateJacobian(const Array& e) const {
+        std::vector<Real>& data = ts_->data_;
+        jacobian_ = Matrix(alive_, alive_, 0.0);
+        for (Size j=1; j<=alive_; ++j) {
+            Real x = data[j];
+            Real h = 1.0e-7*std::max(std::fabs(x), 1.0e-2);
+            Traits::updateGuess(data, x+h, j);
+            ts_->interpolation_.update();
+            for (Size i=firstDependent_[j]; i<=alive_; ++i) {
+                Real bumped =
+                    ts_->instruments_[firstAliveHelper_+i-1]->quoteError();
+                jacobian_[i-1][j-1] = -(bumped-e[i-1])/h;
+            }
+            Traits::updateGuess(data, x, j);
+        }
+        ts_->interpolation_.update();
+        jacobianIsExact_ = true;
+    }
+
+    template <class Curve>
+    const Matrix& GlobalBootstrap<Curve>::jacobian() const {
+        // the one used by the solver might have been updated
+        if (!jacobianIsExact_) {
+            // the helpers might have been used by another curve since
+            setupHelpers();
+            calculateJacobian(errors());
+        }
+        return jacobian_;
+    }
+
+    template <class Curve>
+    inline Size GlobalBootstrap<Curve>::firstAliveHelper() const {
+        return firstAliveHelper_;
+    }
+
+    template <class Curve>
+    inline Size GlobalBootstrap<Curve>::iterations() const {
+        return iterations_;
+    }
+
+}
+
+#endif
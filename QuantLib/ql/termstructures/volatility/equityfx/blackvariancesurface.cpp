@@ -83,5 +83,33 @@ namespace QuantLib {
                 t/times_.back();
     }
 
+    void BlackVarianceSurface::blackVariancesImpl(const Time* t,
+                                                  Real strike,
+                                                  Real* variances,
+                                                  Size n) const {
+        // enforce constant extrapolation when required
+        if (strike < strikes_.front()
+            && lowerExtrapolation_ == ConstantExtrapolation)
+            strike = strikes_.front();
+        if (strike > strikes_.back()
+            && upperExtrapolation_ == ConstantExtrapolation)
+            strike = strikes_.back();
+
+        // the variance at the last time is only needed for extrapolation
+        Real lastVariance = Null<Real>();
+        for (Size i=0; i<n; ++i) {
+            if (t[i]==0.0) {
+                variances[i] = 0.0;
+            } else if (t[i]<=times_.back()) {
+                variances[i] = varianceSurface_(t[i], strike, true);
+            } else {
+                if (lastVariance == Null<Real>())
+                    lastVariance =
+                        varianceSurface_(times_.back(), strike, true);
+                variances[i] = lastVariance * t[i]/times_.back();
+            }
+        }
+    }
+
 }
 
@@ -91,6 +91,10 @@ namespace QuantLib {
         //@}
       protected:
         virtual Real blackVarianceImpl(Time t, Real strike) const;
+        virtual void blackVariancesImpl(const Time* t,
+                                        Real strike,
+                                        Real* variances,
+                                        Size n) const;
       private:
         DayCounter dayCounter_;
         Date maxDate_;
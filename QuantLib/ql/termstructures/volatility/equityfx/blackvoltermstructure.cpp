@@ -37,6 +37,14 @@ namespace QuantLib {
                                                  const DayCounter& dc)
     : VolatilityTermStructure(settlDays, cal, bdc, dc) {}
 
+    void BlackVolTermStructure::blackVariancesImpl(const Time* t,
+                                                   Real strike,
+                                                   Real* variances,
+                                                   Size n) const {
+        for (Size i=0; i<n; ++i)
+            variances[i] = blackVarianceImpl(t[i], strike);
+    }
+
     Volatility BlackVolTermStructure::blackForwardVol(const Date& date1,
                                                       const Date& date2,
                                                       Real strike,
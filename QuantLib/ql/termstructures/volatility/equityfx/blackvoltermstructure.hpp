@@ -81,6 +81,11 @@ namespace QuantLib {
         Real blackVariance(Time maturity,
                            Real strike,
                            bool extrapolate = false) const;
+        //! spot variances at the given maturities for a single strike
+        void blackVariance(const std::vector<Time>& maturities,
+                           Real strike,
+                           Real* variances,
+                           bool extrapolate = false) const;
         //! forward (at-the-money) volatility
         Volatility blackForwardVol(const Date& date1,
                                    const Date& date2,
@@ -117,6 +122,13 @@ namespace QuantLib {
         //@{
         //! Black variance calculation
         virtual Real blackVarianceImpl(Time t, Real strike) const = 0;
+        /*! batch Black variance calculation; the default implementation
+            calls blackVarianceImpl(Time, Real) for each maturity.
+        */
+        virtual void blackVariancesImpl(const Time* t,
+                                        Real strike,
+                                        Real* variances,
+                                        Size n) const;
         //! Black volatility calculation
         virtual Volatility blackVolImpl(Time t, Real strike) const = 0;
         //@}
@@ -249,6 +261,18 @@ namespace QuantLib {
         return blackVarianceImpl(t, strike);
     }
 
+    inline void BlackVolTermStructure::blackVariance(
+                                          const std::vector<Time>& maturities,
+                                          Real strike,
+                                          Real* variances,
+                                          bool extrapolate) const {
+        checkRange(maturities, extrapolate);
+        checkStrike(strike, extrapolate);
+        if (!maturities.empty())
+            blackVariancesImpl(&maturities[0], strike,
+                               variances, maturities.size());
+    }
+
     inline void BlackVolTermStructure::accept(AcyclicVisitor& v) {
         Visitor<BlackVolTermStructure>* v1 =
             dynamic_cast<Visitor<BlackVolTermStructure>*>(&v);
@@ -95,6 +95,7 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, DiscountFactor* df, Size n) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -168,6 +169,21 @@ namespace QuantLib {
         return dMax * std::exp(- instFwdMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedDiscountCurve<T>::discountsImpl(const Time* t,
+                                                     DiscountFactor* df,
+                                                     Size n) const {
+        // the leading times on the curve are interpolated in one batch
+        Time tMax = this->times_.back();
+        Size m = 0;
+        while (m < n && t[m] <= tMax)
+            ++m;
+        if (m > 0)
+            this->interpolation_(t, df, m, true);
+        for (Size i=m; i<n; ++i)
+            df[i] = InterpolatedDiscountCurve<T>::discountImpl(t[i]);
+    }
+
     template <class T>
     InterpolatedDiscountCurve<T>::InterpolatedDiscountCurve(
                                     const DayCounter& dayCounter,
@@ -25,9 +25,11 @@
 #include <ql/math/optimization/simplex.hpp>
 #include <ql/math/optimization/costfunction.hpp>
 #include <ql/math/optimization/constraint.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
+#include <string>
 
 using boost::shared_ptr;
 using std::vector;
@@ -41,9 +43,26 @@ namespace QuantLib {
         FittingCost(FittedBondDiscountCurve::FittingMethod* fittingMethod);
         Real value(const Array& x) const;
         Disposable<Array> values(const Array& x) const;
+        void gradient(Array& grad, const Array& x) const;
+        Real valueAndGradient(Array& grad, const Array& x) const;
       private:
+        // cash flows of a bond still to be paid at its settlement
+        struct BondCashFlows {
+            vector<Time> times;
+            vector<Real> amounts;
+            // subtracted from the model price
+            Real accruedAmount;
+            // null if the bond settles at the reference date
+            Time settlementTime;
+            Real marketPrice;
+        };
+        void tabulateCashFlows();
+        Real modelPrice(Size i, const Array& x) const;
+        Real modelPrice(Size i, const Array& x,
+                        Array& gradient, Array& work) const;
+        Real calculate(const Array& x, Array* values, Array* grad) const;
         FittedBondDiscountCurve::FittingMethod* fittingMethod_;
-        mutable vector<Size> firstCashFlow_;
+        vector<BondCashFlows> cashFlows_;
     };
 
 
@@ -57,12 +76,14 @@ namespace QuantLib {
                  Size maxEvaluations,
                  const Array& guess,
                  Real simplexLambda,
-                 Size maxStationaryStateIterations)
+                 Size maxStationaryStateIterations,
+                 bool concurrentEvaluation)
     : YieldTermStructure(settlementDays, calendar, dayCounter),
       accuracy_(accuracy),
       maxEvaluations_(maxEvaluations),
       simplexLambda_(simplexLambda),
       maxStationaryStateIterations_(maxStationaryStateIterations),
+      concurrentEvaluation_(concurrentEvaluation),
       guessSolution_(guess),
       bondHelpers_(bondHelpers),
       fittingMethod_(fittingMethod) {
@@ -81,12 +102,14 @@ namespace QuantLib {
                  Size maxEvaluations,
                  const Array& guess,
                  Real simplexLambda,
-                 Size maxStationaryStateIterations)
+                 Size maxStationaryStateIterations,
+                 bool concurrentEvaluation)
     : YieldTermStructure(referenceDate, Calendar(), dayCounter),
       accuracy_(accuracy),
       maxEvaluations_(maxEvaluations),
       simplexLambda_(simplexLambda),
       maxStationaryStateIterations_(maxStationaryStateIterations),
+      concurrentEvaluation_(concurrentEvaluation),
       guessSolution_(guess),
       bondHelpers_(bondHelpers),
       fittingMethod_(fittingMethod) {
@@ -143,19 +166,7 @@ namespace QuantLib {
 
         Size n = curve_->bondHelpers_.size();
         costFunction_ = shared_ptr<FittingCost>(new FittingCost(this));
-        costFunction_->firstCashFlow_.resize(n);
-
-        for (Size i=0; i<curve_->bondHelpers_.size(); ++i) {
-            shared_ptr<Bond> bond = curve_->bondHelpers_[i]->bond();
-            const Leg& cf = bond->cashflows();
-            Date bondSettlement = bond->settlementDate();
-            for (Size k=0; k<cf.size(); ++k) {
-                if (!cf[k]->hasOccurred(bondSettlement, false)) {
-                    costFunction_->firstCashFlow_[i] = k;
-                    break;
-                }
-            }
-        }
+        costFunction_->tabulateCashFlows();
 
         if (calculateWeights_) {
             if (weights_.empty())
@@ -235,57 +246,191 @@ namespace QuantLib {
     }
 
 
+    void FittedBondDiscountCurve::FittingMethod::discountFunctionGradient(
+                                                       const Array& x, Time t,
+                                                       Array& gradient) const {
+        Array y(x);
+        for (Size j=0; j<x.size(); ++j) {
+            Real h = 1.0e-6*std::max(1.0, std::fabs(x[j]));
+            y[j] = x[j] + h;
+            DiscountFactor up = discountFunction(y, t);
+            y[j] = x[j] - h;
+            DiscountFactor down = discountFunction(y, t);
+            y[j] = x[j];
+            gradient[j] = (up-down)/(2.0*h);
+        }
+    }
+
+
     FittedBondDiscountCurve::FittingMethod::FittingCost::FittingCost(
                         FittedBondDiscountCurve::FittingMethod* fittingMethod)
     : fittingMethod_(fittingMethod) {}
 
 
-    Real FittedBondDiscountCurve::FittingMethod::FittingCost::value(
-                                                       const Array& x) const {
-        Real squaredError = 0.0;
-		Array vals = values(x);
-		for (Size i = 0; i<vals.size(); ++i) {
-            squaredError += vals[i];
-        }
-        return squaredError;
-    }
-
-    Disposable<Array>
-    FittedBondDiscountCurve::FittingMethod::FittingCost::values(
-                                                       const Array &x) const {
+    void
+    FittedBondDiscountCurve::FittingMethod::FittingCost::tabulateCashFlows() {
         Date refDate  = fittingMethod_->curve_->referenceDate();
         const DayCounter& dc = fittingMethod_->curve_->dayCounter();
         Size n = fittingMethod_->curve_->bondHelpers_.size();
-        Array values(n);
+        cashFlows_.resize(n);
         for (Size i=0; i<n; ++i) {
             shared_ptr<BondHelper> helper =
                 fittingMethod_->curve_->bondHelpers_[i];
-
             shared_ptr<Bond> bond = helper->bond();
             Date bondSettlement = bond->settlementDate();
+            BondCashFlows& table = cashFlows_[i];
 
-            // CleanPrice_i = sum( cf_k * d(t_k) ) - accruedAmount
-            Real modelPrice = 0.0;
             const Leg& cf = bond->cashflows();
-            for (Size k=firstCashFlow_[i]; k<cf.size(); ++k) {
-                Time tenor = dc.yearFraction(refDate, cf[k]->date());
-                modelPrice += cf[k]->amount() *
-                                    fittingMethod_->discountFunction(x, tenor);
+            Size first = 0;
+            for (Size k=0; k<cf.size(); ++k) {
+                if (!cf[k]->hasOccurred(bondSettlement, false)) {
+                    first = k;
+                    break;
+                }
             }
-            if (helper->useCleanPrice())
-                modelPrice -= bond->accruedAmount(bondSettlement);
+            table.times.resize(cf.size()-first);
+            table.amounts.resize(cf.size()-first);
+            for (Size k=first; k<cf.size(); ++k) {
+                table.times[k-first] = dc.yearFraction(refDate, cf[k]->date());
+                table.amounts[k-first] = cf[k]->amount();
+            }
+            table.accruedAmount = helper->useCleanPrice() ?
+                                  bond->accruedAmount(bondSettlement) : 0.0;
+            table.settlementTime = bondSettlement != refDate ?
+                                   dc.yearFraction(refDate, bondSettlement) :
+                                   Null<Time>();
+            table.marketPrice = helper->quote()->value();
+        }
+    }
+
 
-            // adjust price (NPV) for forward settlement
-            if (bondSettlement != refDate ) {
-                Time tenor = dc.yearFraction(refDate, bondSettlement);
-                modelPrice /= fittingMethod_->discountFunction(x, tenor);
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::modelPrice(
+                                                  Size i,
+                                                  const Array& x) const {
+        const BondCashFlows& table = cashFlows_[i];
+
+        // CleanPrice_i = sum( cf_k * d(t_k) ) - accruedAmount
+        Real price = 0.0;
+        for (Size k=0; k<table.times.size(); ++k)
+            price += table.amounts[k] *
+                     fittingMethod_->discountFunction(x, table.times[k]);
+        price -= table.accruedAmount;
+
+        // adjust price (NPV) for forward settlement
+        if (table.settlementTime != Null<Time>())
+            price /= fittingMethod_->discountFunction(x, table.settlementTime);
+        return price;
+    }
+
+
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::modelPrice(
+                                                  Size i,
+                                                  const Array& x,
+                                                  Array& gradient,
+                                                  Array& work) const {
+        const BondCashFlows& table = cashFlows_[i];
+
+        Real price = 0.0;
+        std::fill(gradient.begin(), gradient.end(), 0.0);
+        for (Size k=0; k<table.times.size(); ++k) {
+            Real amount = table.amounts[k];
+            price += amount *
+                     fittingMethod_->discountFunction(x, table.times[k]);
+            fittingMethod_->discountFunctionGradient(x, table.times[k], work);
+            for (Size j=0; j<gradient.size(); ++j)
+                gradient[j] += amount * work[j];
+        }
+        price -= table.accruedAmount;
+
+        if (table.settlementTime != Null<Time>()) {
+            DiscountFactor d =
+                fittingMethod_->discountFunction(x, table.settlementTime);
+            fittingMethod_->discountFunctionGradient(x, table.settlementTime,
+                                                     work);
+            price /= d;
+            for (Size j=0; j<gradient.size(); ++j)
+                gradient[j] = (gradient[j] - price*work[j])/d;
+        }
+        return price;
+    }
+
+
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::calculate(
+                                                  const Array& x,
+                                                  Array* values,
+                                                  Array* grad) const {
+        const long n = static_cast<long>(cashFlows_.size());
+        const Array& weights = fittingMethod_->weights_;
+        Array squaredErrors(n);
+        // one row per bond, summed afterwards so that the result
+        // doesn't depend on the order of evaluation
+        Matrix gradients(grad != 0 ? n : 0, x.size());
+        vector<std::string> errors(n);
+
+        #pragma omp parallel for schedule(dynamic) \
+                        if(fittingMethod_->curve_->concurrentEvaluation_)
+        for (long i=0; i<n; ++i) {
+            // exceptions can not leave the parallel region
+            try {
+                Real price;
+                if (grad != 0) {
+                    Array priceGradient(x.size()), work(x.size());
+                    price = modelPrice(i, x, priceGradient, work);
+                    Real error = price - cashFlows_[i].marketPrice;
+                    Real factor = 2.0 * weights[i] * weights[i] * error;
+                    for (Size j=0; j<x.size(); ++j)
+                        gradients[i][j] = factor * priceGradient[j];
+                } else {
+                    price = modelPrice(i, x);
+                }
+                Real weightedError =
+                    weights[i] * (price - cashFlows_[i].marketPrice);
+                squaredErrors[i] = weightedError * weightedError;
+            } catch (std::exception& e) {
+                errors[i] = e.what();
             }
-            Real marketPrice = helper->quote()->value();
-            Real error = modelPrice - marketPrice;
-            Real weightedError = fittingMethod_->weights_[i] * error;
-            values[i] = weightedError * weightedError;
         }
+        for (long i=0; i<n; ++i)
+            QL_REQUIRE(errors[i].empty(), errors[i]);
+
+        Real squaredError = 0.0;
+        for (long i=0; i<n; ++i)
+            squaredError += squaredErrors[i];
+        if (values != 0)
+            *values = squaredErrors;
+        if (grad != 0) {
+            std::fill(grad->begin(), grad->end(), 0.0);
+            for (long i=0; i<n; ++i)
+                for (Size j=0; j<x.size(); ++j)
+                    (*grad)[j] += gradients[i][j];
+        }
+        return squaredError;
+    }
+
+
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::value(
+                                                       const Array& x) const {
+        return calculate(x, 0, 0);
+    }
+
+    Disposable<Array>
+    FittedBondDiscountCurve::FittingMethod::FittingCost::values(
+                                                       const Array &x) const {
+        Array values;
+        calculate(x, &values, 0);
         return values;
     }
 
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::gradient(
+                                                       Array& grad,
+                                                       const Array& x) const {
+        calculate(x, 0, &grad);
+    }
+
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::valueAndGradient(
+                                                       Array& grad,
+                                                       const Array& x) const {
+        return calculate(x, 0, &grad);
+    }
+
 }
@@ -53,12 +53,30 @@ namespace QuantLib {
         compares various bond discount curve fitting methodologies
         \endlink
 
+        The cash flows of the bonds are tabulated once for each
+        calculation, so that the cost function only needs to evaluate
+        the discount function at the tabulated times.  The gradient of
+        the cost function is calculated from the gradient of the
+        discount function, which is available in closed form for most
+        fitting methods; gradient-based optimization methods (e.g.,
+        LevenbergMarquardt or BFGS) can therefore be passed to them.
+
+        If concurrent evaluation is requested and the library is
+        compiled with OpenMP support, the bonds are priced in
+        parallel at each evaluation of the cost function.
+
         \warning The method can be slow if there are many bonds to
                  fit. Speed also depends on the particular choice of
                  fitting method chosen and its convergence properties
                  under optimization.  See also todo list for
                  BondDiscountCurveFittingMethod.
 
+        \warning with concurrent evaluation, the discount function of
+                 the fitting method is called from several threads;
+                 this is not safe for methods relying on other term
+                 structures, such as SpreadFittingMethod, unless those
+                 are already calculated.
+
         \todo refactor the bond helper class so that it is pure
               virtual and returns a generic bond or its cash
               flows. Derived classes would include helpers for
@@ -81,6 +99,14 @@ namespace QuantLib {
         \todo add extrapolation routines
 
         \ingroup yieldtermstructures
+
+        \test
+        - the analytic gradients of the fitting methods are checked
+          against finite differences.
+        - fits with concurrent evaluation are checked to give the
+          same results as serial ones.
+        - fits with gradient-based optimizers are checked against
+          the results of the simplex method.
     */
     class FittedBondDiscountCurve : public YieldTermStructure,
                                     public LazyObject {
@@ -101,7 +127,8 @@ namespace QuantLib {
                  Size maxEvaluations = 10000,
                  const Array& guess = Array(),
                  Real simplexLambda = 1.0,
-                 Size maxStationaryStateIterations = 100);
+                 Size maxStationaryStateIterations = 100,
+                 bool concurrentEvaluation = false);
         //! curve reference date fixed for life of curve
         FittedBondDiscountCurve(
                  const Date &referenceDate,
@@ -112,7 +139,8 @@ namespace QuantLib {
                  Size maxEvaluations = 10000,
                  const Array &guess = Array(),
                  Real simplexLambda = 1.0,
-                 Size maxStationaryStateIterations = 100);
+                 Size maxStationaryStateIterations = 100,
+                 bool concurrentEvaluation = false);
         //@}
 
         //! \name Inspectors
@@ -142,6 +170,8 @@ namespace QuantLib {
         Real simplexLambda_;
         // max number of evaluations where no improvement to solution is made
         Size maxStationaryStateIterations_;
+        // whether the bonds are priced in parallel
+        bool concurrentEvaluation_;
         // a guess solution may be passed into the constructor to speed calcs
         Array guessSolution_;
         mutable Date maxDate_;
@@ -205,6 +235,8 @@ namespace QuantLib {
 		boost::shared_ptr<OptimizationMethod> optimizationMethod() const;
 		//! open discountFunction to public
 		DiscountFactor discount(const Array& x, Time t) const;
+        //! open discountFunctionGradient to public
+        void discountGradient(const Array& x, Time t, Array& gradient) const;
       protected:
         //! constructor
         FittingMethod(bool constrainAtZero = true, const Array& weights = Array(),
@@ -215,6 +247,14 @@ namespace QuantLib {
         //! discount function called by FittedBondDiscountCurve
         virtual DiscountFactor discountFunction(const Array& x,
                                                 Time t) const = 0;
+        //! gradient of the discount function with respect to the parameters
+        /*! The gradient array is sized by the caller.  The default
+            implementation uses central finite differences; derived
+            classes should override it with the analytic expression.
+        */
+        virtual void discountFunctionGradient(const Array& x,
+                                              Time t,
+                                              Array& gradient) const;
 
         //! constrains discount function to unity at \f$ T=0 \f$, if true
         bool constrainAtZero_;
@@ -309,6 +349,12 @@ namespace QuantLib {
 		return discountFunction(x, t);
 	}
 
+    inline void FittedBondDiscountCurve::FittingMethod::discountGradient(
+                                                       const Array& x, Time t,
+                                                       Array& gradient) const {
+        discountFunctionGradient(x, t, gradient);
+    }
+
 }
 
 #endif
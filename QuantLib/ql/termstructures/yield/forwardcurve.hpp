@@ -96,6 +96,7 @@ namespace QuantLib {
         //@{
         Rate forwardImpl(Time t) const;
         Rate zeroYieldImpl(Time t) const;
+        void zeroYieldsImpl(const Time* t, Rate* r, Size n) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -179,6 +180,14 @@ namespace QuantLib {
         return integral/t;
     }
 
+    template <class T>
+    void InterpolatedForwardCurve<T>::zeroYieldsImpl(const Time* t,
+                                                     Rate* r,
+                                                     Size n) const {
+        for (Size i=0; i<n; ++i)
+            r[i] = InterpolatedForwardCurve<T>::zeroYieldImpl(t[i]);
+    }
+
     template <class T>
     InterpolatedForwardCurve<T>::InterpolatedForwardCurve(
                                     const DayCounter& dayCounter,
@@ -20,6 +20,7 @@
 */
 
 #include <ql/termstructures/yield/forwardstructure.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -58,4 +59,30 @@ namespace QuantLib {
         return Rate(sum*dt/t);
     }
 
+    void ForwardRateStructure::zeroYieldsImpl(const Time* t,
+                                              Rate* r,
+                                              Size n) const {
+        for (Size i=0; i<n; ++i)
+            r[i] = zeroYieldImpl(t[i]);
+    }
+
+    void ForwardRateStructure::discountsImpl(const Time* t,
+                                             DiscountFactor* df,
+                                             Size n) const {
+        // as in discountImpl, null times are not passed to
+        // zeroYieldsImpl since zeroYieldImpl(0.0) might throw
+        Size first = 0;
+        while (first < n && t[first] == 0.0)
+            df[first++] = 1.0;
+        if (std::find(t+first, t+n, 0.0) != t+n) {
+            // unsorted times; fall back to the scalar calculation
+            for (Size i=first; i<n; ++i)
+                df[i] = discountImpl(t[i]);
+            return;
+        }
+        zeroYieldsImpl(t+first, df+first, n-first);
+        for (Size i=first; i<n; ++i)
+            df[i] = DiscountFactor(std::exp(-df[i]*t[i]));
+    }
+
 }
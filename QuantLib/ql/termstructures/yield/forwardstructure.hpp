@@ -88,6 +88,10 @@ namespace QuantLib {
                      implementation is available.
         */
         virtual Rate zeroYieldImpl(Time) const;
+        /*! batch zero-yield calculation; the default implementation
+            calls zeroYieldImpl(Time) for each time.
+        */
+        virtual void zeroYieldsImpl(const Time* t, Rate* r, Size n) const;
         //@}
 
         //! \name YieldTermStructure implementation
@@ -96,6 +100,10 @@ namespace QuantLib {
             from the zero rate as \f$ d(t) = \exp \left( -z(t) t \right) \f$
         */
         DiscountFactor discountImpl(Time) const;
+        /*! Returns the discount factors for the given times
+            calculating them from the batch of zero yields.
+        */
+        void discountsImpl(const Time* t, DiscountFactor* df, Size n) const;
         //@}
     };
 
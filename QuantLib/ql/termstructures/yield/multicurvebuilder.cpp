@@ -0,0 +1,352 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/yield/multicurvebuilder.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/array.hpp>
+#include <algorithm>
+#include <sstream>
+
+namespace QuantLib {
+
+    namespace {
+
+        // Tarjan's algorithm; the components are found after all the
+        // ones they depend on, so that they come out in build order
+        class ComponentFinder {
+          public:
+            explicit ComponentFinder(const std::vector<std::vector<Size> >& g)
+            : graph_(g), index_(g.size(), Null<Size>()),
+              lowLink_(g.size()), onStack_(g.size(), false),
+              component_(g.size()), counter_(0) {
+                for (Size i=0; i<graph_.size(); ++i)
+                    if (index_[i] == Null<Size>())
+                        visit(i);
+            }
+            const std::vector<std::vector<Size> >& components() const {
+                return components_;
+            }
+            Size component(Size i) const { return component_[i]; }
+          private:
+            void visit(Size i) {
+                index_[i] = lowLink_[i] = counter_++;
+                stack_.push_back(i);
+                onStack_[i] = true;
+                for (Size k=0; k<graph_[i].size(); ++k) {
+                    Size j = graph_[i][k];
+                    if (index_[j] == Null<Size>()) {
+                        visit(j);
+                        lowLink_[i] = std::min(lowLink_[i], lowLink_[j]);
+                    } else if (onStack_[j]) {
+                        lowLink_[i] = std::min(lowLink_[i], index_[j]);
+                    }
+                }
+                if (lowLink_[i] == index_[i]) {
+                    std::vector<Size> component;
+                    Size j;
+                    do {
+                        j = stack_.back();
+                        stack_.pop_back();
+                        onStack_[j] = false;
+                        component_[j] = components_.size();
+                        component.push_back(j);
+                    } while (j != i);
+                    std::sort(component.begin(), component.end());
+                    components_.push_back(component);
+                }
+            }
+            const std::vector<std::vector<Size> >& graph_;
+            std::vector<Size> index_, lowLink_;
+            std::vector<bool> onStack_;
+            std::vector<Size> component_, stack_;
+            std::vector<std::vector<Size> > components_;
+            Size counter_;
+        };
+
+        bool precedes(const std::vector<Size>& c1,
+                      const std::vector<Size>& c2) {
+            return c1.front() < c2.front();
+        }
+
+        // discount factors on a grid spanning the curve
+        Disposable<Array> sample(const YieldTermStructure& curve) {
+            const Size points = 20;
+            Time maxTime = curve.maxTime();
+            Array result(points);
+            for (Size i=0; i<points; ++i)
+                result[i] = curve.discount(maxTime*(i+1)/points, true);
+            return result;
+        }
+
+    }
+
+    // Gauss-Seidel iteration over the curves of a cyclic component,
+    // repeated whenever any of the objects they observe changes
+    class MultiCurveBuilder::CyclicComponent : public Observer {
+      public:
+        CyclicComponent(
+            const std::vector<std::string>& names,
+            const std::vector<boost::shared_ptr<YieldTermStructure> >& curves,
+            const std::vector<RelinkableHandle<YieldTermStructure> >& handles,
+            Real accuracy,
+            Size maxIterations);
+        Size build();
+        void update();
+      private:
+        std::vector<std::string> names_;
+        std::vector<boost::shared_ptr<YieldTermStructure> > curves_;
+        std::vector<boost::shared_ptr<LazyObject> > lazyCurves_;
+        // copies sharing their links with the ones held by the helpers
+        std::vector<RelinkableHandle<YieldTermStructure> > handles_;
+        Real accuracy_;
+        Size maxIterations_;
+        bool built_, building_;
+    };
+
+    MultiCurveBuilder::CyclicComponent::CyclicComponent(
+            const std::vector<std::string>& names,
+            const std::vector<boost::shared_ptr<YieldTermStructure> >& curves,
+            const std::vector<RelinkableHandle<YieldTermStructure> >& handles,
+            Real accuracy,
+            Size maxIterations)
+    : names_(names), curves_(curves), handles_(handles),
+      accuracy_(accuracy), maxIterations_(maxIterations),
+      built_(false), building_(false) {
+        for (Size k=0; k<curves_.size(); ++k) {
+            lazyCurves_.push_back(
+                boost::dynamic_pointer_cast<LazyObject>(curves_[k]));
+            registerWithObservables(curves_[k]);
+        }
+    }
+
+    void MultiCurveBuilder::CyclicComponent::update() {
+        // the notifications sent while iterating come from the curves
+        if (!building_)
+            build();
+    }
+
+    Size MultiCurveBuilder::CyclicComponent::build() {
+        const Size n = curves_.size();
+        building_ = true;
+
+        // the curves are frozen, so that the notifications sent when
+        // one of them is recalculated don't cause the others to be
+        // recalculated lazily from a partially bootstrapped curve;
+        // for the same reason, until they are calculated in the first
+        // pass of the first build their handles are linked to a flat
+        // seed.  Later builds start from the current curves.
+        std::vector<Array> previous(n);
+        for (Size k=0; k<n; ++k) {
+            if (lazyCurves_[k])
+                lazyCurves_[k]->freeze();
+            if (built_)
+                previous[k] = sample(*curves_[k]);
+            else
+                handles_[k].linkTo(boost::shared_ptr<YieldTermStructure>(
+                         new FlatForward(curves_[k]->referenceDate(), 0.0,
+                                         curves_[k]->dayCounter())));
+        }
+
+        try {
+            for (Size iteration=1; ; ++iteration) {
+                Real change = 0.0;
+                for (Size k=0; k<n; ++k) {
+                    if (lazyCurves_[k])
+                        lazyCurves_[k]->recalculate();
+                    else
+                        curves_[k]->discount(0.0);
+                    if (iteration == 1)
+                        handles_[k].linkTo(curves_[k]);
+                    Array current = sample(*curves_[k]);
+                    if (previous[k].size() != current.size()) {
+                        change = QL_MAX_REAL;
+                    } else {
+                        for (Size j=0; j<current.size(); ++j)
+                            change = std::max(
+                                change, std::fabs(current[j]-previous[k][j]));
+                    }
+                    previous[k] = current;
+                }
+                if (change <= accuracy_) {
+                    built_ = true;
+                    building_ = false;
+                    return iteration;
+                }
+                if (iteration >= maxIterations_) {
+                    std::ostringstream names;
+                    for (Size k=0; k<n; ++k)
+                        names << (k == 0 ? "" : ", ") << names_[k];
+                    QL_FAIL("curves " << names.str() << " did not "
+                            "converge after " << iteration << " iterations; "
+                            "last change: " << change);
+                }
+            }
+        } catch (...) {
+            // back to lazy calculation
+            for (Size k=0; k<n; ++k) {
+                handles_[k].linkTo(curves_[k]);
+                if (lazyCurves_[k])
+                    lazyCurves_[k]->unfreeze();
+            }
+            built_ = building_ = false;
+            throw;
+        }
+    }
+
+
+    MultiCurveBuilder::MultiCurveBuilder(Real accuracy,
+                                         Size maxIterations,
+                                         bool concurrentCalculation)
+    : accuracy_(accuracy), maxIterations_(maxIterations),
+      concurrentCalculation_(concurrentCalculation), iterations_(0) {
+        QL_REQUIRE(maxIterations > 0, "null number of iterations given");
+    }
+
+    void MultiCurveBuilder::add(
+                        const std::string& name,
+                        const boost::shared_ptr<YieldTermStructure>& curve,
+                        const std::vector<std::string>& dependencies,
+                        const RelinkableHandle<YieldTermStructure>& handle) {
+        QL_REQUIRE(curve, "null curve given for " << name);
+        QL_REQUIRE(index_.find(name) == index_.end(),
+                   "curve " << name << " already added");
+        index_[name] = names_.size();
+        names_.push_back(name);
+        curves_.push_back(curve);
+        dependencies_.push_back(dependencies);
+        handles_.push_back(handle);
+        handles_.back().linkTo(curve);
+    }
+
+    const boost::shared_ptr<YieldTermStructure>&
+    MultiCurveBuilder::curve(const std::string& name) const {
+        std::map<std::string, Size>::const_iterator i = index_.find(name);
+        QL_REQUIRE(i != index_.end(), "unknown curve " << name);
+        return curves_[i->second];
+    }
+
+    std::vector<std::vector<MultiCurveBuilder::Component> >
+    MultiCurveBuilder::levels() const {
+        const Size n = names_.size();
+        std::vector<std::vector<Size> > graph(n);
+        for (Size i=0; i<n; ++i) {
+            for (Size k=0; k<dependencies_[i].size(); ++k) {
+                std::map<std::string, Size>::const_iterator j =
+                    index_.find(dependencies_[i][k]);
+                QL_REQUIRE(j != index_.end(),
+                           "curve " << names_[i] << " depends on unknown "
+                           "curve " << dependencies_[i][k]);
+                if (j->second != i)
+                    graph[i].push_back(j->second);
+            }
+        }
+
+        ComponentFinder finder(graph);
+        const std::vector<std::vector<Size> >& components =
+            finder.components();
+        std::vector<Size> level(components.size(), 0);
+        std::vector<std::vector<Component> > result;
+        for (Size c=0; c<components.size(); ++c) {
+            for (Size k=0; k<components[c].size(); ++k) {
+                Size i = components[c][k];
+                for (Size d=0; d<graph[i].size(); ++d) {
+                    Size c2 = finder.component(graph[i][d]);
+                    if (c2 != c)
+                        level[c] = std::max(level[c], level[c2]+1);
+                }
+            }
+            if (result.size() <= level[c])
+                result.resize(level[c]+1);
+            result[level[c]].push_back(components[c]);
+        }
+        for (Size l=0; l<result.size(); ++l)
+            std::sort(result[l].begin(), result[l].end(), precedes);
+        return result;
+    }
+
+    std::vector<std::vector<std::vector<std::string> > >
+    MultiCurveBuilder::schedule() const {
+        std::vector<std::vector<Component> > l = levels();
+        std::vector<std::vector<std::vector<std::string> > > result(l.size());
+        for (Size i=0; i<l.size(); ++i) {
+            result[i].resize(l[i].size());
+            for (Size j=0; j<l[i].size(); ++j)
+                for (Size k=0; k<l[i][j].size(); ++k)
+                    result[i][j].push_back(names_[l[i][j][k]]);
+        }
+        return result;
+    }
+
+    void MultiCurveBuilder::build() const {
+        std::vector<std::vector<Component> > l = levels();
+        iterations_ = 0;
+        // the previous components stop observing their curves
+        cyclic_.clear();
+        for (Size i=0; i<l.size(); ++i) {
+            const long n = static_cast<long>(l[i].size());
+            std::vector<std::string> errors(n);
+            std::vector<Size> iterations(n, 0);
+
+            // registration with the observables of the curves is not
+            // safe for concurrent execution; also, it's done after the
+            // previous levels are built, so that their notifications
+            // don't trigger a build of these components
+            std::vector<boost::shared_ptr<CyclicComponent> > cyclic(n);
+            for (long j=0; j<n; ++j) {
+                const Component& c = l[i][j];
+                if (c.size() > 1) {
+                    std::vector<std::string> names;
+                    std::vector<boost::shared_ptr<YieldTermStructure> >
+                                                                    curves;
+                    std::vector<RelinkableHandle<YieldTermStructure> >
+                                                                   handles;
+                    for (Size k=0; k<c.size(); ++k) {
+                        names.push_back(names_[c[k]]);
+                        curves.push_back(curves_[c[k]]);
+                        handles.push_back(handles_[c[k]]);
+                    }
+                    cyclic[j] = boost::shared_ptr<CyclicComponent>(
+                        new CyclicComponent(names, curves, handles,
+                                            accuracy_, maxIterations_));
+                    cyclic_.push_back(cyclic[j]);
+                }
+            }
+
+            #pragma omp parallel for schedule(dynamic) \
+                                            if(concurrentCalculation_)
+            for (long j=0; j<n; ++j) {
+                // exceptions can not leave the parallel region
+                try {
+                    if (cyclic[j]) {
+                        iterations[j] = cyclic[j]->build();
+                    } else {
+                        // calculation is triggered by any request of data
+                        curves_[l[i][j][0]]->discount(0.0);
+                    }
+                } catch (std::exception& e) {
+                    errors[j] = e.what();
+                }
+            }
+            for (long j=0; j<n; ++j) {
+                QL_REQUIRE(errors[j].empty(), errors[j]);
+                iterations_ = std::max(iterations_, iterations[j]);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,140 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multicurvebuilder.hpp
+    \brief scheduled calculation of a set of interdependent curves
+*/
+
+#ifndef quantlib_multi_curve_builder_hpp
+#define quantlib_multi_curve_builder_hpp
+
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Scheduled calculation of a set of interdependent curves
+    /*! Curves such as OIS, Ibor-forwarding and cross-currency ones
+        are usually bootstrapped separately and linked through the
+        discounting or forwarding handles of their helpers; left to
+        lazy calculation, they are built in whatever order they are
+        first asked for.  This class builds them as a set instead:
+
+        - each curve is added with a name and the names of the curves
+          its helpers depend on; the dependency of a curve on itself
+          (e.g., an OIS curve discounting its own helpers) is handled
+          by its bootstrap and is ignored;
+        - the dependency graph is split into strongly connected
+          components, which are sorted in levels so that every
+          component only depends on the ones in the previous levels;
+        - the components in a level are independent of each other and
+          can be built concurrently;
+        - the curves in a cyclic component are recalculated in turn
+          until their discount factors no longer change by more than
+          the given accuracy.
+
+        The dependencies must be declared, since the links between
+        helpers and curves are not visible from the outside.  For the
+        same reason, the curves in a cyclic component must be added
+        together with the handle through which the helpers of the
+        other curves use them; the builder links the handles to their
+        curves, except in the first pass over the component, when the
+        ones of the curves not yet calculated are linked to a flat
+        seed so that no curve is calculated from a partially
+        bootstrapped one.
+
+        After build(), the curves in a cyclic component are kept
+        frozen, since their lazy recalculation would use each other in
+        a partially bootstrapped state.  Instead, the builder observes
+        whatever the curves observe (e.g., their helpers) and iterates
+        the component again, starting from the current curves, as soon
+        as any of those notifies a change; the curves are recalculated
+        and notify their observers as usual.
+
+        \warning The curves in a cyclic component are rebuilt as soon
+                 as they are notified, not lazily; when several of
+                 their quotes are changed together, notifications can
+                 be deferred by means of
+                 ObservableSettings::disableUpdates(true) so that the
+                 component is rebuilt once per notified helper when
+                 updates are enabled again.  Curves added to the
+                 builder should only be recalculated by it; calling
+                 unfreeze() on them restores lazy recalculation with
+                 the problems described above.
+        \warning Concurrent calculation (enabled by passing
+                 <tt>concurrentCalculation = true</tt> when compiling
+                 with OpenMP) requires the curves in a level not to
+                 share helpers, quotes or mutable state other than the
+                 curves they depend on, which are already calculated
+                 when the level is built.  Also, the evaluation date
+                 must not be changed during the calculation, and the
+                 fixings needed by the helpers (if any) should be
+                 stored beforehand, since the IndexManager is not safe
+                 for concurrent insertion.
+
+        \test the curves are checked to reprice their helpers, and
+              their values are checked against the ones obtained by
+              concurrent calculation.  The curves in a cyclic
+              component are checked to follow their quotes after
+              build().
+    */
+    class MultiCurveBuilder {
+      public:
+        MultiCurveBuilder(Real accuracy = 1.0e-12,
+                          Size maxIterations = 50,
+                          bool concurrentCalculation = false);
+        //! adds a curve and the names of the curves it depends on
+        void add(const std::string& name,
+                 const boost::shared_ptr<YieldTermStructure>& curve,
+                 const std::vector<std::string>& dependencies =
+                                                std::vector<std::string>(),
+                 const RelinkableHandle<YieldTermStructure>& handle =
+                                     RelinkableHandle<YieldTermStructure>());
+        //! the added curve with the given name
+        const boost::shared_ptr<YieldTermStructure>&
+        curve(const std::string& name) const;
+        /*! the strongly connected components of the dependency graph,
+            sorted in levels; the components in each level only
+            depend on the ones in the previous levels.
+        */
+        std::vector<std::vector<std::vector<std::string> > >
+        schedule() const;
+        //! builds the curves in the order given by schedule()
+        void build() const;
+        //! iterations taken by the slowest cyclic component in build()
+        Size iterations() const { return iterations_; }
+      private:
+        typedef std::vector<Size> Component;
+        class CyclicComponent;
+        std::vector<std::vector<Component> > levels() const;
+        Real accuracy_;
+        Size maxIterations_;
+        bool concurrentCalculation_;
+        std::vector<std::string> names_;
+        std::vector<boost::shared_ptr<YieldTermStructure> > curves_;
+        std::vector<std::vector<std::string> > dependencies_;
+        std::vector<RelinkableHandle<YieldTermStructure> > handles_;
+        std::map<std::string, Size> index_;
+        mutable Size iterations_;
+        mutable std::vector<boost::shared_ptr<CyclicComponent> > cyclic_;
+    };
+
+}
+
+#endif
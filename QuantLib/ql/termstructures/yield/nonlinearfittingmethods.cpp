@@ -64,6 +64,33 @@ namespace QuantLib {
         return d;
     }
 
+    void ExponentialSplinesFitting::discountFunctionGradient(
+                                                       const Array& x, Time t,
+                                                       Array& gradient) const {
+        Size N = size();
+        Real kappa = x[N-1];
+        Real dkappa = 0.0;
+
+        if (!constrainAtZero_) {
+            for (Size i=0; i<N-1; ++i) {
+                Real e = std::exp(-kappa * (i+1) * t);
+                gradient[i] = e;
+                dkappa -= x[i] * (i+1) * t * e;
+            }
+        } else {
+            Real e1 = std::exp(-kappa * t);
+            Real coeff = 1.0;
+            for (Size i=0; i<N-1; ++i) {
+                Real e = std::exp(-kappa * (i+2) * t);
+                gradient[i] = e - e1;
+                dkappa -= x[i] * (i+2) * t * e;
+                coeff -= x[i];
+            }
+            dkappa -= coeff * t * e1;
+        }
+        gradient[N-1] = dkappa;
+    }
+
 
 
     NelsonSiegelFitting::NelsonSiegelFitting(const Array& weights,
@@ -91,6 +118,23 @@ namespace QuantLib {
         return d;
     }
 
+    void NelsonSiegelFitting::discountFunctionGradient(const Array& x,
+                                                       Time t,
+                                                       Array& gradient) const {
+        Real kappa = x[size()-1];
+        Real e = std::exp(-kappa*t);
+        Real g = (1.0 - e)/((kappa+QL_EPSILON)*(t+QL_EPSILON));
+        Real dg = (t*e/(t+QL_EPSILON) - g)/(kappa+QL_EPSILON);
+        Real zeroRate = x[0] + (x[1] + x[2])*g - x[2]*e;
+        DiscountFactor d = std::exp(-zeroRate * t);
+
+        // d(d)/dx = -t d dr/dx
+        gradient[0] = -t*d;
+        gradient[1] = -t*d*g;
+        gradient[2] = -t*d*(g - e);
+        gradient[3] = -t*d*((x[1] + x[2])*dg + x[2]*t*e);
+    }
+
 
     SvenssonFitting::SvenssonFitting(const Array& weights,
                                      boost::shared_ptr<OptimizationMethod> optimizationMethod)
@@ -120,6 +164,29 @@ namespace QuantLib {
         return d;
     }
 
+    void SvenssonFitting::discountFunctionGradient(const Array& x,
+                                                   Time t,
+                                                   Array& gradient) const {
+        Real kappa = x[size()-2];
+        Real kappa_1 = x[size()-1];
+        Real e = std::exp(-kappa*t);
+        Real g = (1.0 - e)/((kappa+QL_EPSILON)*(t+QL_EPSILON));
+        Real dg = (t*e/(t+QL_EPSILON) - g)/(kappa+QL_EPSILON);
+        Real e_1 = std::exp(-kappa_1*t);
+        Real g_1 = (1.0 - e_1)/((kappa_1+QL_EPSILON)*(t+QL_EPSILON));
+        Real dg_1 = (t*e_1/(t+QL_EPSILON) - g_1)/(kappa_1+QL_EPSILON);
+        Real zeroRate = x[0] + (x[1] + x[2])*g - x[2]*e + x[3]*(g_1 - e_1);
+        DiscountFactor d = std::exp(-zeroRate * t);
+
+        // d(d)/dx = -t d dr/dx
+        gradient[0] = -t*d;
+        gradient[1] = -t*d*g;
+        gradient[2] = -t*d*(g - e);
+        gradient[3] = -t*d*(g_1 - e_1);
+        gradient[4] = -t*d*((x[1] + x[2])*dg + x[2]*t*e);
+        gradient[5] = -t*d*x[3]*(dg_1 + t*e_1);
+    }
+
 
 
     CubicBSplinesFitting::CubicBSplinesFitting(const std::vector<Time>& knots,
@@ -190,6 +257,23 @@ namespace QuantLib {
         return d;
     }
 
+    void CubicBSplinesFitting::discountFunctionGradient(
+                                                       const Array&, Time t,
+                                                       Array& gradient) const {
+        // the discount function is linear in the coefficients
+        if (!constrainAtZero_) {
+            for (Size i=0; i<size_; ++i)
+                gradient[i] = splines_(i,t);
+        } else {
+            const Real T = 0.0;
+            Real ratio = splines_(N_,t)/splines_(N_,T);
+            for (Size i=0; i<size_; ++i) {
+                Integer j = i < N_ ? i : i+1;
+                gradient[i] = splines_(j,t) - splines_(j,T)*ratio;
+            }
+        }
+    }
+
 
     SimplePolynomialFitting::SimplePolynomialFitting(Natural degree,
                                                      bool constrainAtZero,
@@ -222,6 +306,15 @@ namespace QuantLib {
         }
         return d;
     }
+
+    void SimplePolynomialFitting::discountFunctionGradient(
+                                                       const Array&, Time t,
+                                                       Array& gradient) const {
+        for (Size i=0; i<size_; ++i)
+            gradient[i] = constrainAtZero_ ?
+                          BernsteinPolynomial::get(i+1,i+1,t) :
+                          BernsteinPolynomial::get(i,i,t);
+    }
 	
 	SpreadFittingMethod::SpreadFittingMethod(boost::shared_ptr<FittingMethod> method,
                         Handle<YieldTermStructure> discountCurve)
@@ -246,6 +339,12 @@ namespace QuantLib {
         return method_->discount(x, t)*discountingCurve_->discount(t, true)/rebase_;
     }
 
+    void SpreadFittingMethod::discountFunctionGradient(const Array& x, Time t,
+                                                       Array& gradient) const {
+        method_->discountGradient(x, t, gradient);
+        gradient *= discountingCurve_->discount(t, true)/rebase_;
+    }
+
 	void SpreadFittingMethod::init(){
 		//In case discount curve has a different reference date,
 		//discount to this curve's reference date
@@ -54,6 +54,8 @@ namespace QuantLib {
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(const Array& x, Time t,
+                                      Array& gradient) const;
     };
 
 
@@ -77,6 +79,8 @@ namespace QuantLib {
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(const Array& x, Time t,
+                                      Array& gradient) const;
     };
 
 
@@ -102,6 +106,8 @@ namespace QuantLib {
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(const Array& x, Time t,
+                                      Array& gradient) const;
     };
 
 
@@ -138,6 +144,8 @@ namespace QuantLib {
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(const Array& x, Time t,
+                                      Array& gradient) const;
         BSpline splines_;
         Size size_;
         //! N_th basis function coefficient to solve for when d(0)=1
@@ -167,6 +175,8 @@ namespace QuantLib {
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(const Array& x, Time t,
+                                      Array& gradient) const;
         Size size_;
     };
 
@@ -185,6 +195,8 @@ namespace QuantLib {
 	  private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(const Array& x, Time t,
+                                      Array& gradient) const;
 		// underlying parametric method
 		boost::shared_ptr<FittingMethod> method_;
         // adjustment in case underlying discount curve has different reference date
@@ -28,6 +28,7 @@
 
 #include <ql/termstructures/iterativebootstrap.hpp>
 #include <ql/termstructures/localbootstrap.hpp>
+#include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
 
@@ -167,6 +168,11 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Bootstrap
+        //@{
+        //! bootstrapper used, e.g., to retrieve its diagnostics
+        const Bootstrap<this_curve>& bootstrap() const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -178,6 +184,7 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, DiscountFactor* df, Size n) const;
         // data members
         std::vector<boost::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -226,6 +233,13 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const B<PiecewiseYieldCurve<C,I,B> >&
+    PiecewiseYieldCurve<C,I,B>::bootstrap() const {
+        calculate();
+        return bootstrap_;
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
@@ -247,6 +261,14 @@ namespace QuantLib {
         return base_curve::discountImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseYieldCurve<C,I,B>::discountsImpl(const Time* t,
+                                                          DiscountFactor* df,
+                                                          Size n) const {
+        calculate();
+        base_curve::discountsImpl(t, df, n);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
         // just delegate to the bootstrapper
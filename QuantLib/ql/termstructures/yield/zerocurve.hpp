@@ -103,6 +103,7 @@ namespace QuantLib {
         //! \name ZeroYieldStructure implementation
         //@{
         Rate zeroYieldImpl(Time t) const;
+        void zeroYieldsImpl(const Time* t, Rate* r, Size n) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -170,6 +171,21 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::zeroYieldsImpl(const Time* t,
+                                                  Rate* r,
+                                                  Size n) const {
+        // the leading times on the curve are interpolated in one batch
+        Time tMax = this->times_.back();
+        Size m = 0;
+        while (m < n && t[m] <= tMax)
+            ++m;
+        if (m > 0)
+            this->interpolation_(t, r, m, true);
+        for (Size i=m; i<n; ++i)
+            r[i] = InterpolatedZeroCurve<T>::zeroYieldImpl(t[i]);
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
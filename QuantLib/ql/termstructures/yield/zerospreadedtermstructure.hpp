@@ -66,6 +66,8 @@ namespace QuantLib {
       protected:
         //! returns the spreaded zero yield rate
         Rate zeroYieldImpl(Time) const;
+        //! returns the spreaded zero yield rates in a single batch
+        void zeroYieldsImpl(const Time* t, Rate* r, Size n) const;
         //! returns the spreaded forward rate
         /* This method must disappear should the spread become a curve */
         Rate forwardImpl(Time) const;
@@ -138,6 +140,20 @@ namespace QuantLib {
         return spreadedRate.equivalentRate(Continuous, NoFrequency, t);
     }
 
+    inline void ZeroSpreadedTermStructure::zeroYieldsImpl(const Time* t,
+                                                          Rate* r,
+                                                          Size n) const {
+        originalCurve_->zeroRate(std::vector<Time>(t, t+n),
+                                 r, comp_, freq_, true);
+        Spread spread = spread_->value();
+        DayCounter dc = originalCurve_->dayCounter();
+        for (Size i=0; i<n; ++i) {
+            InterestRate spreadedRate(r[i] + spread, dc, comp_, freq_);
+            r[i] = spreadedRate.equivalentRate(Continuous, NoFrequency,
+                                               t[i]).rate();
+        }
+    }
+
     inline Rate ZeroSpreadedTermStructure::forwardImpl(Time t) const {
         return originalCurve_->forwardRate(t, t, comp_, freq_, true)
             + spread_->value();
@@ -76,6 +76,10 @@ namespace QuantLib {
         //@{
         //! zero-yield calculation
         virtual Rate zeroYieldImpl(Time) const = 0;
+        /*! batch zero-yield calculation; the default implementation
+            calls zeroYieldImpl(Time) for each time.
+        */
+        virtual void zeroYieldsImpl(const Time* t, Rate* r, Size n) const;
         //@}
 
         //! \name YieldTermStructure implementation
@@ -84,6 +88,10 @@ namespace QuantLib {
             from the zero yield.
         */
         DiscountFactor discountImpl(Time) const;
+        /*! Returns the discount factors for the given times
+            calculating them from the batch of zero yields.
+        */
+        void discountsImpl(const Time* t, DiscountFactor* df, Size n) const;
         //@}
     };
 
@@ -93,6 +93,27 @@ namespace QuantLib {
         if (jumps_.empty())
             return discountImpl(t);
 
+        return jumpEffect(t) * discountImpl(t);
+
+    }
+
+    void YieldTermStructure::discount(const std::vector<Time>& t,
+                                      DiscountFactor* df,
+                                      bool extrapolate) const {
+        checkRange(t, extrapolate);
+
+        if (t.empty())
+            return;
+
+        discountsImpl(&t[0], df, t.size());
+
+        if (!jumps_.empty()) {
+            for (Size i=0; i<t.size(); ++i)
+                df[i] *= jumpEffect(t[i]);
+        }
+    }
+
+    DiscountFactor YieldTermStructure::jumpEffect(Time t) const {
         DiscountFactor jumpEffect = 1.0;
         for (Size i=0; i<nJumps_; ++i) {
             if (jumpTimes_[i]>0 && jumpTimes_[i]<t) {
@@ -105,8 +126,14 @@ namespace QuantLib {
                 jumpEffect *= thisJump;
             }
         }
-        return jumpEffect * discountImpl(t);
+        return jumpEffect;
+    }
 
+    void YieldTermStructure::discountsImpl(const Time* t,
+                                           DiscountFactor* df,
+                                           Size n) const {
+        for (Size i=0; i<n; ++i)
+            df[i] = discountImpl(t[i]);
     }
 
     InterestRate YieldTermStructure::zeroRate(const Date& d,
@@ -139,6 +166,24 @@ namespace QuantLib {
                                          t);
     }
 
+    void YieldTermStructure::zeroRate(const std::vector<Time>& t,
+                                      Rate* rates,
+                                      Compounding comp,
+                                      Frequency freq,
+                                      bool extrapolate) const {
+        std::vector<Time> times(t);
+        for (Size i=0; i<times.size(); ++i) {
+            if (times[i]==0.0) times[i] = dt;
+        }
+        discount(times, rates, extrapolate);
+        DayCounter dc = dayCounter();
+        for (Size i=0; i<times.size(); ++i) {
+            rates[i] = InterestRate::impliedRate(1.0/rates[i],
+                                                 dc, comp, freq,
+                                                 times[i]).rate();
+        }
+    }
+
     InterestRate YieldTermStructure::forwardRate(const Date& d1,
                                                  const Date& d2,
                                                  const DayCounter& dayCounter,
@@ -184,6 +229,43 @@ namespace QuantLib {
                                          t2-t1);
     }
 
+    void YieldTermStructure::forwardRate(const std::vector<Time>& t1,
+                                         const std::vector<Time>& t2,
+                                         Rate* rates,
+                                         Compounding comp,
+                                         Frequency freq,
+                                         bool extrapolate) const {
+        QL_REQUIRE(t1.size() == t2.size(),
+                   "mismatch between start (" << t1.size() <<
+                   ") and end (" << t2.size() << ") times");
+        Size n = t1.size();
+        checkRange(t1, extrapolate);
+        checkRange(t2, extrapolate);
+        // all the discounts are calculated in a single batch; as in
+        // the scalar version, instantaneous forwards are calculated
+        // over a small interval around the given time.
+        std::vector<Time> times(2*n);
+        for (Size i=0; i<n; ++i) {
+            if (t2[i]==t1[i]) {
+                times[i] = std::max(t1[i] - dt/2.0, 0.0);
+                times[n+i] = times[i] + dt;
+            } else {
+                QL_REQUIRE(t2[i]>t1[i],
+                           "t2 (" << t2[i] << ") < t1 (" << t1[i] << ")");
+                times[i] = t1[i];
+                times[n+i] = t2[i];
+            }
+        }
+        std::vector<DiscountFactor> discounts(2*n);
+        discount(times, discounts.empty() ? 0 : &discounts[0], true);
+        DayCounter dc = dayCounter();
+        for (Size i=0; i<n; ++i) {
+            rates[i] = InterestRate::impliedRate(discounts[i]/discounts[n+i],
+                                                 dc, comp, freq,
+                                                 times[n+i]-times[i]).rate();
+        }
+    }
+
     void YieldTermStructure::update() {
         TermStructure::update();
         Date newReference = Date();
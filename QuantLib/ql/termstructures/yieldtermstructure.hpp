@@ -77,6 +77,13 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        /*! Writes in \c df the discount factors at the given times.
+            The range check is performed once for the whole batch and
+            derived classes can calculate all values in a single call.
+        */
+        void discount(const std::vector<Time>& t,
+                      DiscountFactor* df,
+                      bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -103,6 +110,15 @@ namespace QuantLib {
                               Compounding comp,
                               Frequency freq = Annual,
                               bool extrapolate = false) const;
+        /*! Writes in \c rates the zero-yield rates at the given
+            times, with the same day-counting rule used by the term
+            structure and the required compounding.
+        */
+        void zeroRate(const std::vector<Time>& t,
+                      Rate* rates,
+                      Compounding comp,
+                      Frequency freq = Annual,
+                      bool extrapolate = false) const;
         //@}
 
         /*! \name Forward rates
@@ -144,6 +160,17 @@ namespace QuantLib {
                                  Compounding comp,
                                  Frequency freq = Annual,
                                  bool extrapolate = false) const;
+        /*! Writes in \c rates the forward rates between the
+            corresponding elements of \c t1 and \c t2, with the same
+            day-counting rule used by the term structure and the
+            required compounding.
+        */
+        void forwardRate(const std::vector<Time>& t1,
+                         const std::vector<Time>& t2,
+                         Rate* rates,
+                         Compounding comp,
+                         Frequency freq = Annual,
+                         bool extrapolate = false) const;
         //@}
 
         //! \name Jump inspectors
@@ -167,10 +194,17 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        /*! batch discount factor calculation; the default
+            implementation calls discountImpl(Time) for each time.
+        */
+        virtual void discountsImpl(const Time* t,
+                                   DiscountFactor* df,
+                                   Size n) const;
         //@}
       private:
         // methods
         void setJumps();
+        DiscountFactor jumpEffect(Time t) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
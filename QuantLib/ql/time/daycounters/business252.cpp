@@ -25,50 +25,39 @@ namespace QuantLib {
 
     namespace {
 
-        typedef std::map<Year, std::map<Month, BigInteger> > Cache;
-        typedef std::map<Year, BigInteger> OuterCache;
-        
-        std::map<std::string, Cache> monthlyFigures_;
-        std::map<std::string, OuterCache> yearlyFigures_;
-
-        bool sameYear(const Date& d1, const Date& d2) {
-            return d1.year() == d2.year();
-        }
-
-        bool sameMonth(const Date& d1, const Date& d2) {
-            return d1.year() == d2.year() && d1.month() == d2.month();
-        }
-
-        BigInteger businessDays(Cache& cache,
-                                const Calendar& calendar,
-                                Month month, Year year) {
-            if (cache[year][month] == 0) {
-                // calculate and store.
-                Date d1 = Date(1,month,year);
-                Date d2 = d1 + 1*Months;
-                cache[year][month] = calendar.businessDaysBetween(d1, d2);
-            }
-            return cache[year][month];
-        }
-
-        BigInteger businessDays(OuterCache& outerCache,
-                                Cache& cache,
-                                const Calendar& calendar,
-                                Year year) {
-            if (outerCache[year] == 0) {
-                // calculate and store.
-                BigInteger total = 0;
-                for (Integer i=1; i<=12; ++i) {
-                    total += businessDays(cache,calendar,
-                                          Month(i), year);
+        typedef std::vector<Integer> Table;
+
+        // the tables are shared by the day counters using the same
+        // calendar; holidays added to or removed from the latter
+        // after its table is built are not taken into account.
+        boost::shared_ptr<Table> businessDayTable(const Calendar& calendar) {
+            // local, since day counters might be built during static
+            // initialization
+            static std::map<std::string, boost::shared_ptr<Table> > tables;
+            boost::shared_ptr<Table>& table = tables[calendar.name()];
+            if (!table) {
+                // the i-th element is the number of business days
+                // from Date::minDate() (included) to the i-th date
+                // after it (excluded), up to the day after maxDate()
+                BigInteger first = Date::minDate().serialNumber(),
+                           last = Date::maxDate().serialNumber();
+                table = boost::shared_ptr<Table>(new Table(last-first+2, 0));
+                Table& t = *table;
+                for (BigInteger i=first; i<=last; ++i) {
+                    t[i-first+1] = t[i-first];
+                    if (calendar.isBusinessDay(Date(i)))
+                        ++t[i-first+1];
                 }
-                outerCache[year] = total;
             }
-            return outerCache[year];
+            return table;
         }
 
     }
 
+    Business252::Impl::Impl(const Calendar& c)
+    : calendar_(c), table_(businessDayTable(c)),
+      first_(Date::minDate().serialNumber()) {}
+
     std::string Business252::Impl::name() const {
         std::ostringstream out;
         out << "Business/252(" << calendar_.name() << ")";
@@ -77,61 +66,16 @@ namespace QuantLib {
 
     BigInteger Business252::Impl::dayCount(const Date& d1,
                                            const Date& d2) const {
-        if (sameMonth(d1,d2) || d1 >= d2) {
-            // we treat the case of d1 > d2 here, since we'd need a
-            // second cache to get it right (our cached figures are
-            // for first included, last excluded and might have to be
-            // changed going the other way.)
-            return calendar_.businessDaysBetween(d1, d2);
-        } else if (sameYear(d1,d2)) {
-            Cache& cache = monthlyFigures_[calendar_.name()];
-            BigInteger total = 0;
-            Date d;
-            // first, we get to the beginning of next month.
-            d = Date(1,d1.month(),d1.year()) + 1*Months;
-            total += calendar_.businessDaysBetween(d1, d);
-            // then, we add any whole months (whose figures might be
-            // cached already) in the middle of our period.
-            while (!sameMonth(d,d2)) {
-                total += businessDays(cache, calendar_,
-                                      d.month(), d.year());
-                d += 1*Months;
-            }
-            // finally, we get to the end of the period.
-            total += calendar_.businessDaysBetween(d, d2);
-            return total;
-        } else {
-            Cache& cache = monthlyFigures_[calendar_.name()];
-            OuterCache& outerCache = yearlyFigures_[calendar_.name()];
-            BigInteger total = 0;
-            Date d;
-            // first, we get to the beginning of next year.
-            // The first bit gets us to the end of this month...
-            d = Date(1,d1.month(),d1.year()) + 1*Months;
-            total += calendar_.businessDaysBetween(d1, d);
-            // ...then we add any remaining months, possibly cached
-            for (Integer m = Integer(d1.month())+1; m <= 12; ++m) {
-                total += businessDays(cache, calendar_,
-                                      Month(m), d.year());
-            }
-            // then, we add any whole year in the middle of our period.
-            d = Date(1,January,d1.year()+1);
-            while (!sameYear(d,d2)) {
-                total += businessDays(outerCache, cache,
-                                      calendar_, d.year());
-                d += 1*Years;
-            }
-            // finally, we get to the end of the period.
-            // First, we add whole months...
-            for (Integer m = 1; m<Integer(d2.month()); ++m) {
-                total += businessDays(cache, calendar_,
-                                      Month(m), d2.year());
-            }
-            // ...then the last bit.
-            d = Date(1,d2.month(),d2.year());
-            total += calendar_.businessDaysBetween(d, d2);
-            return total;
-        }
+        // same as calendar_.businessDaysBetween(d1, d2), i.e., the
+        // first date is included and the last excluded; when going
+        // the other way, the count is the opposite of the one for
+        // (d2, d1] instead.
+        const Table& t = *table_;
+        if (d1 <= d2)
+            return t[d2.serialNumber()-first_] - t[d1.serialNumber()-first_];
+        else
+            return t[d2.serialNumber()-first_+1]
+                 - t[d1.serialNumber()-first_+1];
     }
 
     Time Business252::Impl::yearFraction(const Date& d1,
@@ -28,17 +28,22 @@
 #include <ql/time/daycounter.hpp>
 #include <ql/time/calendar.hpp>
 #include <ql/time/calendars/brazil.hpp>
+#include <vector>
 
 namespace QuantLib {
 
     //! Business/252 day count convention
-    /*! \ingroup daycounters */
+    /*! The business days between two dates are counted in constant
+        time as the difference between the cumulative counts from
+        Date::minDate(), which are tabulated once for each calendar.
+
+        \ingroup daycounters
+    */
     class Business252 : public DayCounter {
       private:
         class Impl : public DayCounter::Impl {
-          private:
-            Calendar calendar_;
           public:
+            typedef std::vector<Integer> Table;
             std::string name() const;
             BigInteger dayCount(const Date& d1,
                                 const Date& d2) const;
@@ -46,7 +51,11 @@ namespace QuantLib {
                               const Date& d2,
                               const Date&,
                               const Date&) const;
-            Impl(Calendar c) { calendar_ = c; }
+            explicit Impl(const Calendar& c);
+          private:
+            Calendar calendar_;
+            boost::shared_ptr<Table> table_;
+            BigInteger first_;
         };
       public:
         Business252(Calendar c = Brazil())
@@ -67,7 +67,9 @@
 /* Define this to have singletons return different instances for
    different sessions. You will have to provide and link with the
    library a sessionId() function in namespace QuantLib, returning a
-   different session id for each session.*/
+   different session id for each session; since it is called at each
+   access to a singleton, it should be cheap (e.g., return an id kept
+   in thread-local storage.) Boost.Thread is required.*/
 #ifndef QL_ENABLE_SESSIONS
 //#   define QL_ENABLE_SESSIONS
 #endif
@@ -86,4 +88,11 @@
 //#    define QL_HIGH_RESOLUTION_DATE
 #endif
 
+/* Define this to delegate matrix products to an external BLAS library
+   (e.g., OpenBLAS) through its CBLAS interface. The include path of
+   cblas.h and the BLAS library must be added to the project settings. */
+#ifndef QL_USE_BLAS
+//#    define QL_USE_BLAS
+#endif
+
 #endif
@@ -208,10 +208,61 @@ void ArrayTest::testArrayFunctions() {
 
 }
 
+void ArrayTest::testStorage() {
+
+    BOOST_TEST_MESSAGE("Testing array storage...");
+
+    // swapping and assigning arrays stored inside the object and on
+    // the heap, in all combinations
+    Size sizes[] = { 0, 1, 3, 4, 5, 10 };
+    const Size n = LENGTH(sizes);
+    for (Size i=0; i<n; ++i) {
+        for (Size j=0; j<n; ++j) {
+            Array a(sizes[i], 1.0, 1.0), b(sizes[j], -1.0, -1.0);
+            a.swap(b);
+            if (a != Array(sizes[j], -1.0, -1.0)
+                || b != Array(sizes[i], 1.0, 1.0))
+                BOOST_ERROR("failed to swap arrays of size "
+                            << sizes[i] << " and " << sizes[j]);
+            a = b;
+            if (a != b)
+                BOOST_ERROR("failed to assign array of size "
+                            << sizes[i] << " to array of size "
+                            << sizes[j]);
+            b = Array(sizes[j], 2.0);
+            if (b != Array(sizes[j], 2.0))
+                BOOST_ERROR("failed to assign temporary array of size "
+                            << sizes[j] << " to array of size "
+                            << sizes[i]);
+        }
+    }
+
+    // storage is recycled while an arena is alive...
+    Array survivor;
+    {
+        ArrayArena arena;
+        const Real* storage;
+        {
+            Array a(10, 1.0);
+            storage = a.begin();
+        }
+        Array b(10, 2.0);
+        if (b.begin() != storage)
+            BOOST_ERROR("storage not recycled by arena");
+        if (b != Array(10, 2.0))
+            BOOST_ERROR("wrong values in recycled storage");
+        survivor = b;
+    }
+    // ...and arrays outliving it are still valid
+    if (survivor != Array(10, 2.0))
+        BOOST_ERROR("wrong values in array outliving its arena");
+}
+
 test_suite* ArrayTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("array tests");
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testArrayFunctions));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testStorage));
     return suite;
 }
 
@@ -30,6 +30,9 @@
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/settings.hpp>
 
 using namespace QuantLib;
@@ -264,11 +267,138 @@ void CashFlowsTest::testNullFixingDays() {
         .withFixingDays(Null<Natural>());
 }
 
+void CashFlowsTest::testSinglePassYieldFunctions() {
+    BOOST_TEST_MESSAGE(
+        "Testing single-pass npv, bps, duration and convexity...");
+
+    SavedSettings backup;
+
+    Date today(15, March, 2015);
+    Settings::instance().evaluationDate() = today;
+    Date settlement = today + 3;
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(Date(10, June, 2012)).to(Date(10, June, 2025))
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(Unadjusted)
+        .backwards();
+
+    DayCounter bondDayCounter = ActualActual(ActualActual::ISMA);
+    std::vector<Real> notionals(1, 100.0);
+    notionals.push_back(80.0);
+    notionals.push_back(60.0);
+    Leg leg = FixedRateLeg(schedule)
+              .withNotionals(notionals)
+              .withCouponRates(0.04, bondDayCounter)
+              .withPaymentCalendar(TARGET())
+              .withPaymentAdjustment(Following);
+    leg.push_back(shared_ptr<CashFlow>(
+                              new SimpleCashFlow(60.0, Date(10, June, 2025))));
+
+    Compounding compoundings[] = {
+        Simple, Compounded, Continuous, SimpleThenCompounded
+    };
+    Duration::Type types[] = {
+        Duration::Simple, Duration::Modified, Duration::Macaulay
+    };
+    Rate yields[] = { 0.01, 0.035, 0.07 };
+    DayCounter dayCounters[] = { bondDayCounter, Thirty360() };
+
+    Real tolerance = 1.0e-12;
+
+    for (Size i=0; i<LENGTH(compoundings); ++i) {
+      for (Size j=0; j<LENGTH(yields); ++j) {
+        for (Size k=0; k<LENGTH(dayCounters); ++k) {
+          for (Size l=0; l<LENGTH(types); ++l) {
+            if (types[l] == Duration::Macaulay &&
+                compoundings[i] != Compounded)
+                continue;
+
+            InterestRate y(yields[j], dayCounters[k],
+                           compoundings[i], Semiannual);
+
+            Real npv, bps, convexity;
+            Time duration;
+            CashFlows::npvbpsDurationConvexity(leg, y, types[l], false,
+                                               settlement, settlement,
+                                               npv, bps,
+                                               duration, convexity);
+
+            Real expectedNpv = CashFlows::npv(leg, y, false, settlement);
+            Real expectedBps = CashFlows::bps(leg, y, false, settlement);
+            Time expectedDuration =
+                CashFlows::duration(leg, y, types[l], false, settlement);
+            Real expectedConvexity =
+                CashFlows::convexity(leg, y, false, settlement);
+
+            // bps must be the one calculated on the equivalent curve
+            FlatForward curve(settlement, yields[j], dayCounters[k],
+                              compoundings[i], Semiannual);
+            Real curveBps = CashFlows::bps(leg, curve, false, settlement);
+
+            if (std::fabs(npv - expectedNpv) > tolerance*expectedNpv
+                || std::fabs(bps - expectedBps) > tolerance*expectedNpv
+                || std::fabs(bps - curveBps) > tolerance*expectedNpv
+                || std::fabs(duration - expectedDuration) > tolerance
+                || std::fabs(convexity - expectedConvexity) > tolerance)
+                BOOST_ERROR("single-pass results differ from separate ones:"
+                            << "\n    yield:      " << y
+                            << "\n    npv:        " << npv
+                            << " (expected " << expectedNpv << ")"
+                            << "\n    bps:        " << bps
+                            << " (expected " << expectedBps
+                            << ", on curve " << curveBps << ")"
+                            << "\n    duration:   " << duration
+                            << " (expected " << expectedDuration << ")"
+                            << "\n    convexity:  " << convexity
+                            << " (expected " << expectedConvexity << ")");
+
+            // the solver must retrieve the yield from the npv
+            Rate impliedYield =
+                CashFlows::yield(leg, npv, dayCounters[k],
+                                 compoundings[i], Semiannual, false,
+                                 settlement, settlement, 1.0e-12);
+            if (std::fabs(impliedYield - yields[j]) > 1.0e-10)
+                BOOST_ERROR("failed to retrieve yield:"
+                            << "\n    yield:           " << y
+                            << "\n    implied yield:   " << impliedYield);
+
+            if (compoundings[i] == Continuous &&
+                types[l] == Duration::Modified) {
+                // check duration and convexity against finite differences
+                Spread h = 1.0e-5;
+                Real npvUp = CashFlows::npv(leg, yields[j]+h,
+                                            dayCounters[k], Continuous,
+                                            Semiannual, false, settlement);
+                Real npvDown = CashFlows::npv(leg, yields[j]-h,
+                                              dayCounters[k], Continuous,
+                                              Semiannual, false, settlement);
+                Time fdDuration = -(npvUp-npvDown)/(2*h*npv);
+                Real fdConvexity = (npvUp-2*npv+npvDown)/(h*h*npv);
+                if (std::fabs(duration - fdDuration) > 1.0e-6
+                    || std::fabs(convexity - fdConvexity) > 1.0e-2)
+                    BOOST_ERROR("finite-difference check failed:"
+                                << "\n    yield:        " << y
+                                << "\n    duration:     " << duration
+                                << " (numerical " << fdDuration << ")"
+                                << "\n    convexity:    " << convexity
+                                << " (numerical " << fdConvexity << ")");
+            }
+          }
+        }
+      }
+    }
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testAccessViolation));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testDefaultSettlementDate));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &CashFlowsTest::testSinglePassYieldFunctions));
     #ifndef QL_USE_INDEXED_COUPON
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testNullFixingDays));
     #endif
@@ -28,6 +28,7 @@ class CashFlowsTest {
     static void testAccessViolation();
     static void testDefaultSettlementDate();
     static void testNullFixingDays();
+    static void testSinglePassYieldFunctions();
     static boost::unit_test_framework::test_suite* suite();
 };
 
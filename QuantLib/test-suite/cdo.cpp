@@ -26,6 +26,11 @@
 #include <ql/experimental/credit/randomdefaultlatentmodel.hpp>
 #include <ql/experimental/credit/inhomogeneouspooldef.hpp>
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
+#include <ql/experimental/credit/fftlossmodel.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/boxmullergaussianrng.hpp>
+#include <ql/math/randomnumbers/haltonrsg.hpp>
+#include <ql/math/randomnumbers/sobolrsg.hpp>
 
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -37,6 +42,9 @@
 #include <ql/currencies/europe.hpp>
 #include <iomanip>
 #include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace QuantLib;
 using namespace std;
@@ -210,6 +218,13 @@ void CdoTest::testHW() {
             absoluteTolerance.push_back(10.);
             relativeToleranceMidp.push_back(0.5);
             relativeTolerancePeriod.push_back(0.5);
+            // FFT convolution
+            modelNames.push_back("FFT gaussian");
+            basketModels.push_back(boost::shared_ptr<DefaultLossModel>(new 
+                FFTGaussLossModel(gaussKtLossLM)));
+            absoluteTolerance.push_back(1.);
+            relativeToleranceMidp.push_back(0.04);
+            relativeTolerancePeriod.push_back(0.04);
             // Binomial...
             // Saddle point...
             // Recursive ...
@@ -244,6 +259,13 @@ void CdoTest::testHW() {
             absoluteTolerance.push_back(1.);
             relativeToleranceMidp.push_back(0.07);
             relativeTolerancePeriod.push_back(0.07);
+            // 4.-FFT convolution student T
+            modelNames.push_back("FFT studentT");
+            basketModels.push_back(boost::shared_ptr<DefaultLossModel>(new 
+                FFTStudentLossModel(TKtLossLM)));
+            absoluteTolerance.push_back(1.);
+            relativeToleranceMidp.push_back(0.04);
+            relativeTolerancePeriod.push_back(0.04);
             // SECOND MC
             // Binomial...
             // Saddle point...
@@ -359,9 +381,262 @@ void CdoTest::testHW() {
     }
 }
 
+namespace {
+
+    struct SimulationResults {
+        Real expectedLoss, percentile, expectedShortfall;
+    };
+
+    // a pool of identical names and the latent models on it
+    struct SimulationData {
+        Date horizon;
+        boost::shared_ptr<Basket> basket;
+        boost::shared_ptr<GaussianConstantLossLM> gaussianLM;
+        boost::shared_ptr<TConstantLossLM> studentLM;
+
+        SimulationData() {
+            Date asofDate(31, August, 2006);
+            Settings::instance().evaluationDate() = asofDate;
+            horizon = asofDate + 5*Years;
+
+            Size poolSize = 20;
+            Real recovery = 0.4;
+
+            Handle<Quote> hazardRate(
+                          boost::shared_ptr<Quote>(new SimpleQuote(0.02)));
+            boost::shared_ptr<DefaultProbabilityTermStructure> ptr(
+                   new FlatHazardRate(asofDate, hazardRate, ActualActual()));
+            vector<pair<DefaultProbKey,
+                   Handle<DefaultProbabilityTermStructure> > > probabilities;
+            probabilities.push_back(std::make_pair(
+                NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                           Period(0,Weeks), 10.),
+                Handle<DefaultProbabilityTermStructure>(ptr)));
+            boost::shared_ptr<Pool> pool(new Pool());
+            vector<string> names;
+            for (Size i=0; i<poolSize; ++i) {
+                ostringstream o;
+                o << "issuer-" << i;
+                names.push_back(o.str());
+                pool->add(names.back(), Issuer(probabilities),
+                          NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                                     Period(), 1.));
+            }
+            basket = boost::shared_ptr<Basket>(
+                new Basket(asofDate, names, vector<Real>(poolSize, 100.0),
+                           pool, 0.0, 0.2));
+
+            Handle<Quote> correlation(
+                           boost::shared_ptr<Quote>(new SimpleQuote(0.3)));
+            gaussianLM = boost::shared_ptr<GaussianConstantLossLM>(
+                new GaussianConstantLossLM(correlation,
+                    vector<Real>(poolSize, recovery),
+                    LatentModelIntegrationType::GaussianQuadrature, poolSize,
+                    GaussianCopulaPolicy::initTraits()));
+            TCopulaPolicy::initTraits initT;
+            initT.tOrders.push_back(5);
+            initT.tOrders.push_back(5);
+            studentLM = boost::shared_ptr<TConstantLossLM>(
+                new TConstantLossLM(correlation,
+                    vector<Real>(poolSize, recovery),
+                    LatentModelIntegrationType::GaussianQuadrature, poolSize,
+                    initT));
+        }
+    };
+
+    template <class Model>
+    SimulationResults simulate(const boost::shared_ptr<Basket>& basket,
+                               const boost::shared_ptr<Model>& model,
+                               const Date& date, Size threads) {
+        #ifdef _OPENMP
+        Size previousThreads = omp_get_max_threads();
+        omp_set_num_threads(threads);
+        #endif
+        basket->setLossModel(model);
+        SimulationResults results;
+        results.expectedLoss = basket->expectedTrancheLoss(date);
+        results.percentile = basket->percentile(date, 0.95);
+        results.expectedShortfall = basket->expectedShortfall(date, 0.95);
+        #ifdef _OPENMP
+        omp_set_num_threads(previousThreads);
+        #endif
+        return results;
+    }
+
+    void checkSameResults(const std::string& description,
+                          const SimulationResults& expected,
+                          const SimulationResults& calculated) {
+        if (expected.expectedLoss != calculated.expectedLoss
+            || expected.percentile != calculated.percentile
+            || expected.expectedShortfall != calculated.expectedShortfall)
+            BOOST_ERROR(description << " differ:"
+                        << "\n    expected loss:      "
+                        << expected.expectedLoss << " vs "
+                        << calculated.expectedLoss
+                        << "\n    percentile:         "
+                        << expected.percentile << " vs "
+                        << calculated.percentile
+                        << "\n    expected shortfall: "
+                        << expected.expectedShortfall << " vs "
+                        << calculated.expectedShortfall);
+    }
+
+    void checkConsistentResults(const std::string& description,
+                                const SimulationResults& results,
+                                Real trancheSize) {
+        if (results.expectedShortfall < results.percentile
+            || results.expectedShortfall > trancheSize
+            || results.expectedLoss <= 0.0)
+            BOOST_ERROR("inconsistent " << description << " statistics:"
+                        << "\n    expected loss:      "
+                        << results.expectedLoss
+                        << "\n    percentile:         "
+                        << results.percentile
+                        << "\n    expected shortfall: "
+                        << results.expectedShortfall
+                        << "\n    tranche notional:   " << trancheSize);
+    }
+
+    /* A low-discrepancy sequence whose instances all draw in turn from
+       the same generator, ignoring skipTo. When the simulation blocks
+       are run serially, they take their samples from a single unblocked
+       sequence. */
+    template <class LDS>
+    class UnblockedSequence {
+      public:
+        typedef typename LDS::sample_type sample_type;
+        UnblockedSequence(Size dimensionality, BigNatural seed) {
+            if (!generator_)
+                generator_ = boost::make_shared<LDS>(dimensionality, seed);
+        }
+        const sample_type& nextSequence() const {
+            return generator_->nextSequence();
+        }
+        void skipTo(unsigned long) {}
+        Size dimension() const { return generator_->dimension(); }
+        static void restart() { generator_.reset(); }
+      private:
+        static boost::shared_ptr<LDS> generator_;
+    };
+
+    template <class LDS>
+    boost::shared_ptr<LDS> UnblockedSequence<LDS>::generator_;
+
+    template <class Copula, class LDS, class LatentModel>
+    void checkBlockedSequence(const std::string& description,
+                              const SimulationData& data,
+                              const boost::shared_ptr<LatentModel>& model,
+                              Size numSims) {
+        SimulationResults blocked = simulate(data.basket,
+            boost::make_shared<RandomDefaultLM<Copula, LDS> >(
+                model, numSims), data.horizon, 1);
+        UnblockedSequence<LDS>::restart();
+        SimulationResults unblocked = simulate(data.basket,
+            boost::make_shared<RandomDefaultLM<Copula,
+                                               UnblockedSequence<LDS> > >(
+                model, numSims), data.horizon, 1);
+        checkSameResults("blocked and unblocked " + description
+                         + " simulations", unblocked, blocked);
+    }
+
+}
+
+void CdoTest::testRandomDefaultSimulation() {
+
+    BOOST_TEST_MESSAGE("Testing concurrent random default simulation...");
+
+    SavedSettings backup;
+
+    SimulationData data;
+    // more than one block of simulations
+    Size numSims = 5000;
+
+    typedef RandomDefaultLM<GaussianCopulaPolicy, RandomSequenceGenerator<
+        BoxMullerGaussianRng<MersenneTwisterUniformRng> > > GaussianModel;
+    typedef RandomDefaultLM<TCopulaPolicy, RandomSequenceGenerator<
+        PolarStudentTRng<MersenneTwisterUniformRng> > > StudentModel;
+
+    SimulationResults serial[2], concurrent[2];
+    serial[0] = simulate(data.basket, boost::make_shared<GaussianModel>(
+                             data.gaussianLM, numSims), data.horizon, 1);
+    concurrent[0] = simulate(data.basket, boost::make_shared<GaussianModel>(
+                                 data.gaussianLM, numSims), data.horizon, 4);
+    serial[1] = simulate(data.basket, boost::make_shared<StudentModel>(
+                             data.studentLM, numSims), data.horizon, 1);
+    concurrent[1] = simulate(data.basket, boost::make_shared<StudentModel>(
+                                 data.studentLM, numSims), data.horizon, 4);
+
+    const char* copulas[] = { "gaussian", "student" };
+    Real trancheSize = data.basket->trancheNotional();
+    for (Size i=0; i<2; ++i) {
+        checkSameResults(std::string("serial and concurrent ") + copulas[i]
+                         + " simulations", serial[i], concurrent[i]);
+        checkConsistentResults(copulas[i], serial[i], trancheSize);
+    }
+}
+
+void CdoTest::testBlockedSequenceSimulation() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing blocked low-discrepancy random default simulation...");
+
+    SavedSettings backup;
+
+    SimulationData data;
+    // several blocks of simulations, the last one incomplete
+    Size numSims = 5000;
+
+    checkBlockedSequence<GaussianCopulaPolicy, SobolRsg>(
+        "gaussian Sobol", data, data.gaussianLM, numSims);
+    checkBlockedSequence<TCopulaPolicy, SobolRsg>(
+        "student Sobol", data, data.studentLM, numSims);
+    checkBlockedSequence<GaussianCopulaPolicy, HaltonRsg>(
+        "gaussian Halton", data, data.gaussianLM, numSims);
+}
+
+void CdoTest::testPseudoRandomSequenceSimulation() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing random default simulation on uniform pseudo-random "
+        "sequences...");
+
+    SavedSettings backup;
+
+    SimulationData data;
+    // more than one block of simulations
+    Size numSims = 5000;
+
+    typedef RandomDefaultLM<GaussianCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> > GaussianModel;
+    typedef RandomDefaultLM<TCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> > StudentModel;
+
+    SimulationResults results[2], repeated[2];
+    results[0] = simulate(data.basket, boost::make_shared<GaussianModel>(
+                              data.gaussianLM, numSims), data.horizon, 1);
+    repeated[0] = simulate(data.basket, boost::make_shared<GaussianModel>(
+                               data.gaussianLM, numSims), data.horizon, 4);
+    results[1] = simulate(data.basket, boost::make_shared<StudentModel>(
+                              data.studentLM, numSims), data.horizon, 1);
+    repeated[1] = simulate(data.basket, boost::make_shared<StudentModel>(
+                               data.studentLM, numSims), data.horizon, 4);
+
+    const char* copulas[] = { "gaussian", "student" };
+    Real trancheSize = data.basket->trancheNotional();
+    for (Size i=0; i<2; ++i) {
+        checkSameResults(std::string("repeated ") + copulas[i]
+                         + " simulations", results[i], repeated[i]);
+        checkConsistentResults(copulas[i], results[i], trancheSize);
+    }
+}
+
 
 test_suite* CdoTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     suite->add(QUANTLIB_TEST_CASE(&CdoTest::testHW));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testRandomDefaultSimulation));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testBlockedSequenceSimulation));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &CdoTest::testPseudoRandomSequenceSimulation));
     return suite;
 }
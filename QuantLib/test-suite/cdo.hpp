@@ -28,6 +28,9 @@
 class CdoTest {
   public:
     static void testHW();
+    static void testRandomDefaultSimulation();
+    static void testBlockedSequenceSimulation();
+    static void testPseudoRandomSequenceSimulation();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -30,6 +30,7 @@
 #include <ql/cashflows/conundrumpricer.hpp>
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/lineartsrpricer.hpp>
+#include <ql/math/integrals/kronrodintegral.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/volatility/swaption/swaptionvolmatrix.hpp>
 #include <ql/termstructures/volatility/swaption/swaptionvolcube2.hpp>
@@ -494,10 +495,253 @@ void CmsTest::testParity() {
     }
 }
 
+namespace {
+
+    // counts the replication integrals actually calculated
+    class CountingIntegrator : public Integrator {
+      public:
+        CountingIntegrator()
+        : Integrator(1.0e-10, 5000), calls_(0),
+          integrator_(1.0e-10, 5000, 1.0e-10) {}
+        Size calls() const { return calls_; }
+      protected:
+        Real integrate(const boost::function<Real (Real)>& f,
+                       Real a, Real b) const {
+            ++calls_;
+            return integrator_(f, a, b);
+        }
+      private:
+        mutable Size calls_;
+        GaussKronrodNonAdaptive integrator_;
+    };
+
+}
+
+void CmsTest::testReplicationCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached replication integrals...");
+
+    CommonVars vars;
+
+    shared_ptr<SwapIndex> swapIndex(new
+        EuriborSwapIsdaFixA(10*Years,
+                            vars.iborIndex->forwardingTermStructure()));
+    Date startDate = vars.termStructure->referenceDate() + 5*Years;
+    Real nominal = 1.0;
+    Rate infiniteCap = Null<Real>();
+    Rate infiniteFloor = Null<Real>();
+
+    // coupons sharing the fixing date with different payment dates,
+    // gearings and strikes
+    std::vector<shared_ptr<CappedFlooredCmsCoupon> > coupons;
+    for (Size i=1; i<=2; ++i) {
+        Date paymentDate = startDate + Period(6*i, Months);
+        for (Rate strike = 0.03; strike < 0.08; strike += 0.02) {
+            coupons.push_back(shared_ptr<CappedFlooredCmsCoupon>(new
+                CappedFlooredCmsCoupon(paymentDate, nominal,
+                                       startDate, paymentDate,
+                                       swapIndex->fixingDays(), swapIndex,
+                                       Real(i), 0.0,
+                                       strike, infiniteFloor,
+                                       startDate, paymentDate,
+                                       vars.iborIndex->dayCounter())));
+            coupons.push_back(shared_ptr<CappedFlooredCmsCoupon>(new
+                CappedFlooredCmsCoupon(paymentDate, nominal,
+                                       startDate, paymentDate,
+                                       swapIndex->fixingDays(), swapIndex,
+                                       Real(i), 0.0,
+                                       infiniteCap, strike,
+                                       startDate, paymentDate,
+                                       vars.iborIndex->dayCounter())));
+        }
+    }
+
+    Handle<Quote> zeroMeanRev(shared_ptr<Quote>(new SimpleQuote(0.0)));
+    shared_ptr<CmsCouponPricer> pricers[] = {
+        shared_ptr<CmsCouponPricer>(new NumericHaganPricer(
+                 vars.atmVol, GFunctionFactory::ExactYield, zeroMeanRev)),
+        shared_ptr<CmsCouponPricer>(new LinearTsrPricer(vars.atmVol,
+                                                        zeroMeanRev))
+    };
+
+    Real tolerance = 1.0e-12;
+
+    for (Size i=0; i<LENGTH(pricers); ++i) {
+        // the first pass fills the cache and the following ones use
+        // it; they are checked against pricers with no cached data
+        // after the volatility and the curve are changed
+        for (Size pass=0; pass<3; ++pass) {
+            Handle<SwaptionVolatilityStructure> vol =
+                pass == 0 ? vars.atmVol : vars.SabrVolCube2;
+            if (pass == 1)
+                pricers[i]->setSwaptionVolatility(vol);
+            if (pass == 2)
+                vars.termStructure.linkTo(
+                    flatRate(vars.termStructure->referenceDate(), 0.04,
+                             Actual365Fixed()));
+
+            for (Size j=0; j<coupons.size(); ++j) {
+                coupons[j]->setPricer(pricers[i]);
+                Real cached = coupons[j]->price(vars.termStructure);
+
+                shared_ptr<CmsCouponPricer> fresh;
+                if (i == 0)
+                    fresh = shared_ptr<CmsCouponPricer>(new
+                        NumericHaganPricer(vol, GFunctionFactory::ExactYield,
+                                           zeroMeanRev));
+                else
+                    fresh = shared_ptr<CmsCouponPricer>(new
+                        LinearTsrPricer(vol, zeroMeanRev));
+                coupons[j]->setPricer(fresh);
+                Real expected = coupons[j]->price(vars.termStructure);
+
+                if (std::fabs(cached - expected) > tolerance)
+                    BOOST_FAIL("cached replication integral mismatch:"
+                               << "\n    pricer:           "
+                               << (i == 0 ? "numeric Hagan" : "linear TSR")
+                               << "\n    pass:             " << pass
+                               << "\n    coupon:           " << j
+                               << "\n    price:            " << cached
+                               << "\n    expected:         " << expected
+                               << "\n    error:            "
+                               << cached - expected);
+            }
+        }
+    }
+
+    // the integrals are reused for the same smile section; new ones
+    // are calculated when the swap rate moves, while the previous ones
+    // are kept in case the curve moves back
+    shared_ptr<CountingIntegrator> integrator(new CountingIntegrator);
+    shared_ptr<CmsCouponPricer> pricer(new
+        LinearTsrPricer(vars.atmVol, zeroMeanRev, Handle<YieldTermStructure>(),
+                        LinearTsrPricer::Settings(), integrator));
+    coupons[0]->setPricer(pricer);
+    coupons[0]->price(vars.termStructure);
+    Size calls = integrator->calls();
+    if (calls == 0)
+        BOOST_FAIL("no replication integral calculated");
+    coupons[0]->price(vars.termStructure);
+    if (integrator->calls() != calls)
+        BOOST_FAIL("cached replication integrals not reused:"
+                   << "\n    integrals on first pricing:  " << calls
+                   << "\n    integrals on second pricing: "
+                   << integrator->calls() - calls);
+
+    shared_ptr<YieldTermStructure> curve = *vars.termStructure;
+    vars.termStructure.linkTo(
+        flatRate(vars.termStructure->referenceDate(), 0.05,
+                 Actual365Fixed()));
+    coupons[0]->price(vars.termStructure);
+    if (integrator->calls() != 2*calls)
+        BOOST_FAIL("replication integrals not recalculated "
+                   "after the swap rate changed:"
+                   << "\n    integrals:          " << integrator->calls()
+                   << "\n    expected integrals: " << 2*calls);
+    vars.termStructure.linkTo(curve);
+    coupons[0]->price(vars.termStructure);
+    if (integrator->calls() != 2*calls)
+        BOOST_FAIL("replication integrals not reused "
+                   "after the swap rate was restored:"
+                   << "\n    integrals:          " << integrator->calls()
+                   << "\n    expected integrals: " << 2*calls);
+}
+
+void CmsTest::testInterleavedReplicationCache() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing cached replication integrals for interleaved legs...");
+
+    CommonVars vars;
+
+    shared_ptr<SwapIndex> swapIndexes[] = {
+        shared_ptr<SwapIndex>(new EuriborSwapIsdaFixA(10*Years,
+                            vars.iborIndex->forwardingTermStructure())),
+        shared_ptr<SwapIndex>(new EuriborSwapIsdaFixA(2*Years,
+                            vars.iborIndex->forwardingTermStructure()))
+    };
+    Date startDate = vars.termStructure->referenceDate() + 5*Years;
+    Real nominal = 1.0;
+
+    // the coupons of two legs on different indexes, priced in turn
+    std::vector<shared_ptr<CmsCoupon> > coupons;
+    for (Size i=0; i<4; ++i) {
+        Date accrualStart = startDate + Period(6*i, Months);
+        Date accrualEnd = accrualStart + 6*Months;
+        for (Size j=0; j<LENGTH(swapIndexes); ++j)
+            coupons.push_back(shared_ptr<CmsCoupon>(new
+                CmsCoupon(accrualEnd, nominal, accrualStart, accrualEnd,
+                          swapIndexes[j]->fixingDays(), swapIndexes[j],
+                          1.0, 0.0, accrualStart, accrualEnd,
+                          vars.iborIndex->dayCounter())));
+    }
+
+    Handle<Quote> zeroMeanRev(shared_ptr<Quote>(new SimpleQuote(0.0)));
+    shared_ptr<CountingIntegrator> integrator(new CountingIntegrator);
+    shared_ptr<CmsCouponPricer> pricers[] = {
+        shared_ptr<CmsCouponPricer>(new NumericHaganPricer(
+                 vars.SabrVolCube2, GFunctionFactory::ExactYield,
+                 zeroMeanRev)),
+        shared_ptr<CmsCouponPricer>(new LinearTsrPricer(
+                 vars.SabrVolCube2, zeroMeanRev, Handle<YieldTermStructure>(),
+                 LinearTsrPricer::Settings(), integrator))
+    };
+
+    Real tolerance = 1.0e-12;
+
+    for (Size i=0; i<LENGTH(pricers); ++i) {
+        Size calls = 0;
+        for (Size pass=0; pass<2; ++pass) {
+            for (Size j=0; j<coupons.size(); ++j) {
+                coupons[j]->setPricer(pricers[i]);
+                Real cached = coupons[j]->price(vars.termStructure);
+
+                shared_ptr<CmsCouponPricer> fresh;
+                if (i == 0)
+                    fresh = shared_ptr<CmsCouponPricer>(new
+                        NumericHaganPricer(vars.SabrVolCube2,
+                                           GFunctionFactory::ExactYield,
+                                           zeroMeanRev));
+                else
+                    fresh = shared_ptr<CmsCouponPricer>(new
+                        LinearTsrPricer(vars.SabrVolCube2, zeroMeanRev));
+                coupons[j]->setPricer(fresh);
+                Real expected = coupons[j]->price(vars.termStructure);
+
+                if (std::fabs(cached - expected) > tolerance)
+                    BOOST_FAIL("cached replication integral mismatch:"
+                               << "\n    pricer:           "
+                               << (i == 0 ? "numeric Hagan" : "linear TSR")
+                               << "\n    pass:             " << pass
+                               << "\n    coupon:           " << j
+                               << "\n    price:            " << cached
+                               << "\n    expected:         " << expected
+                               << "\n    error:            "
+                               << cached - expected);
+            }
+            // the integrals of both legs are kept while they are
+            // priced in turn, so the second pass needs none; they can
+            // be counted for the linear TSR pricer, which is given the
+            // integrator
+            if (pass == 0)
+                calls = integrator->calls();
+        }
+        if (i == 1 && calls == 0)
+            BOOST_FAIL("no replication integral calculated");
+        if (integrator->calls() != calls)
+            BOOST_FAIL("cached replication integrals not reused:"
+                       << "\n    integrals on first pass:  " << calls
+                       << "\n    integrals on second pass: "
+                       << integrator->calls() - calls);
+    }
+}
+
 test_suite* CmsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cms tests");
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCmsSwap));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testParity));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testReplicationCache));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testInterleavedReplicationCache));
     return suite;
 }
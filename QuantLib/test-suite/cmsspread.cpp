@@ -0,0 +1,280 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "cmsspread.hpp"
+#include "utilities.hpp"
+#include <ql/experimental/coupons/lognormalcmsspreadpricer.hpp>
+#include <ql/cashflows/lineartsrpricer.hpp>
+#include <ql/indexes/swap/euriborswap.hpp>
+#include <ql/math/integrals/kronrodintegral.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/volatility/swaption/swaptionconstantvol.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+using boost::shared_ptr;
+
+namespace {
+
+    struct CommonVars {
+        // global data
+        Date today;
+        shared_ptr<SimpleQuote> rate, volatility, correlation;
+        RelinkableHandle<YieldTermStructure> termStructure;
+        Handle<SwaptionVolatilityStructure> swaptionVol;
+        shared_ptr<SwapIndex> index1, index2;
+        shared_ptr<SwapSpreadIndex> spreadIndex;
+        shared_ptr<CmsCouponPricer> cmsPricer;
+        shared_ptr<CmsSpreadCoupon> coupon;
+
+        // cleanup
+        SavedSettings backup;
+
+        // setup
+        CommonVars() {
+            today = Date(20, October, 2015);
+            Settings::instance().evaluationDate() = today;
+
+            rate = shared_ptr<SimpleQuote>(new SimpleQuote(0.02));
+            termStructure.linkTo(shared_ptr<YieldTermStructure>(new
+                FlatForward(today, Handle<Quote>(rate), Actual365Fixed())));
+
+            volatility = shared_ptr<SimpleQuote>(new SimpleQuote(0.20));
+            swaptionVol = Handle<SwaptionVolatilityStructure>(
+                shared_ptr<SwaptionVolatilityStructure>(new
+                    ConstantSwaptionVolatility(today, TARGET(), Following,
+                                               Handle<Quote>(volatility),
+                                               Actual365Fixed())));
+
+            correlation = shared_ptr<SimpleQuote>(new SimpleQuote(0.6));
+
+            index1 = shared_ptr<SwapIndex>(new
+                EuriborSwapIsdaFixA(10*Years, termStructure));
+            index2 = shared_ptr<SwapIndex>(new
+                EuriborSwapIsdaFixA(2*Years, termStructure));
+            spreadIndex = shared_ptr<SwapSpreadIndex>(new
+                SwapSpreadIndex("CMS10Y-CMS2Y", index1, index2));
+
+            cmsPricer = shared_ptr<CmsCouponPricer>(new
+                LinearTsrPricer(swaptionVol, Handle<Quote>(
+                              shared_ptr<Quote>(new SimpleQuote(0.0)))));
+
+            Date start = TARGET().adjust(today + 5*Years);
+            Date end = TARGET().adjust(start + 1*Years);
+            coupon = shared_ptr<CmsSpreadCoupon>(new
+                CmsSpreadCoupon(end, 1.0, start, end,
+                                spreadIndex->fixingDays(), spreadIndex,
+                                1.0, 0.0, start, end, Actual365Fixed()));
+        }
+
+        shared_ptr<FloatingRateCouponPricer> spreadPricer() const {
+            return shared_ptr<FloatingRateCouponPricer>(new
+                LognormalCmsSpreadPricer(cmsPricer,
+                                         Handle<Quote>(correlation)));
+        }
+    };
+
+    /* undiscounted payoff of the optionlet on gearing1*S1 + gearing2*S2,
+       where S1 and S2 are correlated lognormal rates with the given
+       expectations, integrated over the bivariate normal density */
+    class SpreadOptionIntegrand {
+      public:
+        SpreadOptionIntegrand(Real phi, Real strike,
+                              Real gearing1, Real gearing2,
+                              Real mean1, Real mean2,
+                              Real stdDev, Real rho)
+        : phi_(phi), strike_(strike), g1_(gearing1), g2_(gearing2),
+          m1_(mean1), m2_(mean2), stdDev_(stdDev), rho_(rho),
+          integrator_(1.0e-12, 100000) {}
+        Real operator()(Real x) const {
+            x_ = x;
+            // the inner integral is split where the payoff has its kink
+            Real s1 = m1_*std::exp(-0.5*stdDev_*stdDev_ + stdDev_*x);
+            Real s2 = (strike_ - g1_*s1)/g2_;
+            Real kink = 8.0;
+            if (s2 > 0.0) {
+                Real z2 = (std::log(s2/m2_) + 0.5*stdDev_*stdDev_)/stdDev_;
+                kink = (z2 - rho_*x)/std::sqrt(1.0 - rho_*rho_);
+            }
+            kink = std::max(-8.0, std::min(kink, 8.0));
+            boost::function<Real (Real)> f =
+                std::bind1st(std::mem_fun(&SpreadOptionIntegrand::inner),
+                             this);
+            return density(x) *
+                (integrator_(f, -8.0, kink) + integrator_(f, kink, 8.0));
+        }
+      private:
+        Real inner(Real y) const {
+            Real z2 = rho_*x_ + std::sqrt(1.0 - rho_*rho_)*y;
+            Real s1 = m1_*std::exp(-0.5*stdDev_*stdDev_ + stdDev_*x_);
+            Real s2 = m2_*std::exp(-0.5*stdDev_*stdDev_ + stdDev_*z2);
+            return density(y) *
+                std::max(phi_*(g1_*s1 + g2_*s2 - strike_), 0.0);
+        }
+        static Real density(Real x) {
+            return M_1_SQRTPI*M_SQRT1_2*std::exp(-0.5*x*x);
+        }
+        Real phi_, strike_, g1_, g2_, m1_, m2_, stdDev_, rho_;
+        GaussKronrodAdaptive integrator_;
+        mutable Real x_;
+    };
+
+    // optionlet rate calculated by brute-force integration
+    Real bruteForceRate(const CommonVars& vars, Option::Type type,
+                        Rate strike) {
+        const CmsSpreadCoupon& c = *vars.coupon;
+        CmsCoupon c1(c.date(), c.nominal(), c.accrualStartDate(),
+                     c.accrualEndDate(), c.fixingDays(), vars.index1,
+                     1.0, 0.0, c.referencePeriodStart(),
+                     c.referencePeriodEnd(), c.dayCounter());
+        CmsCoupon c2(c.date(), c.nominal(), c.accrualStartDate(),
+                     c.accrualEndDate(), c.fixingDays(), vars.index2,
+                     1.0, 0.0, c.referencePeriodStart(),
+                     c.referencePeriodEnd(), c.dayCounter());
+        c1.setPricer(vars.cmsPricer);
+        c2.setPricer(vars.cmsPricer);
+
+        Time t = vars.swaptionVol->timeFromReference(c.fixingDate());
+        Real stdDev = vars.volatility->value() * std::sqrt(t);
+        Real phi = type == Option::Call ? 1.0 : -1.0;
+        SpreadOptionIntegrand f(phi, strike,
+                                vars.spreadIndex->gearing1(),
+                                vars.spreadIndex->gearing2(),
+                                c1.adjustedFixing(), c2.adjustedFixing(),
+                                stdDev, vars.correlation->value());
+        return GaussKronrodAdaptive(1.0e-10, 100000)(f, -8.0, 8.0);
+    }
+
+    void checkPricer(const CommonVars& vars,
+                     const shared_ptr<FloatingRateCouponPricer>& pricer,
+                     const std::string& market) {
+        // positive and negative strikes go through different integrals
+        Rate strikes[] = { -0.005, 0.0, 0.002, 0.008, 0.02 };
+        Real tolerance = 1.0e-9;
+
+        pricer->initialize(*vars.coupon);
+        for (Size i=0; i<LENGTH(strikes); ++i) {
+            Real caplet = pricer->capletRate(strikes[i]);
+            Real floorlet = pricer->floorletRate(strikes[i]);
+            Real expectedCaplet =
+                bruteForceRate(vars, Option::Call, strikes[i]);
+            Real expectedFloorlet =
+                bruteForceRate(vars, Option::Put, strikes[i]);
+            if (std::fabs(caplet - expectedCaplet) > tolerance ||
+                std::fabs(floorlet - expectedFloorlet) > tolerance)
+                BOOST_FAIL("failed to reproduce brute-force optionlets ("
+                           << market << "):"
+                           << std::setprecision(10)
+                           << "\n    strike:             " << strikes[i]
+                           << "\n    caplet rate:        " << caplet
+                           << "\n    expected:           " << expectedCaplet
+                           << "\n    floorlet rate:      " << floorlet
+                           << "\n    expected:           "
+                           << expectedFloorlet);
+        }
+    }
+
+}
+
+
+void CmsSpreadTest::testCouponPricing() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing lognormal CMS spread pricer against brute-force integration...");
+
+    CommonVars vars;
+
+    shared_ptr<FloatingRateCouponPricer> pricer = vars.spreadPricer();
+    checkPricer(vars, pricer, "base");
+
+    // the swaplet is the spread of the adjusted rates; a second pricer
+    // sharing nothing with the first must give the same results
+    shared_ptr<FloatingRateCouponPricer> other = vars.spreadPricer();
+    pricer->initialize(*vars.coupon);
+    other->initialize(*vars.coupon);
+    Real tolerance = 1.0e-14;
+    if (std::fabs(pricer->swapletRate() - other->swapletRate()) > tolerance ||
+        std::fabs(pricer->capletRate(0.004) - other->capletRate(0.004))
+                                                                > tolerance)
+        BOOST_FAIL("pricers with the same market disagree:"
+                   << std::setprecision(12)
+                   << "\n    swaplet rates: " << pricer->swapletRate()
+                   << ", " << other->swapletRate()
+                   << "\n    caplet rates:  " << pricer->capletRate(0.004)
+                   << ", " << other->capletRate(0.004));
+}
+
+
+void CmsSpreadTest::testMarketUpdate() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing lognormal CMS spread pricer after market updates...");
+
+    CommonVars vars;
+
+    // the pricer is used before each change, so that its cached
+    // marginals and node terms have to be refreshed
+    shared_ptr<FloatingRateCouponPricer> pricer = vars.spreadPricer();
+    Rate strike = 0.004;
+    pricer->initialize(*vars.coupon);
+    Real caplet = pricer->capletRate(strike);
+    Real swaplet = pricer->swapletRate();
+
+    struct Change {
+        shared_ptr<SimpleQuote> quote;
+        Real value;
+        std::string name;
+    } changes[] = {
+        { vars.rate, 0.025, "curve" },
+        { vars.correlation, 0.3, "correlation" },
+        { vars.volatility, 0.25, "volatility" }
+    };
+
+    for (Size i=0; i<LENGTH(changes); ++i) {
+        changes[i].quote->setValue(changes[i].value);
+
+        pricer->initialize(*vars.coupon);
+        Real newCaplet = pricer->capletRate(strike);
+        Real newSwaplet = pricer->swapletRate();
+        if (std::fabs(newCaplet - caplet) < 1.0e-6)
+            BOOST_FAIL("caplet rate unchanged after " << changes[i].name
+                       << " update:"
+                       << "\n    caplet rate: " << newCaplet);
+        // the correlation doesn't enter the adjusted rates
+        if (changes[i].name != "correlation" &&
+            std::fabs(newSwaplet - swaplet) < 1.0e-6)
+            BOOST_FAIL("swaplet rate unchanged after " << changes[i].name
+                       << " update:"
+                       << "\n    swaplet rate: " << newSwaplet);
+
+        checkPricer(vars, pricer, changes[i].name + " update");
+
+        caplet = newCaplet;
+        swaplet = newSwaplet;
+    }
+}
+
+
+test_suite* CmsSpreadTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("CMS spread tests");
+    suite->add(QUANTLIB_TEST_CASE(&CmsSpreadTest::testCouponPricing));
+    suite->add(QUANTLIB_TEST_CASE(&CmsSpreadTest::testMarketUpdate));
+    return suite;
+}
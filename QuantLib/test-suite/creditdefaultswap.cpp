@@ -557,6 +557,102 @@ void CreditDefaultSwapTest::testFairUpfront() {
             << "    calculated NPV:     " << fairNPV);
 }
 
+void CreditDefaultSwapTest::testEngineLegDataCache() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing credit-default swap engines after market changes...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(9,June,2006);
+    Date today = Settings::instance().evaluationDate();
+    Calendar calendar = TARGET();
+
+    boost::shared_ptr<SimpleQuote> hazardRate(new SimpleQuote(0.01234));
+    Handle<DefaultProbabilityTermStructure> probabilityCurve(
+        boost::shared_ptr<DefaultProbabilityTermStructure>(
+            new FlatHazardRate(0, calendar, Handle<Quote>(hazardRate),
+                               Actual360())));
+
+    boost::shared_ptr<SimpleQuote> riskFreeRate(new SimpleQuote(0.06));
+    Handle<YieldTermStructure> discountCurve(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(today, Handle<Quote>(riskFreeRate),
+                            Actual360())));
+
+    Date issueDate = calendar.advance(today, -1, Years);
+    Date maturity = calendar.advance(issueDate, 10, Years);
+    BusinessDayConvention convention = Following;
+
+    Schedule schedule =
+        MakeSchedule().from(issueDate)
+                      .to(maturity)
+                      .withFrequency(Quarterly)
+                      .withCalendar(calendar)
+                      .withTerminationDateConvention(convention)
+                      .withRule(DateGeneration::TwentiethIMM);
+
+    Rate fixedRate = 0.001;
+    DayCounter dayCount = Actual360();
+    Real notional = 10000.0;
+    Real recoveryRate = 0.4;
+
+    std::vector<boost::shared_ptr<PricingEngine> > engines;
+    engines.push_back(boost::shared_ptr<PricingEngine>(
+         new MidPointCdsEngine(probabilityCurve, recoveryRate,
+                               discountCurve)));
+    engines.push_back(boost::shared_ptr<PricingEngine>(
+         new IntegralCdsEngine(1*Weeks, probabilityCurve, recoveryRate,
+                               discountCurve)));
+
+    for (Size i=0; i<engines.size(); ++i) {
+        hazardRate->setValue(0.01234);
+        riskFreeRate->setValue(0.06);
+
+        CreditDefaultSwap cds(Protection::Seller, notional, fixedRate,
+                              schedule, convention, dayCount, true, true);
+        cds.setPricingEngine(engines[i]);
+        cds.NPV();
+
+        // the engine keeps the leg data of the first calculation; the
+        // results must be the same as the ones of a fresh engine.
+        hazardRate->setValue(0.02);
+        riskFreeRate->setValue(0.03);
+        Real cachedNpv = cds.NPV();
+
+        CreditDefaultSwap other(Protection::Seller, notional, fixedRate,
+                                schedule, convention, dayCount, true, true);
+        if (i == 0)
+            other.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new MidPointCdsEngine(probabilityCurve, recoveryRate,
+                                      discountCurve)));
+        else
+            other.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new IntegralCdsEngine(1*Weeks, probabilityCurve,
+                                      recoveryRate, discountCurve)));
+        Real expectedNpv = other.NPV();
+
+        if (std::fabs(cachedNpv - expectedNpv) > 1.0e-10)
+            BOOST_ERROR(
+                "Failed to reprice after market changes with engine #"
+                << i << "\n"
+                << std::setprecision(12)
+                << "    calculated NPV: " << cachedNpv << "\n"
+                << "    expected NPV:   " << expectedNpv);
+
+        // the same engine must also price a different swap correctly
+        other.setPricingEngine(engines[i]);
+        Real otherNpv = other.NPV();
+        if (std::fabs(otherNpv - expectedNpv) > 1.0e-10)
+            BOOST_ERROR(
+                "Failed to reprice a different swap with engine #"
+                << i << "\n"
+                << std::setprecision(12)
+                << "    calculated NPV: " << otherNpv << "\n"
+                << "    expected NPV:   " << expectedNpv);
+    }
+}
+
 
 test_suite* CreditDefaultSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Credit-default swap tests");
@@ -567,6 +663,8 @@ test_suite* CreditDefaultSwapTest::suite() {
                               &CreditDefaultSwapTest::testImpliedHazardRate));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairUpfront));
+    suite->add(QUANTLIB_TEST_CASE(
+                             &CreditDefaultSwapTest::testEngineLegDataCache));
     return suite;
 }
 
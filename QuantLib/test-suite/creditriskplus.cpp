@@ -119,8 +119,204 @@ void CreditRiskPlusTest::testReferenceValues() {
                    << cr.lossQuantile(0.99) << ", should be 250)");
 }
 
+void CreditRiskPlusTest::testIncrementalUpdate() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing incremental update of credit risk plus model...");
+
+    static const Real tol = 1E-10;
+
+    std::vector<Real> exposure, pd;
+    std::vector<Size> sector;
+    for (Size i = 0; i < 300; ++i) {
+        exposure.push_back(1.0 + 0.1 * (i % 37));
+        pd.push_back(0.005 + 0.001 * (i % 11));
+        sector.push_back(i % 3);
+    }
+
+    std::vector<Real> relativeDefaultVariance(3, 0.5 * 0.5);
+    relativeDefaultVariance[2] = 0.8 * 0.8;
+
+    Matrix rho(3, 3, 0.3);
+    for (Size i = 0; i < 3; ++i)
+        rho[i][i] = 1.0;
+
+    Real unit = 0.1;
+
+    CreditRiskPlus cr(exposure, pd, sector, relativeDefaultVariance, rho, unit);
+
+    // change a few obligors, including the largest exposure and one
+    // dropping out of the portfolio
+    std::vector<Size> obligor;
+    std::vector<Real> newExposure, newPd;
+    obligor.push_back(3);
+    newExposure.push_back(12.0);
+    newPd.push_back(0.02);
+    obligor.push_back(36);
+    newExposure.push_back(0.0);
+    newPd.push_back(0.01);
+    obligor.push_back(150);
+    newExposure.push_back(2.5);
+    newPd.push_back(0.003);
+    obligor.push_back(3);
+    newExposure.push_back(4.0);
+    newPd.push_back(0.015);
+
+    cr.updateExposures(obligor, newExposure, newPd);
+
+    for (Size k = 0; k < obligor.size(); ++k) {
+        exposure[obligor[k]] = newExposure[k];
+        pd[obligor[k]] = newPd[k];
+    }
+    CreditRiskPlus expected(exposure, pd, sector, relativeDefaultVariance,
+                            rho, unit);
+
+    if (std::fabs(cr.expectedLoss() - expected.expectedLoss()) > tol ||
+        std::fabs(cr.unexpectedLoss() - expected.unexpectedLoss()) > tol)
+        BOOST_FAIL("failed to reproduce expected and unexpected loss ("
+                   << cr.expectedLoss() << ", " << cr.unexpectedLoss()
+                   << ") after update, should be ("
+                   << expected.expectedLoss() << ", "
+                   << expected.unexpectedLoss() << ")");
+
+    for (Size i = 0; i < exposure.size(); ++i) {
+        if (std::fabs(cr.marginalLoss()[i] - expected.marginalLoss()[i]) >
+            tol)
+            BOOST_FAIL("failed to reproduce marginal loss #"
+                       << i << " (" << cr.marginalLoss()[i]
+                       << ") after update, should be "
+                       << expected.marginalLoss()[i]);
+    }
+
+    if (cr.loss().size() != expected.loss().size())
+        BOOST_FAIL("failed to reproduce loss distribution size ("
+                   << cr.loss().size() << ") after update, should be "
+                   << expected.loss().size());
+
+    for (Size i = 0; i < cr.loss().size(); ++i) {
+        if (std::fabs(cr.loss()[i] - expected.loss()[i]) > tol)
+            BOOST_FAIL("failed to reproduce loss probability #"
+                       << i << " (" << cr.loss()[i]
+                       << ") after update, should be "
+                       << expected.loss()[i]);
+    }
+}
+
+void CreditRiskPlusTest::testRejectedUpdate() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing that a rejected update leaves credit risk plus unchanged...");
+
+    static const Real tol = 1E-12;
+
+    std::vector<Real> exposure, pd;
+    std::vector<Size> sector;
+    for (Size i = 0; i < 100; ++i) {
+        exposure.push_back(1.0 + 0.1 * (i % 17));
+        pd.push_back(0.005 + 0.001 * (i % 7));
+        sector.push_back(i % 2);
+    }
+
+    std::vector<Real> relativeDefaultVariance(2, 0.6 * 0.6);
+
+    Matrix rho(2, 2, 0.2);
+    for (Size i = 0; i < 2; ++i)
+        rho[i][i] = 1.0;
+
+    Real unit = 0.1;
+
+    CreditRiskPlus cr(exposure, pd, sector, relativeDefaultVariance, rho, unit);
+    CreditRiskPlus reference(exposure, pd, sector, relativeDefaultVariance,
+                             rho, unit);
+
+    // the first change is valid, the second one is not; the whole update
+    // must be rejected before any obligor is modified
+    std::vector<Size> obligor;
+    std::vector<Real> newExposure, newPd;
+    obligor.push_back(5);
+    newExposure.push_back(7.0);
+    newPd.push_back(0.02);
+    obligor.push_back(40);
+    newExposure.push_back(3.0);
+    newPd.push_back(-0.01);
+
+    bool rejected = false;
+    try {
+        cr.updateExposures(obligor, newExposure, newPd);
+    } catch (Error &) {
+        rejected = true;
+    }
+    if (!rejected)
+        BOOST_FAIL("update with negative pd was not rejected");
+
+    // the same for an obligor out of range
+    obligor[1] = exposure.size();
+    newPd[1] = 0.01;
+    rejected = false;
+    try {
+        cr.updateExposures(obligor, newExposure, newPd);
+    } catch (Error &) {
+        rejected = true;
+    }
+    if (!rejected)
+        BOOST_FAIL("update with obligor out of range was not rejected");
+
+    if (std::fabs(cr.expectedLoss() - reference.expectedLoss()) > tol ||
+        std::fabs(cr.unexpectedLoss() - reference.unexpectedLoss()) > tol ||
+        std::fabs(cr.exposure() - reference.exposure()) > tol)
+        BOOST_FAIL("rejected update changed exposure, expected or "
+                   "unexpected loss ("
+                   << cr.exposure() << ", " << cr.expectedLoss() << ", "
+                   << cr.unexpectedLoss() << "), should be ("
+                   << reference.exposure() << ", "
+                   << reference.expectedLoss() << ", "
+                   << reference.unexpectedLoss() << ")");
+
+    for (Size i = 0; i < exposure.size(); ++i) {
+        if (std::fabs(cr.marginalLoss()[i] - reference.marginalLoss()[i]) >
+            tol)
+            BOOST_FAIL("rejected update changed marginal loss #"
+                       << i << " (" << cr.marginalLoss()[i]
+                       << "), should be " << reference.marginalLoss()[i]);
+    }
+
+    // a valid update afterwards must still reproduce a fresh model
+    obligor.pop_back();
+    newExposure.pop_back();
+    newPd.pop_back();
+    cr.updateExposures(obligor, newExposure, newPd);
+
+    exposure[obligor[0]] = newExposure[0];
+    pd[obligor[0]] = newPd[0];
+    CreditRiskPlus expected(exposure, pd, sector, relativeDefaultVariance,
+                            rho, unit);
+
+    if (std::fabs(cr.expectedLoss() - expected.expectedLoss()) > tol ||
+        std::fabs(cr.unexpectedLoss() - expected.unexpectedLoss()) > tol)
+        BOOST_FAIL("failed to reproduce expected and unexpected loss ("
+                   << cr.expectedLoss() << ", " << cr.unexpectedLoss()
+                   << ") after rejected and valid update, should be ("
+                   << expected.expectedLoss() << ", "
+                   << expected.unexpectedLoss() << ")");
+
+    if (cr.loss().size() != expected.loss().size())
+        BOOST_FAIL("failed to reproduce loss distribution size ("
+                   << cr.loss().size() << ") after rejected and valid "
+                   "update, should be " << expected.loss().size());
+
+    for (Size i = 0; i < cr.loss().size(); ++i) {
+        if (std::fabs(cr.loss()[i] - expected.loss()[i]) > tol)
+            BOOST_FAIL("failed to reproduce loss probability #"
+                       << i << " (" << cr.loss()[i]
+                       << ") after rejected and valid update, should be "
+                       << expected.loss()[i]);
+    }
+}
+
 test_suite *CreditRiskPlusTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("Credit risk plus tests");
     suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testReferenceValues));
+    suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testIncrementalUpdate));
+    suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testRejectedUpdate));
     return suite;
 }
@@ -30,6 +30,7 @@
 #include <ql/time/daycounters/business252.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/calendars/brazil.hpp>
+#include <ql/time/calendars/target.hpp>
 #include <ql/time/period.hpp>
 
 #include <iomanip>
@@ -293,6 +294,43 @@ void DayCounterTest::testBusiness252() {
     }
 }
 
+void DayCounterTest::testBusiness252Consistency() {
+
+    BOOST_TEST_MESSAGE("Testing business/252 day count against "
+                       "calendar business days...");
+
+    Calendar calendars[] = { Brazil(), TARGET() };
+    for (Size i=0; i<LENGTH(calendars); ++i) {
+        DayCounter dayCounter = Business252(calendars[i]);
+        for (Date d1 = Date(1,January,2002); d1 < Date(1,January,2030);
+             d1 += 37*Days) {
+            Date dates[] = { d1, d1 + 1*Days, d1 + 19*Days,
+                             d1 + 3*Months, d1 + 14*Months, d1 + 9*Years,
+                             d1 - 1*Days, d1 - 5*Months };
+            for (Size j=0; j<LENGTH(dates); ++j) {
+                BigInteger calculated = dayCounter.dayCount(d1, dates[j]);
+                BigInteger expected =
+                    calendars[i].businessDaysBetween(d1, dates[j]);
+                if (calculated != expected)
+                    BOOST_ERROR(dayCounter.name() << " from " << d1
+                                << " to " << dates[j] << ":\n"
+                                << "    calculated: " << calculated << "\n"
+                                << "    expected:   " << expected);
+            }
+        }
+    }
+
+    // extremes of the allowed range
+    DayCounter dayCounter = Business252();
+    Date first = Date::minDate(), last = Date::maxDate();
+    if (dayCounter.dayCount(first, last)
+        != Brazil().businessDaysBetween(first, last)
+        || dayCounter.dayCount(last, first)
+        != Brazil().businessDaysBetween(last, first))
+        BOOST_ERROR("wrong business/252 day count over the whole "
+                    "date range");
+}
+
 void DayCounterTest::testThirty360_BondBasis() {
 
     BOOST_TEST_MESSAGE("Testing thirty/360 day counter (Bond Basis)...");
@@ -464,6 +502,7 @@ test_suite* DayCounterTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testSimple));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testOne));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBusiness252));
+    suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBusiness252Consistency));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_BondBasis));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_EurobondBasis));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testIntraday));
@@ -0,0 +1,353 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "fittedbonds.hpp"
+#include "utilities.hpp"
+#include <ql/termstructures/yield/fittedbonddiscountcurve.hpp>
+#include <ql/termstructures/yield/nonlinearfittingmethods.hpp>
+#include <ql/termstructures/yield/bondhelpers.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/instruments/bonds/fixedratebond.hpp>
+#include <ql/pricingengines/bond/discountingbondengine.hpp>
+#include <ql/math/optimization/bfgs.hpp>
+#include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/math/optimization/goldstein.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/simpledaycounter.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <iomanip>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+using boost::shared_ptr;
+
+namespace {
+
+    typedef FittedBondDiscountCurve::FittingMethod FittingMethod;
+
+    struct CommonVars {
+        // global data
+        Date today;
+        Calendar calendar;
+        DayCounter dayCounter;
+        Handle<YieldTermStructure> marketCurve;
+        std::vector<shared_ptr<BondHelper> > bondHelpers;
+
+        // cleanup
+        SavedSettings backup;
+
+        // setup
+        CommonVars() {
+            calendar = TARGET();
+            today = calendar.adjust(Date(19, October, 2015));
+            Settings::instance().evaluationDate() = today;
+            dayCounter = SimpleDayCounter();
+
+            marketCurve = Handle<YieldTermStructure>(shared_ptr<
+                YieldTermStructure>(new FlatForward(today, 0.04,
+                                                    Actual365Fixed())));
+            shared_ptr<PricingEngine> engine(
+                                     new DiscountingBondEngine(marketCurve));
+
+            Integer lengths[] = { 2, 4, 6, 8, 10, 12, 14, 16,
+                                  18, 20, 22, 24, 26, 28, 30 };
+            Real coupons[] = { 0.0200, 0.0225, 0.0250, 0.0275, 0.0300,
+                               0.0325, 0.0350, 0.0375, 0.0400, 0.0425,
+                               0.0450, 0.0475, 0.0500, 0.0525, 0.0550 };
+
+            // the quoted prices are those on the market curve
+            for (Size i=0; i<LENGTH(lengths); ++i) {
+                Date maturity = calendar.advance(today, lengths[i]*Years);
+                Schedule schedule(today, maturity, Period(Annual), calendar,
+                                  ModifiedFollowing, ModifiedFollowing,
+                                  DateGeneration::Backward, false);
+                std::vector<Rate> coupon(1, coupons[i]);
+
+                FixedRateBond bond(0, 100.0, schedule, coupon, dayCounter,
+                                   ModifiedFollowing, 100.0);
+                bond.setPricingEngine(engine);
+                Handle<Quote> price(shared_ptr<Quote>(
+                                         new SimpleQuote(bond.cleanPrice())));
+
+                bondHelpers.push_back(shared_ptr<BondHelper>(
+                    new FixedRateBondHelper(price, 0, 100.0, schedule,
+                                            coupon, dayCounter,
+                                            ModifiedFollowing, 100.0)));
+            }
+        }
+
+        // one instance of each fitting method
+        std::vector<std::pair<std::string, shared_ptr<FittingMethod> > >
+        fittingMethods() const {
+            std::vector<Time> knots;
+            Time knotTimes[] = { -30.0, -20.0, 0.0, 5.0, 10.0, 15.0,
+                                 20.0, 25.0, 30.0, 40.0, 50.0 };
+            knots.assign(knotTimes, knotTimes+LENGTH(knotTimes));
+            Handle<YieldTermStructure> spreadCurve(shared_ptr<
+                YieldTermStructure>(new FlatForward(today, 0.02,
+                                                    Actual365Fixed())));
+
+            std::vector<std::pair<std::string,
+                                  shared_ptr<FittingMethod> > > methods;
+            methods.push_back(std::make_pair(
+                std::string("exponential splines"),
+                shared_ptr<FittingMethod>(new ExponentialSplinesFitting)));
+            methods.push_back(std::make_pair(
+                std::string("exponential splines (not constrained)"),
+                shared_ptr<FittingMethod>(
+                                     new ExponentialSplinesFitting(false))));
+            methods.push_back(std::make_pair(
+                std::string("Nelson-Siegel"),
+                shared_ptr<FittingMethod>(new NelsonSiegelFitting)));
+            methods.push_back(std::make_pair(
+                std::string("Svensson"),
+                shared_ptr<FittingMethod>(new SvenssonFitting)));
+            methods.push_back(std::make_pair(
+                std::string("cubic B-splines"),
+                shared_ptr<FittingMethod>(new CubicBSplinesFitting(knots))));
+            methods.push_back(std::make_pair(
+                std::string("simple polynomial"),
+                shared_ptr<FittingMethod>(new SimplePolynomialFitting(3))));
+            methods.push_back(std::make_pair(
+                std::string("spread on Nelson-Siegel"),
+                shared_ptr<FittingMethod>(new SpreadFittingMethod(
+                    shared_ptr<FittingMethod>(new NelsonSiegelFitting),
+                    spreadCurve))));
+            return methods;
+        }
+    };
+
+    void checkSameFit(const std::string& name,
+                      const FittingMethod& serial,
+                      const FittingMethod& concurrent) {
+        Array x = serial.solution(), y = concurrent.solution();
+        bool same = (x.size() == y.size()) &&
+            serial.minimumCostValue() == concurrent.minimumCostValue() &&
+            serial.numberOfIterations() == concurrent.numberOfIterations();
+        for (Size j=0; same && j<x.size(); ++j)
+            same = (x[j] == y[j]);
+        if (!same)
+            BOOST_ERROR("concurrent fit differs from serial fit for "
+                        << name << ":" << std::setprecision(16)
+                        << "\n    serial solution:     " << x
+                        << "\n    concurrent solution: " << y
+                        << "\n    serial cost:         "
+                        << serial.minimumCostValue()
+                        << "\n    concurrent cost:     "
+                        << concurrent.minimumCostValue()
+                        << "\n    serial iterations:     "
+                        << serial.numberOfIterations()
+                        << "\n    concurrent iterations: "
+                        << concurrent.numberOfIterations());
+    }
+
+}
+
+
+void FittedBondDiscountCurveTest::testDiscountGradients() {
+
+    BOOST_TEST_MESSAGE("Testing analytic gradients of fitting methods...");
+
+    CommonVars vars;
+
+    std::vector<std::pair<std::string, shared_ptr<FittingMethod> > >
+        methods = vars.fittingMethods();
+    Time times[] = { 0.0, 0.25, 1.0, 3.5, 7.0, 12.0, 20.0, 30.0 };
+
+    for (Size i=0; i<methods.size(); ++i) {
+        // no evaluations: the curve only initializes the method
+        FittedBondDiscountCurve curve(vars.today, vars.bondHelpers,
+                                      vars.dayCounter, *methods[i].second,
+                                      1.0e-10, 0);
+        const FittingMethod& method = curve.fitResults();
+
+        Size n = method.size();
+        Array x(n), y(n), gradient(n);
+        for (Size j=0; j<n; ++j)
+            x[j] = 0.02 + 0.01*j;
+
+        for (Size k=0; k<LENGTH(times); ++k) {
+            method.discountGradient(x, times[k], gradient);
+            y = x;
+            for (Size j=0; j<n; ++j) {
+                Real h = 1.0e-6;
+                y[j] = x[j] + h;
+                DiscountFactor up = method.discount(y, times[k]);
+                y[j] = x[j] - h;
+                DiscountFactor down = method.discount(y, times[k]);
+                y[j] = x[j];
+                Real expected = (up-down)/(2.0*h);
+                Real tolerance = 1.0e-7 * std::max(1.0, std::fabs(expected));
+                if (std::fabs(gradient[j] - expected) > tolerance)
+                    BOOST_ERROR("wrong gradient for " << methods[i].first
+                                << " method:" << std::setprecision(12)
+                                << "\n    parameter:  " << j
+                                << "\n    time:       " << times[k]
+                                << "\n    analytic:   " << gradient[j]
+                                << "\n    numerical:  " << expected
+                                << "\n    error:      "
+                                << gradient[j] - expected);
+            }
+        }
+    }
+}
+
+
+void FittedBondDiscountCurveTest::testConcurrentFit() {
+
+    BOOST_TEST_MESSAGE("Testing concurrent bond curve fitting...");
+
+    CommonVars vars;
+
+    const char* names[] = { "exponential splines (simplex)",
+                            "Nelson-Siegel (Levenberg-Marquardt)",
+                            "simple polynomial (BFGS)" };
+
+    for (Size i=0; i<LENGTH(names); ++i) {
+        // optimizers such as BFGS keep state between minimizations,
+        // so that each curve gets its own fitting method
+        shared_ptr<FittingMethod> methods[2];
+        for (Size k=0; k<2; ++k) {
+            switch (i) {
+              case 0:
+                methods[k] = shared_ptr<FittingMethod>(
+                                               new ExponentialSplinesFitting);
+                break;
+              case 1:
+                methods[k] = shared_ptr<FittingMethod>(
+                    new NelsonSiegelFitting(Array(),
+                        shared_ptr<OptimizationMethod>(
+                                                 new LevenbergMarquardt)));
+                break;
+              case 2:
+                methods[k] = shared_ptr<FittingMethod>(
+                    new SimplePolynomialFitting(3, true, Array(),
+                        shared_ptr<OptimizationMethod>(new BFGS)));
+                break;
+              default:
+                QL_FAIL("unknown fitting method");
+            }
+        }
+
+        FittedBondDiscountCurve serial(vars.today, vars.bondHelpers,
+                                       vars.dayCounter, *methods[0],
+                                       1.0e-10, 5000, Array(), 1.0, 100,
+                                       false);
+        FittedBondDiscountCurve concurrent(vars.today, vars.bondHelpers,
+                                           vars.dayCounter, *methods[1],
+                                           1.0e-10, 5000, Array(), 1.0, 100,
+                                           true);
+        checkSameFit(names[i],
+                     serial.fitResults(), concurrent.fitResults());
+
+        // same discount factors at the bond maturities
+        for (Size j=0; j<vars.bondHelpers.size(); ++j) {
+            Date d = vars.bondHelpers[j]->pillarDate();
+            if (serial.discount(d) != concurrent.discount(d))
+                BOOST_ERROR("concurrent fit differs from serial fit for "
+                            << names[i] << ":"
+                            << std::setprecision(16)
+                            << "\n    date:                " << d
+                            << "\n    serial discount:     "
+                            << serial.discount(d)
+                            << "\n    concurrent discount: "
+                            << concurrent.discount(d));
+        }
+    }
+}
+
+
+void FittedBondDiscountCurveTest::testGradientBasedFit() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing bond curve fitting with gradient-based optimizers...");
+
+    CommonVars vars;
+
+    // the prices come from a flat curve, which is reproduced closely by
+    // a cubic discount function; the cost is then quadratic in the
+    // coefficients and all optimizers must find the same minimum
+    SimplePolynomialFitting simplex(3);
+    FittedBondDiscountCurve reference(vars.today, vars.bondHelpers,
+                                      vars.dayCounter, simplex,
+                                      1.0e-10, 10000);
+    Array expected = reference.fitResults().solution();
+    Real expectedCost = reference.fitResults().minimumCostValue();
+
+    std::vector<std::pair<std::string,
+                          shared_ptr<OptimizationMethod> > > optimizers;
+    optimizers.push_back(std::make_pair(
+        std::string("BFGS"),
+        shared_ptr<OptimizationMethod>(new BFGS)));
+    optimizers.push_back(std::make_pair(
+        std::string("BFGS with Goldstein line search"),
+        shared_ptr<OptimizationMethod>(new BFGS(
+                       shared_ptr<LineSearch>(new GoldsteinLineSearch)))));
+
+    for (Size i=0; i<optimizers.size(); ++i) {
+        SimplePolynomialFitting method(3, true, Array(),
+                                       optimizers[i].second);
+        FittedBondDiscountCurve curve(vars.today, vars.bondHelpers,
+                                      vars.dayCounter, method,
+                                      1.0e-10, 10000);
+        Array calculated = curve.fitResults().solution();
+        Real cost = curve.fitResults().minimumCostValue();
+
+        if (cost > expectedCost + 1.0e-10)
+            BOOST_ERROR("higher cost with " << optimizers[i].first
+                        << " optimizer:" << std::setprecision(12)
+                        << "\n    calculated: " << cost
+                        << "\n    simplex:    " << expectedCost);
+
+        Real tolerance = 1.0e-5;
+        for (Size j=0; j<calculated.size(); ++j) {
+            if (std::fabs(calculated[j] - expected[j]) > tolerance)
+                BOOST_ERROR("wrong solution with " << optimizers[i].first
+                            << " optimizer:" << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    simplex:    " << expected);
+        }
+
+        // a cubic is as close as it gets to the market curve
+        for (Size j=0; j<vars.bondHelpers.size(); ++j) {
+            Date d = vars.bondHelpers[j]->pillarDate();
+            Real error = std::fabs(curve.discount(d) -
+                                   vars.marketCurve->discount(d));
+            if (error > 2.0e-3)
+                BOOST_ERROR("fitted curve far from market curve with "
+                            << optimizers[i].first << " optimizer:"
+                            << std::setprecision(8)
+                            << "\n    date:       " << d
+                            << "\n    calculated: " << curve.discount(d)
+                            << "\n    expected:   "
+                            << vars.marketCurve->discount(d));
+        }
+    }
+}
+
+
+test_suite* FittedBondDiscountCurveTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Fitted bond discount curve tests");
+    suite->add(QUANTLIB_TEST_CASE(
+                        &FittedBondDiscountCurveTest::testDiscountGradients));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &FittedBondDiscountCurveTest::testConcurrentFit));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &FittedBondDiscountCurveTest::testGradientBasedFit));
+    return suite;
+}
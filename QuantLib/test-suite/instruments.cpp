@@ -20,7 +20,11 @@
 #include "instruments.hpp"
 #include "utilities.hpp"
 #include <ql/instruments/stock.hpp>
+#include <ql/instruments/europeanoption.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/time/daycounters/actual360.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -61,9 +65,120 @@ void InstrumentTest::testObservable() {
 }
 
 
+namespace {
+
+    class CountingEngine : public AnalyticEuropeanEngine {
+      public:
+        CountingEngine(
+              const boost::shared_ptr<GeneralizedBlackScholesProcess>& p)
+        : AnalyticEuropeanEngine(p), calculations(0) {}
+        void calculate() const {
+            ++calculations;
+            AnalyticEuropeanEngine::calculate();
+        }
+        mutable Size calculations;
+    };
+
+}
+
+void InstrumentTest::testResultCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached instrument results...");
+
+    SavedSettings backup;
+
+    Date today = Date(15, March, 2016);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual360();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> rate(new SimpleQuote(0.03));
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new BlackScholesProcess(Handle<Quote>(spot),
+                                Handle<YieldTermStructure>(
+                                               flatRate(today, rate, dc)),
+                                Handle<BlackVolTermStructure>(
+                                               flatVol(today, vol, dc))));
+    boost::shared_ptr<CountingEngine> engine(new CountingEngine(process));
+
+    EuropeanOption option(
+        boost::shared_ptr<StrikedTypePayoff>(
+                                    new PlainVanillaPayoff(Option::Call, 105.0)),
+        boost::shared_ptr<Exercise>(
+                                new EuropeanExercise(today + 6*Months)));
+    option.setPricingEngine(engine);
+
+    std::vector<Handle<Quote> > quotes;
+    quotes.push_back(Handle<Quote>(spot));
+    quotes.push_back(Handle<Quote>(rate));
+    quotes.push_back(Handle<Quote>(vol));
+    option.enableResultCache(quotes);
+
+    Real npv = option.NPV(), delta = option.delta();
+
+    // bumping and restoring the quotes...
+    spot->setValue(101.0);
+    Real bumpedNPV = option.NPV();
+    vol->setValue(0.21);
+    option.NPV();
+    vol->setValue(0.20);
+    spot->setValue(100.0);
+    // ...gives back the original results without calculations
+    if (option.NPV() != npv || option.delta() != delta)
+        BOOST_ERROR("wrong results from cache:"
+                    << std::setprecision(12)
+                    << "\n    NPV:   " << option.NPV()
+                    << "\n    delta: " << option.delta()
+                    << "\n    expected:"
+                    << "\n    NPV:   " << npv
+                    << "\n    delta: " << delta);
+    spot->setValue(101.0);
+    if (option.NPV() != bumpedNPV)
+        BOOST_ERROR("wrong bumped NPV from cache:"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << option.NPV()
+                    << "\n    expected:   " << bumpedNPV);
+    if (engine->calculations != 3)
+        BOOST_ERROR("wrong number of calculations:"
+                    << "\n    calculated: " << engine->calculations
+                    << "\n    expected:   " << 3);
+
+    // the evaluation date is part of the key
+    Settings::instance().evaluationDate() = today + 1;
+    option.NPV();
+    Settings::instance().evaluationDate() = today;
+    option.NPV();
+    if (engine->calculations != 4)
+        BOOST_ERROR("evaluation date not taken into account:"
+                    << "\n    calculations: " << engine->calculations
+                    << "\n    expected:     " << 4);
+
+    // a new engine clears the cache...
+    option.setPricingEngine(engine);
+    option.NPV();
+    if (engine->calculations != 5)
+        BOOST_ERROR("cache not cleared with new engine:"
+                    << "\n    calculations: " << engine->calculations
+                    << "\n    expected:     " << 5);
+
+    // ...and so does disabling it
+    option.disableResultCache();
+    spot->setValue(100.0);
+    if (option.NPV() != npv || engine->calculations != 6)
+        BOOST_ERROR("wrong results with disabled cache:"
+                    << std::setprecision(12)
+                    << "\n    NPV:          " << option.NPV()
+                    << "\n    expected:     " << npv
+                    << "\n    calculations: " << engine->calculations
+                    << "\n    expected:     " << 6);
+}
+
+
 test_suite* InstrumentTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Instrument tests");
     suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testObservable));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testResultCache));
     return suite;
 }
 
@@ -28,6 +28,7 @@
 class InstrumentTest {
   public:
     static void testObservable();
+    static void testResultCache();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -27,11 +27,13 @@
 #include <ql/math/integrals/trapezoidintegral.hpp>
 #include <ql/math/integrals/kronrodintegral.hpp>
 #include <ql/math/integrals/gausslobattointegral.hpp>
+#include <ql/math/integrals/batchgausslobattointegral.hpp>
 #include <ql/math/integrals/discreteintegrals.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/termstructures/volatility/abcd.hpp>
 #include <ql/math/integrals/twodimensionalintegral.hpp>
+#include <ql/experimental/math/multidimgridintegrator.hpp>
 #include <boost/lambda/lambda.hpp>
 
 using namespace QuantLib;
@@ -127,6 +129,71 @@ void IntegralTest::testGaussLobatto() {
     // which is also ok, but not tested here
 }
 
+namespace {
+
+    // exp(-k x) for a number of decay rates k
+    class Exponentials {
+      public:
+        explicit Exponentials(const std::vector<Real>& k) : k_(k) {}
+        void operator()(const Array& x, Matrix& y) const {
+            for (Size i=0; i<x.size(); ++i)
+                for (Size j=0; j<k_.size(); ++j)
+                    y[i][j] = std::exp(-k_[j]*x[i]);
+        }
+      private:
+        std::vector<Real> k_;
+    };
+
+    class Exponential {
+      public:
+        explicit Exponential(Real k) : k_(k) {}
+        Real operator()(Real x) const { return std::exp(-k_*x); }
+      private:
+        Real k_;
+    };
+
+}
+
+void IntegralTest::testBatchGaussLobatto() {
+    BOOST_TEST_MESSAGE("Testing batch Gauss-Lobatto integration...");
+
+    Size maxEvaluations = 10000;
+    BatchGaussLobattoIntegral integrator(maxEvaluations, tolerance);
+    testSeveral(integrator);
+    testDegeneratedDomain(integrator);
+
+    std::vector<Real> k;
+    for (Real x=0.25; x<10.0; x*=2.0)
+        k.push_back(x);
+    Real a = 0.0, b = 3.0;
+
+    Array calculated =
+        integrator(Exponentials(k), k.size(), a, b);
+    Size evaluations = integrator.numberOfEvaluations();
+    Array reversed =
+        integrator(Exponentials(k), k.size(), b, a);
+
+    for (Size j=0; j<k.size(); ++j) {
+        Real expected = (1.0 - std::exp(-k[j]*b))/k[j];
+        Real scalar = integrator(Exponential(k[j]), a, b);
+        if (std::fabs(calculated[j]-expected) > tolerance
+            || std::fabs(scalar-expected) > tolerance
+            || std::fabs(reversed[j]+expected) > tolerance)
+            BOOST_FAIL(std::setprecision(10)
+                       << "integrating exp(-" << k[j] << " x)"
+                       << "\n    batch:      " << calculated[j]
+                       << "\n    scalar:     " << scalar
+                       << "\n    reversed:   " << reversed[j]
+                       << "\n    expected:   " << expected);
+        if (integrator.numberOfEvaluations() > evaluations)
+            BOOST_FAIL("the batch integration of " << k.size()
+                       << " components took " << evaluations
+                       << " evaluations, while the scalar integration "
+                       << "of exp(-" << k[j] << " x) alone took "
+                       << integrator.numberOfEvaluations());
+    }
+}
+
 void IntegralTest::testGaussKronrodNonAdaptive() {
     BOOST_TEST_MESSAGE("Testing non-adaptive Gauss-Kronrod integration...");
     Real precision = tolerance;
@@ -265,6 +332,104 @@ void IntegralTest::testDiscreteIntegrals() {
     }
 }
 
+namespace {
+
+    // E[1 + x_0^2 + x_1^2 x_2^2 + x_0 x_1 x_2] = 3 under a standard normal
+    Real normalMoments(const std::vector<Real>& x) {
+        Real r2 = 0.0;
+        for (Size i=0; i<x.size(); ++i)
+            r2 += x[i]*x[i];
+        return std::exp(-0.5*r2)/std::pow(M_TWOPI, 0.5*x.size())
+            * (1.0 + x[0]*x[0] + x[1]*x[1]*x[2]*x[2] + x[0]*x[1]*x[2]);
+    }
+
+    // same moments under a normal with variance 1/2, they sum up to 1.75;
+    // this is a polynomial times the Hermite weight, hence exactly
+    // integrated by both grids
+    Real hermiteMoments(const std::vector<Real>& x) {
+        Real r2 = 0.0;
+        for (Size i=0; i<x.size(); ++i)
+            r2 += x[i]*x[i];
+        return std::exp(-r2)/std::pow(M_PI, 0.5*x.size())
+            * (1.0 + x[0]*x[0] + x[1]*x[1]*x[2]*x[2] + x[0]*x[1]*x[2]);
+    }
+
+    Disposable<std::vector<Real> > vectorMoments(const std::vector<Real>& x) {
+        std::vector<Real> result(2);
+        result[0] = normalMoments(x);
+        result[1] = hermiteMoments(x);
+        return result;
+    }
+
+    Disposable<std::vector<Real> > batchMoments(
+                                const std::vector<std::vector<Real> >& x) {
+        std::vector<Real> result(x.size());
+        for (Size i=0; i<x.size(); ++i)
+            result[i] = normalMoments(x[i]);
+        return result;
+    }
+
+}
+
+void IntegralTest::testMultidimGridIntegration() {
+    BOOST_TEST_MESSAGE("Testing Gauss-Hermite integration on "
+                       "multidimensional grids...");
+
+    const Size dimensions[] = { 3, 5 };
+    const Size tensorOrders[] = { 25, 9 };
+    const Real normalTolerances[] = { 1.0e-8, 5.0e-3 };
+    for (Size d=0; d<LENGTH(dimensions); ++d) {
+        GaussHermiteGridIntegrator tensor(dimensions[d], tensorOrders[d]);
+        GaussHermiteGridIntegrator sparse(dimensions[d], 9,
+                                          GaussHermiteGridIntegrator::Sparse);
+
+        if (sparse.size() >= tensor.size())
+            BOOST_ERROR("sparse grid not smaller than the tensor grid in "
+                        << dimensions[d] << " dimensions"
+                        << "\n    sparse nodes: " << sparse.size()
+                        << "\n    tensor nodes: " << tensor.size());
+
+        const Real tol = 1.0e-10;
+        Real calculated = tensor(hermiteMoments);
+        if (std::fabs(calculated-1.75) > tol)
+            BOOST_ERROR("tensor grid integration failed in "
+                        << dimensions[d] << " dimensions"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << 1.75);
+        calculated = sparse(hermiteMoments);
+        if (std::fabs(calculated-1.75) > tol)
+            BOOST_ERROR("sparse grid integration failed in "
+                        << dimensions[d] << " dimensions"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << 1.75);
+
+        // standard normal moments converge slower
+        calculated = tensor(normalMoments);
+        if (std::fabs(calculated-3.0) > normalTolerances[d])
+            BOOST_ERROR("tensor grid integration failed in "
+                        << dimensions[d] << " dimensions"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << 3.0);
+
+        // vector and batch versions must agree with the scalar one
+        std::vector<Real> vectorResult = tensor.integrateV(vectorMoments);
+        Real batchResult = tensor.integrateBatch(batchMoments);
+        if (std::fabs(vectorResult[0]-calculated) > tol
+            || std::fabs(vectorResult[1]-1.75) > tol
+            || std::fabs(batchResult-calculated) > tol)
+            BOOST_ERROR("inconsistent grid integrations in "
+                        << dimensions[d] << " dimensions"
+                        << std::setprecision(12)
+                        << "\n    scalar:   " << calculated
+                        << "\n    vector:   " << vectorResult[0]
+                        << ", " << vectorResult[1]
+                        << "\n    batch:    " << batchResult);
+    }
+}
+
 utf::test_suite* IntegralTest::suite() {
     utf::test_suite* suite = BOOST_TEST_SUITE("Integration tests");
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testSegment));
@@ -274,9 +439,12 @@ utf::test_suite* IntegralTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testGaussKronrodAdaptive));
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testGaussKronrodNonAdaptive));
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testGaussLobatto));
+    suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testBatchGaussLobatto));
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testTwoDimensionalIntegration));
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testFolinIntegration));
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testDiscreteIntegrals));
+    suite->add(QUANTLIB_TEST_CASE(
+        &IntegralTest::testMultidimGridIntegration));
     return suite;
 }
 
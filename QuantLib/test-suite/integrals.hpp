@@ -34,9 +34,11 @@ class IntegralTest {
     static void testGaussKronrodAdaptive();
     static void testGaussKronrodNonAdaptive();
     static void testGaussLobatto();
+    static void testBatchGaussLobatto();
     static void testTwoDimensionalIntegration();
     static void testFolinIntegration();
     static void testDiscreteIntegrals();
+    static void testMultidimGridIntegration();
     static boost::unit_test_framework::test_suite* suite();
 };
 
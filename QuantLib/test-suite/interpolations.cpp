@@ -34,11 +34,13 @@
 #include <ql/math/interpolations/kernelinterpolation.hpp>
 #include <ql/math/interpolations/kernelinterpolation2d.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
+#include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/integrals/simpsonintegral.hpp>
 #include <ql/math/kernelfunctions.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/richardsonextrapolation.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <ql/experimental/volatility/noarbsabrinterpolation.hpp>
 #include <boost/foreach.hpp>
@@ -1981,6 +1983,67 @@ void InterpolationTest::testTransformations() {
 
 }
 
+void InterpolationTest::testLocate() {
+
+    BOOST_TEST_MESSAGE("Testing interval search from the last located point...");
+
+    const Size n = 50, points = 2000;
+    std::vector<Real> x(n), y(n);
+    for (Size i=0; i<n; ++i) {
+        x[i] = i + 0.01*i*i;
+        y[i] = std::sin(x[i]);
+    }
+
+    // random points, including the nodes and points out of range
+    MersenneTwisterUniformRng rng(42);
+    std::vector<Real> p(points);
+    for (Size i=0; i<points; ++i) {
+        if (i % 10 == 0)
+            p[i] = x[i % n];
+        else
+            p[i] = x.front() - 5.0 + (x.back() - x.front() + 10.0)*rng.nextReal();
+    }
+
+    LinearInterpolation linear(x.begin(), x.end(), y.begin());
+    Matrix z(n, n, 0.0);
+    BilinearInterpolation bilinear(x.begin(), x.end(), x.begin(), x.end(), z);
+    for (Size i=0; i<points; ++i) {
+        Size expected = std::min<Size>(
+            std::max<Integer>(std::upper_bound(x.begin(), x.end()-1, p[i])
+                              - x.begin() - 1, 0), n-2);
+        Size j = (i+1) % points;
+        if (bilinear.locateX(p[i]) != expected
+            || bilinear.locateY(p[j]) != std::min<Size>(
+                std::max<Integer>(std::upper_bound(x.begin(), x.end()-1, p[j])
+                                  - x.begin() - 1, 0), n-2))
+            BOOST_FAIL("wrong interval located for (" << p[i] << ", "
+                       << p[j] << ")");
+        Real calculated = linear(p[i], true);
+        Real value = y[expected] + (p[i]-x[expected])
+            * (y[expected+1]-y[expected])/(x[expected+1]-x[expected]);
+        if (std::fabs(calculated - value) > 1.0e-12)
+            BOOST_FAIL("wrong linear interpolation at " << p[i]
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << value);
+    }
+
+    // batch evaluation on sorted points
+    std::sort(p.begin(), p.end());
+    std::vector<Real> values(points);
+    CubicNaturalSpline spline(x.begin(), x.end(), y.begin());
+    spline(&p[0], &values[0], points, true);
+    CubicNaturalSpline reference(x.begin(), x.end(), y.begin());
+    for (Size i=0; i<points; ++i) {
+        // points in reverse order for the reference
+        Size k = points-1-i;
+        Real expected = reference(p[k], true);
+        if (values[k] != expected)
+            BOOST_FAIL("batch evaluation failed at " << p[k]
+                       << "\n    calculated: " << values[k]
+                       << "\n    expected:   " << expected);
+    }
+}
+
 test_suite* InterpolationTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Interpolation tests");
 
@@ -2013,5 +2076,6 @@ test_suite* InterpolationTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testNoArbSabrInterpolation));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testSabrSingleCases));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testTransformations));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testLocate));
     return suite;
 }
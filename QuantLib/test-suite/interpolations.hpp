@@ -52,6 +52,7 @@ class InterpolationTest {
     static void testNoArbSabrInterpolation();
     static void testSabrSingleCases();
     static void testTransformations();
+    static void testLocate();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -26,6 +26,7 @@
 #include <ql/math/randomnumbers/haltonrsg.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/seedgenerator.hpp>
+#include <ql/math/randomnumbers/sequencepartition.hpp>
 #include <ql/math/randomnumbers/primitivepolynomials.hpp>
 #include <ql/math/randomnumbers/randomizedlds.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
@@ -1093,6 +1094,64 @@ void LowDiscrepancyTest::testSobolSkipping() {
     }
 }
 
+namespace {
+
+    template <class RSG>
+    void checkPartition(const RSG& rsg, const std::string& name) {
+
+        const unsigned long samples = 1000;
+        const Size slices = 3;
+        const unsigned long granularity = 64;
+        const Size dimension = rsg.dimension();
+
+        // reference draws from a single generator
+        RSG reference(rsg);
+        std::vector<std::vector<Real> > expected(samples);
+        for (Size j=0; j<samples; ++j)
+            expected[j] = reference.nextSequence().value;
+
+        SequencePartition<RSG> partition(rsg, samples, slices, granularity);
+        unsigned long total = 0;
+        for (Size i=0; i<partition.size(); ++i) {
+            if (partition.start(i) != total)
+                BOOST_FAIL(name << ": slice #" << i << " not contiguous");
+            if (i < partition.size()-1 &&
+                partition.samples(i) % granularity != 0)
+                BOOST_FAIL(name << ": slice #" << i << " has "
+                           << partition.samples(i) << " draws");
+            RSG generator = partition.slice(i);
+            std::vector<Real> buffer(partition.samples(i)*dimension);
+            if (!buffer.empty())
+                generator.fill(&buffer[0], partition.samples(i));
+            for (Size j=0; j<partition.samples(i); ++j) {
+                for (Size k=0; k<dimension; ++k) {
+                    Real calculated = buffer[j*dimension+k];
+                    Real stored = expected[total+j][k];
+                    if (std::fabs(calculated-stored) > 1.0e-15)
+                        BOOST_FAIL(name << ": mismatch at draw #"
+                                   << total+j << ", dimension " << k
+                                   << "\n    expected:   " << stored
+                                   << "\n    calculated: " << calculated);
+                }
+            }
+            total += partition.samples(i);
+        }
+        if (total != samples)
+            BOOST_FAIL(name << ": " << total << " draws instead of "
+                       << samples);
+    }
+
+}
+
+void LowDiscrepancyTest::testSequencePartition() {
+
+    BOOST_TEST_MESSAGE("Testing partitioned low-discrepancy sequences...");
+
+    checkPartition(SobolRsg(10, 42, SobolRsg::JoeKuoD7), "Sobol");
+    checkPartition(HaltonRsg(10, 42, true, true), "Halton");
+    checkPartition(RandomizedLDS<SobolRsg>(SobolRsg(10)), "randomized Sobol");
+}
+
 
 test_suite* LowDiscrepancyTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Low-discrepancy sequence tests");
@@ -1131,6 +1190,8 @@ test_suite* LowDiscrepancyTest::suite() {
            &LowDiscrepancyTest::testSobolLevitanLemieuxSobolDiscrepancy));
 
     suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testSobolSkipping));
+    suite->add(QUANTLIB_TEST_CASE(
+           &LowDiscrepancyTest::testSequencePartition));
 
     suite->add(QUANTLIB_TEST_CASE(
            &LowDiscrepancyTest::testRandomizedLowDiscrepancySequence));
@@ -25,6 +25,7 @@
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/matrixutilities/symmetriceigendecomposition.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/matrixutilities/qrdecomposition.hpp>
 #include <ql/math/matrixutilities/basisincompleteordered.hpp>
@@ -470,14 +471,204 @@ void MatricesTest::testOrthogonalProjection() {
 
 }
 
+void MatricesTest::testProducts() {
+    BOOST_TEST_MESSAGE("Testing matrix products and transposition...");
+
+    // sizes not multiple of the block sizes used internally
+    const Size rows = 70, inner = 131, columns = 97;
+    const Real tolerance = 1.0e-12;
+
+    MersenneTwisterUniformRng rng(42);
+    Matrix a(rows, inner), b(inner, columns);
+    for (Matrix::iterator i = a.begin(); i != a.end(); ++i)
+        *i = rng.next().value - 0.5;
+    for (Matrix::iterator i = b.begin(); i != b.end(); ++i)
+        *i = rng.next().value - 0.5;
+    Array v(rows), w(inner);
+    for (Size i=0; i<rows; ++i)
+        v[i] = rng.next().value - 0.5;
+    for (Size i=0; i<inner; ++i)
+        w[i] = rng.next().value - 0.5;
+
+    Matrix c = a*b;
+    Real maxError = 0.0;
+    for (Size i=0; i<rows; ++i) {
+        for (Size j=0; j<columns; ++j) {
+            Real expected = 0.0;
+            for (Size k=0; k<inner; ++k)
+                expected += a[i][k]*b[k][j];
+            maxError = std::max(maxError, std::fabs(c[i][j]-expected));
+        }
+    }
+    if (maxError > tolerance)
+        BOOST_FAIL("matrix product failed"
+                   << "\n max error: " << maxError);
+
+    Matrix t = transpose(a);
+    if (t.rows() != inner || t.columns() != rows)
+        BOOST_FAIL("transposed matrix has wrong size ("
+                   << t.rows() << "x" << t.columns() << ")");
+    for (Size i=0; i<rows; ++i)
+        for (Size j=0; j<inner; ++j)
+            if (t[j][i] != a[i][j])
+                BOOST_FAIL("transposition failed at (" << i << "," << j
+                           << ")");
+
+    Array va = v*a, aw = a*w;
+    maxError = 0.0;
+    for (Size k=0; k<inner; ++k) {
+        Real expected = 0.0;
+        for (Size i=0; i<rows; ++i)
+            expected += v[i]*a[i][k];
+        maxError = std::max(maxError, std::fabs(va[k]-expected));
+    }
+    for (Size i=0; i<rows; ++i) {
+        Real expected = 0.0;
+        for (Size k=0; k<inner; ++k)
+            expected += a[i][k]*w[k];
+        maxError = std::max(maxError, std::fabs(aw[i]-expected));
+    }
+    if (maxError > tolerance)
+        BOOST_FAIL("matrix-vector product failed"
+                   << "\n max error: " << maxError);
+
+    Matrix o = outerProduct(v, w);
+    for (Size i=0; i<rows; ++i)
+        for (Size k=0; k<inner; ++k)
+            if (o[i][k] != v[i]*w[k])
+                BOOST_FAIL("outer product failed at (" << i << "," << k
+                           << ")");
+
+    // degenerate sizes
+    Matrix empty = Matrix(rows, 0)*Matrix(0, columns);
+    if (empty.rows() != rows || empty.columns() != columns ||
+        std::fabs(*std::max_element(empty.begin(), empty.end())) != 0.0)
+        BOOST_FAIL("product with null inner dimension failed");
+}
+
+void MatricesTest::testSymmetricEigenDecomposition() {
+    BOOST_TEST_MESSAGE("Testing Householder/QR symmetric eigensolver...");
+
+    const Size n = 60;
+    const Real tolerance = 1.0e-10;
+
+    MersenneTwisterUniformRng rng(1234);
+    Matrix a(n, n);
+    for (Size i=0; i<n; ++i)
+        for (Size j=0; j<=i; ++j)
+            a[i][j] = a[j][i] = rng.next().value - 0.5;
+
+    SymmetricEigenDecomposition dec(a);
+    SymmetricSchurDecomposition jacobi(a);
+    const Array& values = dec.eigenvalues();
+    const Matrix& vectors = dec.eigenvectors();
+
+    for (Size i=0; i<n; ++i) {
+        if (std::fabs(values[i] - jacobi.eigenvalues()[i]) > tolerance)
+            BOOST_FAIL("eigenvalue #" << i << " mismatch:"
+                       << "\n    Householder/QR: " << values[i]
+                       << "\n    Jacobi:         "
+                       << jacobi.eigenvalues()[i]);
+        if (i > 0 && values[i] > values[i-1])
+            BOOST_FAIL("eigenvalues not ordered");
+        // well separated for this seed, so the vectors are unique
+        // up to the sign, which is fixed by both algorithms
+        for (Size j=0; j<n; ++j)
+            if (std::fabs(vectors[j][i]-jacobi.eigenvectors()[j][i])
+                                                                > 1.0e-8)
+                BOOST_FAIL("eigenvector #" << i << " mismatch");
+    }
+
+    // reconstruction
+    Matrix d(n, n, 0.0);
+    for (Size i=0; i<n; ++i)
+        d[i][i] = values[i];
+    Real error = norm(vectors*d*transpose(vectors) - a);
+    if (error > tolerance)
+        BOOST_FAIL("failed to reconstruct the matrix"
+                   << "\n    error:     " << error
+                   << "\n    tolerance: " << tolerance);
+
+    // pseudo square root of a large correlation-like matrix, which
+    // goes through the Householder/QR solver; the second call is served
+    // by the cached decomposition
+    Matrix c = a*transpose(a);
+    for (Size i=0; i<n; ++i)
+        c[i][i] += 1.0;
+    SpectralDecompositionCache cache;
+    for (Size k=0; k<2; ++k) {
+        Matrix s = pseudoSqrt(c, SalvagingAlgorithm::None, cache);
+        error = norm(s*transpose(s) - c)/norm(c);
+        if (error > tolerance)
+            BOOST_FAIL("pseudoSqrt failed on call #" << k+1
+                       << "\n    relative error: " << error
+                       << "\n    tolerance:      " << tolerance);
+    }
+    if (cache.decompositions() != 1)
+        BOOST_FAIL("cached decomposition not reused"
+                   << "\n    decompositions: " << cache.decompositions());
+
+    // a different matrix must not be served from the cache
+    c[0][1] = c[1][0] = c[0][1] + 0.1;
+    Matrix s = rankReducedSqrt(c, n, 1.0, SalvagingAlgorithm::None, cache);
+    error = norm(s*transpose(s) - c)/norm(c);
+    if (cache.decompositions() != 2 || error > tolerance)
+        BOOST_FAIL("rankReducedSqrt failed after changing the matrix"
+                   << "\n    decompositions: " << cache.decompositions()
+                   << "\n    relative error: " << error
+                   << "\n    tolerance:      " << tolerance);
+}
+
+void MatricesTest::testConcurrentSqrt() {
+    BOOST_TEST_MESSAGE("Testing concurrent pseudo square roots...");
+
+    const Size n = 60, nMatrices = 4, nCalls = 32;
+    const Real tolerance = 1.0e-12;
+
+    // distinct correlation-like matrices and their serial square roots
+    MersenneTwisterUniformRng rng(4321);
+    std::vector<Matrix> c(nMatrices), expected(nMatrices);
+    for (Size k=0; k<nMatrices; ++k) {
+        Matrix a(n, n);
+        for (Size i=0; i<n; ++i)
+            for (Size j=0; j<n; ++j)
+                a[i][j] = rng.next().value - 0.5;
+        c[k] = a*transpose(a);
+        for (Size i=0; i<n; ++i)
+            c[k][i][i] += 1.0;
+        expected[k] = rankReducedSqrt(c[k], 10, 1.0,
+                                      SalvagingAlgorithm::Spectral);
+    }
+
+    // interleaved calls on different matrices from several threads;
+    // each call owns its decomposition, so none can see another's
+    std::vector<Matrix> results(nCalls);
+    #pragma omp parallel for schedule(dynamic)
+    for (long i=0; i<static_cast<long>(nCalls); ++i)
+        results[i] = rankReducedSqrt(c[i % nMatrices], 10, 1.0,
+                                     SalvagingAlgorithm::Spectral);
+
+    for (Size i=0; i<nCalls; ++i) {
+        const Matrix& e = expected[i % nMatrices];
+        Real error = norm(results[i] - e)/norm(e);
+        if (error > tolerance)
+            BOOST_FAIL("concurrent rankReducedSqrt failed on call #" << i
+                       << "\n    relative error: " << error
+                       << "\n    tolerance:      " << tolerance);
+    }
+}
 
 
 test_suite* MatricesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Matrix tests");
 
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testOrthogonalProjection));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testProducts));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testEigenvectors));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &MatricesTest::testSymmetricEigenDecomposition));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testSqrt));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testConcurrentSqrt));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testSVD));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testHighamSqrt));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testQRDecomposition));
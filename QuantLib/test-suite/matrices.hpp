@@ -29,7 +29,9 @@
 class MatricesTest {
   public:
     static void testEigenvectors();
+    static void testSymmetricEigenDecomposition();
     static void testSqrt();
+    static void testConcurrentSqrt();
     static void testHighamSqrt();
     static void testSVD();
     static void testQRDecomposition();
@@ -37,6 +39,7 @@ class MatricesTest {
     static void testInverse();
     static void testDeterminant();
     static void testOrthogonalProjection();
+    static void testProducts();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -33,6 +33,7 @@
 #include <ql/quotes/simplequote.hpp>
 #include <ql/currencies/europe.hpp>
 #include <iostream>
+#include <iomanip>
 
 using namespace QuantLib;
 using namespace std;
@@ -379,10 +380,84 @@ void NthToDefaultTest::testGaussStudent() {
     }
 }
 
+void NthToDefaultTest::testGridIntegration() {
+    BOOST_TEST_MESSAGE("Testing nth-to-default probabilities "
+                       "integrated on grids...");
+
+    SavedSettings backup;
+
+    Date asofDate(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+    Date maturity = asofDate + 5*Years;
+
+    Size names = 8;
+    std::vector<std::string> namesIds;
+    boost::shared_ptr<Pool> thePool = boost::make_shared<Pool>();
+    for (Size i=0; i<names; i++) {
+        namesIds.push_back(std::string("Name") +
+            boost::lexical_cast<std::string>(i));
+        Handle<Quote> h(boost::shared_ptr<Quote>(
+                                          new SimpleQuote(0.01*(i+1))));
+        Handle<DefaultProbabilityTermStructure> probability(
+            boost::shared_ptr<DefaultProbabilityTermStructure>(
+                new FlatHazardRate(asofDate, h, Actual365Fixed())));
+        std::vector<QuantLib::Issuer::key_curve_pair> curves(1,
+            std::make_pair(NorthAmericaCorpDefaultKey(
+                EURCurrency(), QuantLib::SeniorSec, Period(), 1.),
+                probability));
+        thePool->add(namesIds[i], Issuer(curves), NorthAmericaCorpDefaultKey(
+                EURCurrency(), QuantLib::SeniorSec, Period(), 1.));
+    }
+    boost::shared_ptr<Basket> basket(new Basket(asofDate, namesIds,
+        std::vector<Real>(names, 10.0), thePool, 0., 1.));
+
+    // two factors, so that the grids differ from the nested quadrature
+    std::vector<std::vector<Real> > factorWeights(names);
+    for (Size i=0; i<names; i++) {
+        factorWeights[i].push_back(std::sqrt(0.1 + 0.05*i));
+        factorWeights[i].push_back(std::sqrt(0.2));
+    }
+    std::vector<Real> recoveries(names, 0.4);
+
+    LatentModelIntegrationType::LatentModelIntegrationType types[] = {
+        LatentModelIntegrationType::GaussianQuadrature,
+        LatentModelIntegrationType::GaussianTensorGrid,
+        LatentModelIntegrationType::GaussianSparseGrid
+    };
+    const char* typeNames[] = { "quadrature", "tensor grid", "sparse grid" };
+    Real tolerances[] = { 0.0, 1.0e-10, 1.0e-7 };
+    std::vector<std::vector<Probability> > probabilities(LENGTH(types));
+    for (Size k=0; k<LENGTH(types); k++) {
+        basket->setLossModel(boost::shared_ptr<DefaultLossModel>(
+            new ConstantLossModel<GaussianCopulaPolicy>(factorWeights,
+                recoveries, types[k], GaussianCopulaPolicy::initTraits())));
+        for (Size n=1; n<=4; n++)
+            probabilities[k].push_back(
+                basket->probAtLeastNEvents(n, maturity));
+    }
+
+    for (Size k=1; k<LENGTH(types); k++) {
+        for (Size n=0; n<probabilities[k].size(); n++) {
+            Real diff = std::fabs(probabilities[k][n]-probabilities[0][n]);
+            if (diff > tolerances[k])
+                BOOST_ERROR("probability of " << n+1
+                            << " defaults or more integrated on "
+                            << typeNames[k] << " differs from quadrature"
+                            << std::setprecision(12)
+                            << "\n    " << typeNames[k] << ": "
+                            << probabilities[k][n]
+                            << "\n    quadrature: " << probabilities[0][n]
+                            << "\n    difference: " << diff
+                            << "\n    tolerance:  " << tolerances[k]);
+        }
+    }
+}
+
 test_suite* NthToDefaultTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Nth-to-default tests");
     suite->add(QUANTLIB_TEST_CASE(&NthToDefaultTest::testGauss));
     suite->add(QUANTLIB_TEST_CASE(&NthToDefaultTest::testGaussStudent));
+    suite->add(QUANTLIB_TEST_CASE(&NthToDefaultTest::testGridIntegration));
     return suite;
 }
 
@@ -29,6 +29,7 @@ class NthToDefaultTest {
   public:
     static void testGauss();
     static void testGaussStudent();
+    static void testGridIntegration();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -250,6 +250,70 @@ void ObservableTest::testMultiThreadingGlobalSettings() {
 #endif
 
 
+#ifdef QL_ENABLE_SESSIONS
+
+#include <ql/settings.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+
+namespace {
+
+    class SessionWorker {
+      public:
+        SessionWorker(Integer id, const Date& date, boost::barrier& start)
+        : id_(id), date_(date), start_(start), settings_(0),
+          failures_(0) {}
+        void operator()() {
+            setSessionId(id_);
+            // both threads create their session's singletons together
+            start_.wait();
+            Settings& settings = Settings::instance();
+            settings.evaluationDate() = date_;
+            settings_ = &settings;
+            for (Size i=0; i<10000; ++i) {
+                if (&Settings::instance() != settings_ ||
+                    Settings::instance().evaluationDate() != date_)
+                    ++failures_;
+            }
+        }
+        const Settings* settings() const { return settings_; }
+        Size failures() const { return failures_; }
+      private:
+        Integer id_;
+        Date date_;
+        boost::barrier& start_;
+        const Settings* settings_;
+        Size failures_;
+    };
+
+}
+
+void ObservableTest::testSessions() {
+    BOOST_TEST_MESSAGE("Testing singletons in concurrent sessions...");
+
+    SavedSettings backup;
+    const Date today = Settings::instance().evaluationDate();
+
+    boost::barrier start(2);
+    SessionWorker first(1, Date(15, March, 2016), start);
+    SessionWorker second(2, Date(20, June, 2017), start);
+    boost::thread firstThread(boost::ref(first));
+    boost::thread secondThread(boost::ref(second));
+    firstThread.join();
+    secondThread.join();
+
+    if (first.settings() == 0 || first.settings() == second.settings())
+        BOOST_FAIL("different sessions share their settings");
+    if (first.failures() != 0 || second.failures() != 0)
+        BOOST_FAIL("settings changed within a session ("
+                   << first.failures() << " and " << second.failures()
+                   << " mismatches)");
+    if (first.settings() == &Settings::instance() ||
+        Settings::instance().evaluationDate() != today)
+        BOOST_FAIL("sessions changed the settings of the main thread");
+}
+#endif
+
 
 test_suite* ObservableTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Observer tests");
@@ -262,6 +326,10 @@ test_suite* ObservableTest::suite() {
         &ObservableTest::testMultiThreadingGlobalSettings));
 #endif
 
+#ifdef QL_ENABLE_SESSIONS
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testSessions));
+#endif
+
     return suite;
 }
 
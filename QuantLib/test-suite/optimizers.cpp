@@ -33,6 +33,7 @@
 #include <ql/math/optimization/costfunction.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/optimization/differentialevolution.hpp>
+#include <ql/math/optimization/simulatedannealing.hpp>
 #include <ql/math/optimization/goldstein.hpp>
 
 using namespace QuantLib;
@@ -553,11 +554,73 @@ void OptimizersTest::testDifferentialEvolution() {
     }
 }
 
+void OptimizersTest::testConcurrentEvaluation() {
+    BOOST_TEST_MESSAGE("Testing concurrent evaluation in global optimizers...");
+
+    // the cost functions are thread-safe, and the results must not
+    // depend on whether the candidates are evaluated concurrently
+    Griewangk griewangk;
+    BoundaryConstraint constraint(-600.0, 600.0);
+    EndCriteria endCriteria(200, 50, 1e-12, 1e-10, Null<Real>());
+
+    DifferentialEvolution::Configuration conf =
+        DifferentialEvolution::Configuration()
+        .withStepsizeWeight(1.8)
+        .withBounds()
+        .withCrossoverProbability(0.9)
+        .withPopulationMembers(200)
+        .withStrategy(DifferentialEvolution::Rand1SelfadaptiveWithRotation)
+        .withAdaptiveCrossover()
+        .withSeed(3242);
+
+    // the populations are shuffled by means of std::rand
+    std::srand(42);
+    Problem serial(griewangk, constraint, Array(10, 100.0));
+    DifferentialEvolution(conf).minimize(serial, endCriteria);
+    std::srand(42);
+    Problem concurrent(griewangk, constraint, Array(10, 100.0));
+    DifferentialEvolution(conf.withConcurrentEvaluation())
+        .minimize(concurrent, endCriteria);
+
+    if (serial.functionValue() != concurrent.functionValue()
+        || serial.currentValue() != concurrent.currentValue())
+        BOOST_ERROR("differential evolution: concurrent evaluation "
+                    "changed the result"
+                    << "\n    serial:     " << serial.functionValue()
+                    << "\n    concurrent: " << concurrent.functionValue());
+
+    FirstDeJong deJong;
+    NoConstraint noConstraint;
+    EndCriteria saCriteria(2000, 100, 1e-8, 1e-8, Null<Real>());
+
+    Problem saSerial(deJong, noConstraint, Array(5, 5.0));
+    SimulatedAnnealing<>(0.2, 1.0, 0.01, 10,
+                         MersenneTwisterUniformRng(42))
+        .minimize(saSerial, saCriteria);
+    Problem saConcurrent(deJong, noConstraint, Array(5, 5.0));
+    SimulatedAnnealing<>(0.2, 1.0, 0.01, 10,
+                         MersenneTwisterUniformRng(42), true)
+        .minimize(saConcurrent, saCriteria);
+
+    if (saSerial.functionValue() != saConcurrent.functionValue()
+        || saSerial.currentValue() != saConcurrent.currentValue()
+        || saSerial.functionEvaluation() != saConcurrent.functionEvaluation())
+        BOOST_ERROR("simulated annealing: concurrent evaluation "
+                    "changed the result"
+                    << "\n    serial:     " << saSerial.functionValue()
+                    << " after " << saSerial.functionEvaluation()
+                    << " evaluations"
+                    << "\n    concurrent: " << saConcurrent.functionValue()
+                    << " after " << saConcurrent.functionEvaluation()
+                    << " evaluations");
+}
+
 test_suite* OptimizersTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Optimizers tests");
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::test));
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::nestedOptimizationTest));
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::testDifferentialEvolution));
+    suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::testConcurrentEvaluation));
     return suite;
 }
 
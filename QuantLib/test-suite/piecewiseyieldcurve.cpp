@@ -23,6 +23,8 @@
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/oisratehelper.hpp>
+#include <ql/termstructures/yield/multicurvebuilder.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/jointcalendar.hpp>
@@ -32,6 +34,7 @@
 #include <ql/time/imm.hpp>
 #include <ql/time/asx.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/ibor/eonia.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
 #include <ql/indexes/ibor/jpylibor.hpp>
 #include <ql/indexes/bmaindex.hpp>
@@ -759,6 +762,334 @@ void PiecewiseYieldCurveTest::testLocalBootstrapConsistency() {
 }
 
 
+void PiecewiseYieldCurveTest::testGlobalBootstrapConsistency() {
+    BOOST_TEST_MESSAGE(
+        "Testing consistency of global-bootstrap algorithm...");
+
+    CommonVars vars;
+    testCurveConsistency<Discount,LogLinear,GlobalBootstrap>(vars);
+    testBMACurveConsistency<Discount,LogLinear,GlobalBootstrap>(vars);
+
+    testCurveConsistency<ZeroYield,Cubic,GlobalBootstrap>(
+                   vars,
+                   Cubic(CubicInterpolation::Spline, true,
+                         CubicInterpolation::SecondDerivative, 0.0,
+                         CubicInterpolation::SecondDerivative, 0.0));
+    testBMACurveConsistency<ZeroYield,Cubic,GlobalBootstrap>(
+                   vars,
+                   Cubic(CubicInterpolation::Spline, true,
+                         CubicInterpolation::SecondDerivative, 0.0,
+                         CubicInterpolation::SecondDerivative, 0.0));
+}
+
+
+void PiecewiseYieldCurveTest::testGlobalBootstrapJacobian() {
+    BOOST_TEST_MESSAGE(
+        "Testing Jacobian returned by global-bootstrap algorithm...");
+
+    CommonVars vars;
+
+    Cubic interpolator(CubicInterpolation::Spline, true,
+                       CubicInterpolation::SecondDerivative, 0.0,
+                       CubicInterpolation::SecondDerivative, 0.0);
+    PiecewiseYieldCurve<ZeroYield,Cubic,IterativeBootstrap>
+        iterativeCurve(vars.settlement, vars.instruments, Actual360(),
+                       interpolator);
+    PiecewiseYieldCurve<ZeroYield,Cubic,GlobalBootstrap>
+        curve(vars.settlement, vars.instruments, Actual360(), interpolator);
+
+    // same curve as the iterative bootstrap
+    std::vector<Real> data = curve.data();
+    for (Size i=1; i<data.size(); ++i) {
+        Real error = std::fabs(data[i] - iterativeCurve.data()[i]);
+        if (error > 1.0e-10)
+            BOOST_ERROR("failed to reproduce iterative bootstrap at "
+                        << io::ordinal(i) << " pillar:"
+                        << std::setprecision(12)
+                        << "\n    global:    " << data[i]
+                        << "\n    iterative: " << iterativeCurve.data()[i]
+                        << "\n    error:     " << error);
+    }
+
+    // the Jacobian times the finite-difference derivatives of the
+    // curve data with respect to a quote must give a unit vector
+    Matrix jacobian = curve.bootstrap().jacobian();
+    Size n = jacobian.rows();
+    BOOST_REQUIRE(n == vars.instruments.size());
+    Real h = 1.0e-6, tolerance = 1.0e-4;
+    for (Size k=0; k<vars.instruments.size(); ++k) {
+        Size column = std::find(curve.dates().begin(), curve.dates().end(),
+                                vars.instruments[k]->pillarDate())
+                    - curve.dates().begin() - 1;
+        Real rate = vars.rates[k]->value();
+        vars.rates[k]->setValue(rate + h);
+        Array derivatives(n);
+        for (Size j=0; j<n; ++j)
+            derivatives[j] = (curve.data()[j+1] - data[j+1])/h;
+        vars.rates[k]->setValue(rate);
+
+        Array product = jacobian * derivatives;
+        for (Size i=0; i<n; ++i) {
+            Real expected = (i == column ? 1.0 : 0.0);
+            if (std::fabs(product[i] - expected) > tolerance)
+                BOOST_ERROR("wrong Jacobian for " << io::ordinal(k+1)
+                            << " quote, " << io::ordinal(i+1) << " row:"
+                            << "\n    calculated: " << product[i]
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
+
+namespace {
+
+    struct CurveSet {
+        MultiCurveBuilder builder;
+        std::map<std::string,
+                 std::vector<boost::shared_ptr<RateHelper> > > helpers;
+
+        CurveSet(const CommonVars& vars, bool concurrent)
+        : builder(1.0e-12, 50, concurrent) {
+            typedef PiecewiseYieldCurve<Discount,LogLinear> Curve;
+            std::vector<std::string> eonia(1, "EONIA");
+
+            // OIS curve discounting its own helpers
+            std::vector<boost::shared_ptr<RateHelper> >& oisHelpers =
+                helpers["EONIA"];
+            boost::shared_ptr<OvernightIndex> index(new Eonia);
+            for (Size i=0; i<vars.swaps; ++i) {
+                Handle<Quote> r(boost::shared_ptr<Quote>(
+                           new SimpleQuote(swapData[i].rate/100 - 0.002)));
+                oisHelpers.push_back(boost::shared_ptr<RateHelper>(
+                    new OISRateHelper(2, swapData[i].n*swapData[i].units,
+                                      r, index)));
+            }
+            boost::shared_ptr<YieldTermStructure> ois(
+                           new Curve(vars.settlement, oisHelpers, Actual360()));
+            builder.add("EONIA", ois);
+            Handle<YieldTermStructure> discountCurve(ois);
+
+            // forwarding curves discounted on the OIS curve
+            boost::shared_ptr<IborIndex> euribor6m(new Euribor6M),
+                                         euribor3m(new Euribor3M);
+            std::vector<boost::shared_ptr<RateHelper> >& helpers6m =
+                helpers["6M"];
+            std::vector<boost::shared_ptr<RateHelper> >& helpers3m =
+                helpers["3M"];
+            for (Size i=0; i<vars.swaps; ++i) {
+                Handle<Quote> r(vars.rates[i+vars.deposits]);
+                Handle<Quote> basis(boost::shared_ptr<Quote>(
+                                                  new SimpleQuote(-0.001)));
+                helpers6m.push_back(boost::shared_ptr<RateHelper>(
+                    new SwapRateHelper(r, swapData[i].n*swapData[i].units,
+                                       vars.calendar,
+                                       vars.fixedLegFrequency,
+                                       vars.fixedLegConvention,
+                                       vars.fixedLegDayCounter, euribor6m,
+                                       Handle<Quote>(), 0*Days,
+                                       discountCurve)));
+                helpers3m.push_back(boost::shared_ptr<RateHelper>(
+                    new SwapRateHelper(r, swapData[i].n*swapData[i].units,
+                                       vars.calendar,
+                                       vars.fixedLegFrequency,
+                                       vars.fixedLegConvention,
+                                       vars.fixedLegDayCounter, euribor3m,
+                                       basis, 0*Days, discountCurve)));
+            }
+            builder.add("6M", boost::shared_ptr<YieldTermStructure>(
+                         new Curve(vars.settlement, helpers6m, Actual360())),
+                        eonia);
+            builder.add("3M", boost::shared_ptr<YieldTermStructure>(
+                         new Curve(vars.settlement, helpers3m, Actual360())),
+                        eonia);
+
+            // two curves discounting each other's helpers
+            RelinkableHandle<YieldTermStructure> xHandle, yHandle;
+            std::vector<boost::shared_ptr<RateHelper> >& helpersX =
+                helpers["X"];
+            std::vector<boost::shared_ptr<RateHelper> >& helpersY =
+                helpers["Y"];
+            for (Size i=0; i<vars.swaps; ++i) {
+                Handle<Quote> r(vars.rates[i+vars.deposits]);
+                helpersX.push_back(boost::shared_ptr<RateHelper>(
+                    new SwapRateHelper(r, swapData[i].n*swapData[i].units,
+                                       vars.calendar,
+                                       vars.fixedLegFrequency,
+                                       vars.fixedLegConvention,
+                                       vars.fixedLegDayCounter, euribor6m,
+                                       Handle<Quote>(), 0*Days, yHandle)));
+                Handle<Quote> r2(boost::shared_ptr<Quote>(
+                         new SimpleQuote(swapData[i].rate/100 + 0.01)));
+                helpersY.push_back(boost::shared_ptr<RateHelper>(
+                    new SwapRateHelper(r2, swapData[i].n*swapData[i].units,
+                                       vars.calendar,
+                                       vars.fixedLegFrequency,
+                                       vars.fixedLegConvention,
+                                       vars.fixedLegDayCounter, euribor3m,
+                                       Handle<Quote>(), 0*Days, xHandle)));
+            }
+            boost::shared_ptr<YieldTermStructure> x(
+                         new Curve(vars.settlement, helpersX, Actual360()));
+            boost::shared_ptr<YieldTermStructure> y(
+                         new Curve(vars.settlement, helpersY, Actual360()));
+            builder.add("X", x, std::vector<std::string>(1, "Y"), xHandle);
+            builder.add("Y", y, std::vector<std::string>(1, "X"), yHandle);
+        }
+    };
+
+}
+
+void PiecewiseYieldCurveTest::testMultiCurveBuilder() {
+    BOOST_TEST_MESSAGE("Testing multi-curve builder...");
+
+    CommonVars vars;
+
+    CurveSet serial(vars, false);
+
+    std::vector<std::vector<std::vector<std::string> > > schedule =
+        serial.builder.schedule();
+    std::ostringstream order;
+    for (Size i=0; i<schedule.size(); ++i) {
+        order << "(";
+        for (Size j=0; j<schedule[i].size(); ++j) {
+            order << (j == 0 ? "[" : " [");
+            for (Size k=0; k<schedule[i][j].size(); ++k)
+                order << (k == 0 ? "" : " ") << schedule[i][j][k];
+            order << "]";
+        }
+        order << ")";
+    }
+    std::string expected = "([EONIA] [X Y])([6M] [3M])";
+    if (order.str() != expected)
+        BOOST_ERROR("wrong schedule:"
+                    << "\n    calculated: " << order.str()
+                    << "\n    expected:   " << expected);
+
+    serial.builder.build();
+    if (serial.builder.iterations() < 2)
+        BOOST_ERROR("cyclic curves were not iterated");
+
+    // all helpers must be repriced, including the ones of the curves
+    // depending on each other
+    Real tolerance = 1.0e-9;
+    for (std::map<std::string,
+                  std::vector<boost::shared_ptr<RateHelper> > >::iterator
+             i = serial.helpers.begin(); i != serial.helpers.end(); ++i) {
+        for (Size j=0; j<i->second.size(); ++j) {
+            Real error = std::fabs(i->second[j]->quoteError());
+            if (error > tolerance)
+                BOOST_ERROR("failed to reprice " << io::ordinal(j+1)
+                            << " helper of " << i->first << " curve:"
+                            << std::setprecision(12)
+                            << "\n    quote:  "
+                            << i->second[j]->quote()->value()
+                            << "\n    error:  " << error);
+        }
+    }
+
+    // the order of calculation must not matter
+    CurveSet concurrent(vars, true);
+    concurrent.builder.build();
+    std::string names[] = { "EONIA", "6M", "3M", "X", "Y" };
+    for (Size i=0; i<LENGTH(names); ++i) {
+        boost::shared_ptr<YieldTermStructure> c1 =
+            serial.builder.curve(names[i]);
+        boost::shared_ptr<YieldTermStructure> c2 =
+            concurrent.builder.curve(names[i]);
+        for (Date d = vars.settlement; d < c1->maxDate(); d += 3*Months) {
+            Real error = std::fabs(c1->discount(d) - c2->discount(d));
+            if (error > 1.0e-12)
+                BOOST_ERROR("different " << names[i] << " discount at "
+                            << d << ":" << std::setprecision(12)
+                            << "\n    serial build:     " << c1->discount(d)
+                            << "\n    concurrent build: " << c2->discount(d));
+        }
+    }
+}
+
+
+void PiecewiseYieldCurveTest::testMultiCurveBuilderObservability() {
+    BOOST_TEST_MESSAGE(
+        "Testing observability of curves built by multi-curve builder...");
+
+    CommonVars vars;
+
+    CurveSet set(vars, false);
+    set.builder.build();
+
+    std::string names[] = { "X", "Y" };
+    std::vector<Date> dates;
+    for (Date d = vars.settlement + 3*Months;
+         d < set.builder.curve("X")->maxDate(); d += 3*Months)
+        dates.push_back(d);
+    std::vector<std::vector<DiscountFactor> > discounts(LENGTH(names));
+    Flag flags[LENGTH(names)];
+    for (Size i=0; i<LENGTH(names); ++i) {
+        boost::shared_ptr<YieldTermStructure> c =
+            set.builder.curve(names[i]);
+        for (Size j=0; j<dates.size(); ++j)
+            discounts[i].push_back(c->discount(dates[j]));
+        flags[i].registerWith(c);
+    }
+
+    // a quote of the Y curve, which also discounts the helpers of X
+    boost::shared_ptr<SimpleQuote> quote =
+        boost::dynamic_pointer_cast<SimpleQuote>(
+                               set.helpers["Y"][4]->quote().currentLink());
+    Real value = quote->value();
+    quote->setValue(value + 0.001);
+
+    Real tolerance = 1.0e-9;
+    for (Size i=0; i<LENGTH(names); ++i) {
+        if (!flags[i].isUp())
+            BOOST_ERROR("observers of " << names[i] << " curve were not "
+                        "notified of quote change");
+
+        boost::shared_ptr<YieldTermStructure> c =
+            set.builder.curve(names[i]);
+        Real change = 0.0;
+        for (Size j=0; j<dates.size(); ++j)
+            change = std::max(change,
+                              std::fabs(c->discount(dates[j]) -
+                                        discounts[i][j]));
+        if (change < 1.0e-6)
+            BOOST_ERROR(names[i] << " curve unchanged after quote change:"
+                        << "\n    largest change: " << change);
+
+        // the curves must be built again together, not lazily
+        const std::vector<boost::shared_ptr<RateHelper> >& helpers =
+            set.helpers[names[i]];
+        for (Size j=0; j<helpers.size(); ++j) {
+            Real error = std::fabs(helpers[j]->quoteError());
+            if (error > tolerance)
+                BOOST_ERROR("failed to reprice " << io::ordinal(j+1)
+                            << " helper of " << names[i]
+                            << " curve after quote change:"
+                            << std::setprecision(12)
+                            << "\n    quote:  "
+                            << helpers[j]->quote()->value()
+                            << "\n    error:  " << error);
+        }
+    }
+
+    // back to the original curves
+    quote->setValue(value);
+    for (Size i=0; i<LENGTH(names); ++i) {
+        boost::shared_ptr<YieldTermStructure> c =
+            set.builder.curve(names[i]);
+        for (Size j=0; j<dates.size(); ++j) {
+            Real error = std::fabs(c->discount(dates[j]) - discounts[i][j]);
+            if (error > 1.0e-10)
+                BOOST_ERROR("different " << names[i] << " discount at "
+                            << dates[j] << " after restoring quote:"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << c->discount(dates[j])
+                            << "\n    expected:   " << discounts[i][j]);
+        }
+    }
+}
+
+
 void PiecewiseYieldCurveTest::testObservability() {
 
     BOOST_TEST_MESSAGE("Testing observability of piecewise yield curve...");
@@ -1066,6 +1397,14 @@ test_suite* PiecewiseYieldCurveTest::suite() {
              &PiecewiseYieldCurveTest::testConvexMonotoneForwardConsistency));
     suite->add(QUANTLIB_TEST_CASE(
              &PiecewiseYieldCurveTest::testLocalBootstrapConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testGlobalBootstrapConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testGlobalBootstrapJacobian));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testMultiCurveBuilder));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testMultiCurveBuilderObservability));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testObservability));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testLiborFixing));
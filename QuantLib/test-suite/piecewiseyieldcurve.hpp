@@ -41,6 +41,10 @@ class PiecewiseYieldCurveTest {
 
     static void testConvexMonotoneForwardConsistency();
     static void testLocalBootstrapConsistency();
+    static void testGlobalBootstrapConsistency();
+    static void testGlobalBootstrapJacobian();
+    static void testMultiCurveBuilder();
+    static void testMultiCurveBuilderObservability();
 
     static void testObservability();
     static void testLiborFixing();
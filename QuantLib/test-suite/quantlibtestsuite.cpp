@@ -33,7 +33,8 @@
 #  include <boost/config/auto_link.hpp>
 #  undef BOOST_LIB_NAME
 
-#ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) \
+    || defined(QL_ENABLE_SESSIONS)
 #  define BOOST_LIB_NAME boost_system
 #  include <boost/config/auto_link.hpp>
 #  undef BOOST_LIB_NAME
@@ -77,6 +78,7 @@
 #include "chooseroption.hpp"
 #include "cliquetoption.hpp"
 #include "cms.hpp"
+#include "cmsspread.hpp"
 #include "commodityunitofmeasure.hpp"
 #include "compoundoption.hpp"
 #include "convertiblebonds.hpp"
@@ -101,6 +103,7 @@
 #include "fastfouriertransform.hpp"
 #include "fdheston.hpp"
 #include "fdmlinearop.hpp"
+#include "fittedbonds.hpp"
 #include "forwardoption.hpp"
 #include "functions.hpp"
 #include "gaussianquadratures.hpp"
@@ -225,9 +228,25 @@ namespace {
 }
 
 #if defined(QL_ENABLE_SESSIONS)
+#include <boost/thread/tss.hpp>
+
+namespace {
+
+    // session of each thread; threads not setting it run in session 0
+    boost::thread_specific_ptr<QuantLib::Integer> sessionIds_;
+
+}
+
 namespace QuantLib {
 
-    Integer sessionId() { return 0; }
+    Integer sessionId() {
+        Integer* id = sessionIds_.get();
+        return id != 0 ? *id : 0;
+    }
+
+    void setSessionId(Integer id) {
+        sessionIds_.reset(new Integer(id));
+    }
 
 }
 #endif
@@ -306,6 +325,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(FastFourierTransformTest::suite());
     test->add(FdHestonTest::suite());
     test->add(FdmLinearOpTest::suite());
+    test->add(FittedBondDiscountCurveTest::suite());
     test->add(ForwardOptionTest::suite());
     test->add(FunctionsTest::suite());
     test->add(GARCHTest::suite());
@@ -380,6 +400,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(CdoTest::suite());
     test->add(CdsOptionTest::suite());
     test->add(ChooserOptionTest::suite());
+    test->add(CmsSpreadTest::suite());
     test->add(CommodityUnitOfMeasureTest::suite());
     test->add(CompoundOptionTest::suite());
     test->add(ConvertibleBondTest::suite());
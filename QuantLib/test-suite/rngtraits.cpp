@@ -22,6 +22,8 @@
 #include "utilities.hpp"
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/math/randomnumbers/boxmullergaussianrng.hpp>
+#include <ql/experimental/math/zigguratrng.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -92,11 +94,88 @@ void RngTraitsTest::testCustomPoisson() {
 }
 
 
+void RngTraitsTest::testBatchDraws() {
+
+    BOOST_TEST_MESSAGE("Testing batch random number generation...");
+
+    const Size samples = 1000, dimension = 7;
+
+    // uniform deviates; the total is not a multiple of the state size
+    MersenneTwisterUniformRng mt1(42), mt2(42);
+    std::vector<Real> buffer(samples*dimension);
+    mt1.fill(&buffer[0], buffer.size());
+    for (Size i=0; i<buffer.size(); ++i) {
+        if (buffer[i] != mt2.nextReal())
+            BOOST_FAIL("Mersenne Twister batch mismatch at draw #" << i);
+    }
+
+    // the vectorized code might round differently
+    const Real tolerance = 1.0e-12;
+
+    // inverse cumulative normal, including the tails
+    InverseCumulativeNormal icn(0.5, 2.0);
+    std::vector<Real> x(201);
+    for (Size i=0; i<x.size(); ++i)
+        x[i] = (i+0.5)/x.size();
+    x[0] = 1.0e-10;
+    x[x.size()-1] = 1.0-1.0e-10;
+    std::vector<Real> z(x);
+    icn.transform(&z[0], z.size());
+    for (Size i=0; i<x.size(); ++i) {
+        if (std::fabs(z[i] - icn(x[i])) > tolerance)
+            BOOST_FAIL("inverse cumulative normal batch mismatch at "
+                       << x[i] << "\n    expected:   " << icn(x[i])
+                       << "\n    calculated: " << z[i]);
+    }
+
+    // Gaussian sequences
+    PseudoRandom::rsg_type rsg1 =
+        PseudoRandom::make_sequence_generator(dimension, 1234);
+    PseudoRandom::rsg_type rsg2 =
+        PseudoRandom::make_sequence_generator(dimension, 1234);
+    rsg1.fill(&buffer[0], samples);
+    for (Size j=0; j<samples; ++j) {
+        const std::vector<Real>& values = rsg2.nextSequence().value;
+        for (Size k=0; k<dimension; ++k) {
+            if (std::fabs(buffer[j*dimension+k] - values[k]) > tolerance)
+                BOOST_FAIL("Gaussian sequence batch mismatch at draw #"
+                           << j << ", dimension " << k);
+        }
+    }
+
+    // Gaussian deviates
+    PseudoRandom::rng_type rng1(MersenneTwisterUniformRng(1234));
+    PseudoRandom::rng_type rng2(MersenneTwisterUniformRng(1234));
+    rng1.fill(&buffer[0], samples);
+    for (Size i=0; i<samples; ++i) {
+        if (std::fabs(buffer[i] - rng2.next().value) > tolerance)
+            BOOST_FAIL("Gaussian batch mismatch at draw #" << i);
+    }
+
+    BoxMullerGaussianRng<MersenneTwisterUniformRng>
+        boxMuller1(MersenneTwisterUniformRng(1234)),
+        boxMuller2(MersenneTwisterUniformRng(1234));
+    boxMuller1.fill(&buffer[0], samples);
+    for (Size i=0; i<samples; ++i) {
+        if (buffer[i] != boxMuller2.next().value)
+            BOOST_FAIL("Box-Muller batch mismatch at draw #" << i);
+    }
+
+    ZigguratRng ziggurat1(1234), ziggurat2(1234);
+    ziggurat1.fill(&buffer[0], samples);
+    for (Size i=0; i<samples; ++i) {
+        if (buffer[i] != ziggurat2.next().value)
+            BOOST_FAIL("Ziggurat batch mismatch at draw #" << i);
+    }
+}
+
+
 test_suite* RngTraitsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("RNG traits tests");
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testGaussian));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testDefaultPoisson));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCustomPoisson));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testBatchDraws));
     return suite;
 }
 
@@ -27,6 +27,7 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
@@ -124,6 +125,7 @@ void StatisticsTest::testStatistics() {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<StreamingStatistics>(std::string("StreamingStatistics"));
 }
 
 
@@ -247,6 +249,99 @@ void StatisticsTest::testSequenceStatistics() {
 }
 
 
+void StatisticsTest::testMergedSequenceStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing batched and merged sequence statistics...");
+
+    const Size dimension = 20, samples = 5000, threads = 4, batch = 37;
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal_gen(MersenneTwisterUniformRng(43));
+
+    // correlated samples with a large offset, so that the
+    // covariance would suffer from cancellation if calculated
+    // from raw second moments
+    Matrix data(samples, dimension);
+    std::vector<Real> weights(samples);
+    for (Size i=0; i<samples; ++i) {
+        Real common = normal_gen.next().value;
+        for (Size j=0; j<dimension; ++j)
+            data[i][j] = 1.0e4 + (j+1.0)*(common + normal_gen.next().value);
+        weights[i] = 0.5 + mt.nextReal();
+    }
+
+    // two-pass calculation
+    Real weightSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    std::vector<Real> mean(dimension, 0.0);
+    for (Size i=0; i<samples; ++i)
+        for (Size j=0; j<dimension; ++j)
+            mean[j] += weights[i]*data[i][j]/weightSum;
+    Matrix expected(dimension, dimension, 0.0);
+    for (Size i=0; i<samples; ++i)
+        for (Size j=0; j<dimension; ++j)
+            for (Size k=0; k<dimension; ++k)
+                expected[j][k] += weights[i]*(data[i][j]-mean[j])
+                                            *(data[i][k]-mean[k]);
+    expected *= samples/((samples-1.0)*weightSum);
+
+    SequenceStatisticsInc single(dimension), batched, merged;
+    std::vector<SequenceStatisticsInc> partial(threads);
+    for (Size i=0; i<samples; ++i) {
+        single.add(data.row_begin(i), data.row_end(i), weights[i]);
+        partial[i % threads].add(data.row_begin(i), data.row_end(i),
+                                 weights[i]);
+    }
+    for (Size i=0; i<samples; i+=batch) {
+        Size n = std::min(batch, samples-i);
+        Matrix rows(n, dimension);
+        std::copy(data.row_begin(i), data.row_begin(i) + n*dimension,
+                  rows.begin());
+        batched.addSamples(rows, std::vector<Real>(weights.begin()+i,
+                                                   weights.begin()+i+n));
+    }
+    for (Size i=0; i<threads; ++i)
+        merged.merge(partial[i]);
+
+    const SequenceStatisticsInc* stats[] = { &single, &batched, &merged };
+    const std::string names[] = { "single", "batched", "merged" };
+    const Real tolerance = 1.0e-10;
+    for (Size s=0; s<LENGTH(stats); ++s) {
+        if (stats[s]->samples() != samples)
+            BOOST_FAIL(names[s] << ": wrong number of samples\n"
+                       << "    calculated: " << stats[s]->samples() << "\n"
+                       << "    expected:   " << samples);
+        std::vector<Real> m = stats[s]->mean();
+        std::vector<Real> v = stats[s]->variance();
+        Matrix covariance = stats[s]->covariance();
+        for (Size j=0; j<dimension; ++j) {
+            if (std::fabs(m[j]-mean[j]) > tolerance*mean[j])
+                BOOST_ERROR(names[s] << ": wrong mean\n"
+                            << std::setprecision(12)
+                            << "    calculated: " << m[j] << "\n"
+                            << "    expected:   " << mean[j]);
+            if (std::fabs(v[j]-expected[j][j]) > tolerance*expected[j][j])
+                BOOST_ERROR(names[s] << ": wrong variance\n"
+                            << std::setprecision(12)
+                            << "    calculated: " << v[j] << "\n"
+                            << "    expected:   " << expected[j][j]);
+            for (Size k=0; k<dimension; ++k) {
+                Real scale = std::sqrt(expected[j][j]*expected[k][k]);
+                if (std::fabs(covariance[j][k]-expected[j][k])
+                                                    > tolerance*scale)
+                    BOOST_ERROR(names[s] << ": wrong covariance\n"
+                                << std::setprecision(12)
+                                << "    element:    (" << j << ","
+                                << k << ")\n"
+                                << "    calculated: " << covariance[j][k]
+                                << "\n"
+                                << "    expected:   " << expected[j][k]);
+            }
+        }
+    }
+}
+
+
 namespace {
 
     template <class S>
@@ -338,9 +433,12 @@ void StatisticsTest::testIncrementalStatistics() {
     BOOST_TEST_MESSAGE("Testing incremental statistics...");
 
     // With QuantLib 1.7 IncrementalStatistics was changed to
-    // a wrapper to the boost accumulator library. This is
-    // a test of the new implementation against results from
-    // the old one.
+    // a wrapper to the boost accumulator library, and later to
+    // compensated one-pass updates. This is a test of the current
+    // implementation against results from the previous ones; the
+    // cached mean and skewness were updated to the compensated
+    // results, which agree with an extended-precision two-pass
+    // calculation.
 
     MersenneTwisterUniformRng mt(42);
 
@@ -354,11 +452,11 @@ void StatisticsTest::testIncrementalStatistics() {
 
     TEST_INC_STAT(stat.samples(), 500000);
     TEST_INC_STAT(stat.weightSum(), 2.5003623600676749e+05);
-    TEST_INC_STAT(stat.mean(), 4.9122325964293845e-01);
+    TEST_INC_STAT(stat.mean(), 4.9122325964294600e-01);
     TEST_INC_STAT(stat.variance(),  5.0706503959683329e+05);
     TEST_INC_STAT(stat.standardDeviation(),  7.1208499464378076e+02);
     TEST_INC_STAT(stat.errorEstimate(), 1.0070402569876076e+00);
-    TEST_INC_STAT(stat.skewness(), -1.7360169326720038e-03);
+    TEST_INC_STAT(stat.skewness(), -1.7360169326720409e-03);
     TEST_INC_STAT(stat.kurtosis(), -1.1990742562085395e+00);
     TEST_INC_STAT(stat.min(), -1.2339945045639761e+03);
     TEST_INC_STAT(stat.max(),  1.2339958308008499e+03);
@@ -386,11 +484,167 @@ void StatisticsTest::testIncrementalStatistics() {
                                  << tol);
 }
 
+void StatisticsTest::testStreamingStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing streaming statistics...");
+
+    // by default, 1000 samples are kept in each tail
+    const Size samples = 100000, threads = 4;
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal_gen(MersenneTwisterUniformRng(43));
+
+    Statistics reference;
+    StreamingRiskStatistics single;
+    std::vector<StreamingStatistics> partial(threads);
+    for (Size i=0; i<samples; ++i) {
+        Real x = normal_gen.next().value, w = 0.5 + mt.nextReal();
+        reference.add(x, w);
+        single.add(x, w);
+        partial[i % threads].add(x, w);
+    }
+    StreamingRiskStatistics merged;
+    for (Size i=0; i<threads; ++i)
+        merged.merge(partial[i]);
+
+    const StreamingRiskStatistics* stats[] = { &single, &merged };
+    const std::string names[] = { "single", "merged" };
+    for (Size k=0; k<LENGTH(stats); ++k) {
+        const StreamingRiskStatistics& s = *stats[k];
+        if (s.samples() != samples)
+            BOOST_FAIL(names[k] << ": wrong number of samples");
+
+        Real tolerance = 1.0e-10;
+        Real calculated[] = { s.weightSum(), s.mean(), s.variance(),
+                              s.skewness(), s.kurtosis(), s.min(), s.max() };
+        Real expected[] = { reference.weightSum(), reference.mean(),
+                            reference.variance(), reference.skewness(),
+                            reference.kurtosis(), reference.min(),
+                            reference.max() };
+        for (Size i=0; i<LENGTH(calculated); ++i) {
+            if (std::fabs(calculated[i]-expected[i]) >
+                                   tolerance*(1.0 + std::fabs(expected[i])))
+                BOOST_FAIL(names[k] << ": wrong moment #" << i
+                           << "\n    calculated: " << calculated[i]
+                           << "\n    expected:   " << expected[i]);
+        }
+
+        // the exact tails cover about 1% of the samples on each side
+        Real percentiles[] = { 0.001, 0.005, 0.009 };
+        for (Size i=0; i<LENGTH(percentiles); ++i) {
+            Real p = percentiles[i];
+            if (s.percentile(p) != reference.percentile(p) ||
+                s.topPercentile(p) != reference.topPercentile(p))
+                BOOST_FAIL(names[k] << ": wrong tail percentile at " << p);
+            if (s.valueAtRisk(1.0-p) != reference.valueAtRisk(1.0-p))
+                BOOST_FAIL(names[k] << ": wrong value-at-risk at "
+                           << 1.0-p);
+            Real es = s.expectedShortfall(1.0-p);
+            Real esRef = reference.expectedShortfall(1.0-p);
+            if (std::fabs(es-esRef) > tolerance)
+                BOOST_FAIL(names[k] << ": wrong expected shortfall at "
+                           << 1.0-p
+                           << "\n    calculated: " << es
+                           << "\n    expected:   " << esRef);
+        }
+
+        // the digest estimates the inner percentiles; the error is
+        // measured on the rank of the estimate
+        Real inner[] = { 0.05, 0.25, 0.5, 0.75, 0.95 };
+        for (Size i=0; i<LENGTH(inner); ++i) {
+            Real x = s.percentile(inner[i]);
+            Real rank = reference.expectationValue(
+                                     clip(constant<Real,Real>(1.0),
+                                          std::bind2nd(std::less<Real>(), x)),
+                                     everywhere()).first;
+            if (std::fabs(rank - inner[i]) > 1.0e-3)
+                BOOST_FAIL(names[k] << ": wrong percentile at "
+                           << inner[i] << "\n    rank of estimate: "
+                           << rank);
+        }
+    }
+
+    // no more than twice the tail size: everything is exact
+    StreamingStatistics small(200.0, 10);
+    Statistics smallReference;
+    for (Size i=0; i<20; ++i) {
+        Real x = normal_gen.next().value;
+        small.add(x);
+        smallReference.add(x);
+    }
+    smallReference.sort();
+    if (small.data() != smallReference.data())
+        BOOST_FAIL("exact data set not preserved");
+}
+
+void StatisticsTest::testMergedStreamingStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing merged streaming statistics "
+                       "with small partial sets...");
+
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal_gen(MersenneTwisterUniformRng(44));
+
+    const Size tailSize = 10;
+    // partial sets smaller than the tails, whose lower and upper tails
+    // hold the same samples: first still exact once merged, then not
+    const Size partials[] = { 2, 3 }, partialSamples[] = { 5, 15 };
+
+    for (Size k=0; k<LENGTH(partials); ++k) {
+        StreamingStatistics serial(200.0, tailSize),
+                            merged(200.0, tailSize);
+        std::vector<StreamingStatistics> partial(
+                          partials[k], StreamingStatistics(200.0, tailSize));
+        for (Size i=0; i<partials[k]; ++i) {
+            for (Size j=0; j<partialSamples[k]; ++j) {
+                Real x = normal_gen.next().value;
+                serial.add(x);
+                partial[i].add(x);
+            }
+            merged.merge(partial[i]);
+        }
+
+        if (merged.samples() != serial.samples())
+            BOOST_FAIL("wrong number of samples after merging "
+                       << partials[k] << " sets of " << partialSamples[k]
+                       << "\n    calculated: " << merged.samples()
+                       << "\n    expected:   " << serial.samples());
+
+        if (merged.data() != serial.data())
+            BOOST_FAIL("data not preserved when merging "
+                       << partials[k] << " sets of " << partialSamples[k]);
+
+        Real tolerance = 1.0e-12;
+        Real calculated[] = { merged.weightSum(), merged.mean(),
+                              merged.variance(), merged.min(),
+                              merged.max(), merged.percentile(0.2),
+                              merged.topPercentile(0.2) };
+        Real expected[] = { serial.weightSum(), serial.mean(),
+                            serial.variance(), serial.min(),
+                            serial.max(), serial.percentile(0.2),
+                            serial.topPercentile(0.2) };
+        for (Size i=0; i<LENGTH(calculated); ++i) {
+            if (std::fabs(calculated[i]-expected[i]) > tolerance)
+                BOOST_FAIL("wrong statistic #" << i << " after merging "
+                           << partials[k] << " sets of "
+                           << partialSamples[k]
+                           << "\n    calculated: " << calculated[i]
+                           << "\n    expected:   " << expected[i]);
+        }
+    }
+}
+
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &StatisticsTest::testMergedSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testIncrementalStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStreamingStatistics));
+    suite->add(QUANTLIB_TEST_CASE(
+                          &StatisticsTest::testMergedStreamingStatistics));
     return suite;
 }
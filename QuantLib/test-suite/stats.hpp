@@ -31,8 +31,11 @@ class StatisticsTest {
   public:
     static void testStatistics();
     static void testSequenceStatistics();
+    static void testMergedSequenceStatistics();
     static void testConvergenceStatistics();
     static void testIncrementalStatistics();
+    static void testStreamingStatistics();
+    static void testMergedStreamingStatistics();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -25,6 +25,9 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/termstructures/yield/forwardcurve.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
@@ -334,6 +337,147 @@ void TermStructureTest::testLinkToNullUnderlying() {
     underlying.linkTo(boost::shared_ptr<YieldTermStructure>());
 }
 
+void TermStructureTest::testBatchEvaluation() {
+    BOOST_TEST_MESSAGE(
+        "Testing batch evaluation of term structures...");
+
+    CommonVars vars;
+
+    Date today = vars.termStructure->referenceDate();
+    DayCounter dc = Actual360();
+
+    std::vector<Date> dates;
+    std::vector<Rate> rates;
+    Integer years[] = { 0, 1, 2, 5, 10, 20 };
+    Rate values[] = { 0.030, 0.032, 0.035, 0.041, 0.044, 0.045 };
+    for (Size i=0; i<LENGTH(years); ++i) {
+        dates.push_back(today + years[i]*Years);
+        rates.push_back(values[i]);
+    }
+    std::vector<DiscountFactor> discounts(rates.size());
+    for (Size i=0; i<rates.size(); ++i)
+        discounts[i] = std::exp(-rates[i]*dc.yearFraction(today,dates[i]));
+
+    std::vector<Handle<Quote> > jumps(1,
+        Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.999))));
+    std::vector<Date> jumpDates(1, today + 18*Months);
+
+    std::vector<std::pair<std::string,
+                          boost::shared_ptr<YieldTermStructure> > > curves;
+    curves.push_back(std::make_pair(std::string("piecewise"),
+                                    vars.termStructure));
+    curves.push_back(std::make_pair(std::string("discount"),
+        boost::shared_ptr<YieldTermStructure>(
+                           new DiscountCurve(dates, discounts, dc))));
+    curves.push_back(std::make_pair(std::string("zero"),
+        boost::shared_ptr<YieldTermStructure>(
+                           new ZeroCurve(dates, rates, dc, NullCalendar(),
+                                         jumps, jumpDates))));
+    curves.push_back(std::make_pair(std::string("forward"),
+        boost::shared_ptr<YieldTermStructure>(
+                           new ForwardCurve(dates, rates, dc))));
+    curves.push_back(std::make_pair(std::string("flat"),
+        boost::shared_ptr<YieldTermStructure>(
+                           new FlatForward(today, 0.04, dc))));
+    curves.push_back(std::make_pair(std::string("zero-spreaded"),
+        boost::shared_ptr<YieldTermStructure>(
+            new ZeroSpreadedTermStructure(
+                Handle<YieldTermStructure>(vars.termStructure),
+                Handle<Quote>(boost::shared_ptr<Quote>(
+                                                new SimpleQuote(0.01)))))));
+
+    // null, unsorted and extrapolated times are included
+    Time testTimes[] = { 0.0, 0.1, 0.5, 1.0, 1.5, 2.7, 0.3, 4.0,
+                         9.9, 15.0, 20.0, 25.0, 40.0 };
+    std::vector<Time> times(testTimes, testTimes+LENGTH(testTimes));
+    std::vector<Time> endTimes(times.size());
+    for (Size i=0; i<times.size(); ++i)
+        endTimes[i] = (i % 3 == 0) ? times[i] : times[i] + 0.25;
+
+    Real tolerance = 1.0e-12;
+    std::vector<Real> batch(times.size());
+
+    for (Size k=0; k<curves.size(); ++k) {
+        const std::string& name = curves[k].first;
+        const boost::shared_ptr<YieldTermStructure>& curve = curves[k].second;
+
+        curve->discount(times, &batch[0], true);
+        for (Size i=0; i<times.size(); ++i) {
+            DiscountFactor expected = curve->discount(times[i], true);
+            if (std::fabs(batch[i] - expected) > tolerance)
+                BOOST_ERROR("batch discount mismatch for " << name << " curve"
+                            << "\n    time:       " << times[i]
+                            << std::setprecision(12)
+                            << "\n    calculated: " << batch[i]
+                            << "\n    expected:   " << expected);
+        }
+
+        curve->zeroRate(times, &batch[0], Compounded, Semiannual, true);
+        for (Size i=0; i<times.size(); ++i) {
+            Rate expected =
+                curve->zeroRate(times[i], Compounded, Semiannual, true);
+            if (std::fabs(batch[i] - expected) > tolerance)
+                BOOST_ERROR("batch zero rate mismatch for " << name << " curve"
+                            << "\n    time:       " << times[i]
+                            << "\n    calculated: " << io::rate(batch[i])
+                            << "\n    expected:   " << io::rate(expected));
+        }
+
+        curve->forwardRate(times, endTimes, &batch[0],
+                           Continuous, NoFrequency, true);
+        for (Size i=0; i<times.size(); ++i) {
+            Rate expected = curve->forwardRate(times[i], endTimes[i],
+                                               Continuous, NoFrequency, true);
+            if (std::fabs(batch[i] - expected) > tolerance)
+                BOOST_ERROR("batch forward rate mismatch for " << name
+                            << " curve"
+                            << "\n    times:      " << times[i]
+                            << ", " << endTimes[i]
+                            << "\n    calculated: " << io::rate(batch[i])
+                            << "\n    expected:   " << io::rate(expected));
+        }
+    }
+
+    // range checks are still performed
+    try {
+        curves[1].second->discount(times, &batch[0]);
+        BOOST_ERROR("times past the end of the curve were not detected");
+    } catch (Error&) {}
+
+    // variances on a Black surface
+    std::vector<Date> volDates;
+    volDates.push_back(today + 6*Months);
+    volDates.push_back(today + 1*Years);
+    volDates.push_back(today + 3*Years);
+    std::vector<Real> strikes;
+    strikes.push_back(90.0);
+    strikes.push_back(100.0);
+    strikes.push_back(110.0);
+    Matrix vols(3, 3);
+    for (Size i=0; i<3; ++i)
+        for (Size j=0; j<3; ++j)
+            vols[i][j] = 0.20 + 0.01*i - 0.005*j;
+    BlackVarianceSurface surface(today, NullCalendar(), volDates,
+                                 strikes, vols, dc,
+                                 BlackVarianceSurface::ConstantExtrapolation,
+                                 BlackVarianceSurface::ConstantExtrapolation);
+    Real testStrikes[] = { 80.0, 95.0, 110.0, 120.0 };
+    for (Size k=0; k<LENGTH(testStrikes); ++k) {
+        surface.blackVariance(times, testStrikes[k], &batch[0], true);
+        for (Size i=0; i<times.size(); ++i) {
+            Real expected =
+                surface.blackVariance(times[i], testStrikes[k], true);
+            if (std::fabs(batch[i] - expected) > tolerance)
+                BOOST_ERROR("batch Black variance mismatch"
+                            << "\n    time:       " << times[i]
+                            << "\n    strike:     " << testStrikes[k]
+                            << std::setprecision(12)
+                            << "\n    calculated: " << batch[i]
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
 test_suite* TermStructureTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -347,6 +491,7 @@ test_suite* TermStructureTest::suite() {
                          &TermStructureTest::testCreateWithNullUnderlying));
     suite->add(QUANTLIB_TEST_CASE(
                              &TermStructureTest::testLinkToNullUnderlying));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testBatchEvaluation));
     return suite;
 }
 
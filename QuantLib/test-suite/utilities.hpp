@@ -202,6 +202,11 @@ namespace QuantLib {
         return out;
     }
 
+    #if defined(QL_ENABLE_SESSIONS)
+    // sets the id returned by sessionId() in the calling thread;
+    // defined together with sessionId() by the test-suite driver
+    void setSessionId(Integer id);
+    #endif
 
 }
 